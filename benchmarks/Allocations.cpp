@@ -0,0 +1,153 @@
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include "Allocations.hpp"
+
+static std::atomic<std::size_t> allocationsCount{0};
+
+/**
+ * @brief Function for allocating counted memory.
+ * Aligned memory is allocated by aligned_alloc,
+ * so all overloads are released by free.
+ * @return Memory or nullptr, if allocation failed.
+ */
+static void* allocate(std::size_t size, std::size_t alignment = 0) noexcept
+{
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        return std::malloc(size);
+    }
+
+    // Size of aligned_alloc must be multiple of alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* operator new(std::size_t size)
+{
+    if (auto* memory = allocate(size))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* memory = allocate(size, static_cast<std::size_t>(alignment)))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+std::size_t Allocations::Count()
+{
+    return allocationsCount.load(std::memory_order_relaxed);
+}
+
+void Allocations::Report(benchmark::State& state, std::size_t before)
+{
+    state.counters["allocations"] = benchmark::Counter(
+        static_cast<double>(Count() - before),
+        benchmark::Counter::kAvgIterations
+    );
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <benchmark/benchmark.h>
+
+/**
+ * @brief Counter of global `operator new` calls.
+ * It's used for reporting allocations per
+ * benchmark iteration.
+ */
+namespace Allocations
+{
+    /**
+     * @brief Function for getting number of
+     * allocations since program start.
+     * @return Number of allocations.
+     */
+    std::size_t Count();
+
+    /**
+     * @brief Function for adding "allocations"
+     * counter, averaged by iterations.
+     * @param state Benchmark state.
+     * @param before Number of allocations
+     * before benchmark loop.
+     */
+    void Report(benchmark::State& state, std::size_t before);
+}
@@ -0,0 +1,57 @@
+#include <string>
+#include <string_view>
+#include <benchmark/benchmark.h>
+#include <HTTPArena.hpp>
+#include <HTTPHeader.hpp>
+#include "Corpus.hpp"
+#include "Allocations.hpp"
+
+static void HeaderParse(benchmark::State& state, std::string_view corpus)
+{
+    // Request line is skipped
+    std::string buffer(corpus.substr(corpus.find("\r\n") + 2));
+    auto* bytes = reinterpret_cast<std::byte*>(buffer.data());
+
+    HTTPArena arena;
+
+    auto allocations = Allocations::Count();
+
+    for (auto _ : state)
+    {
+        {
+            HTTPHeader header(&arena);
+
+            benchmark::DoNotOptimize(header.parse(bytes, buffer.size()));
+        }
+
+        arena.reset();
+    }
+
+    Allocations::Report(state, allocations);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+
+BENCHMARK_CAPTURE(HeaderParse, curl, Corpus::Curl);
+BENCHMARK_CAPTURE(HeaderParse, browser, Corpus::Browser);
+BENCHMARK_CAPTURE(HeaderParse, api_client, Corpus::APIClient);
+
+static void HeaderFind(benchmark::State& state)
+{
+    std::string buffer(Corpus::Browser.substr(Corpus::Browser.find("\r\n") + 2));
+
+    HTTPHeader header;
+    header.parse(reinterpret_cast<std::byte*>(buffer.data()), buffer.size());
+
+    auto allocations = Allocations::Count();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(header.find("connection"));
+        benchmark::DoNotOptimize(header.find(HTTPHeader::Token::Cookie));
+    }
+
+    Allocations::Report(state, allocations);
+}
+
+BENCHMARK(HeaderFind);
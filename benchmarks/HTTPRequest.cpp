@@ -0,0 +1,108 @@
+#include <map>
+#include <string>
+#include <string_view>
+#include <benchmark/benchmark.h>
+#include <HTTPArena.hpp>
+#include <HTTPRequest.hpp>
+#include "Corpus.hpp"
+#include "Allocations.hpp"
+
+/**
+ * @brief Methods in proportion of usual traffic
+ * with some unknown and extension ones.
+ */
+static const std::string_view Methods[] = {
+    "GET", "GET", "GET", "GET", "POST", "GET", "HEAD", "GET",
+    "PUT", "GET", "OPTIONS", "DELETE", "GET", "PATCH", "PROPFIND", "get"
+};
+
+/**
+ * @brief Lookup, that was used before constexpr
+ * matcher. Kept for comparison.
+ */
+static HTTPRequest::Method mapStringToMethod(std::string_view s)
+{
+    static const std::map<std::string_view, HTTPRequest::Method> methods = {
+        {"OPTIONS", HTTPRequest::Method::OPTIONS},
+        {"GET",     HTTPRequest::Method::GET},
+        {"HEAD",    HTTPRequest::Method::HEAD},
+        {"POST",    HTTPRequest::Method::POST},
+        {"PUT",     HTTPRequest::Method::PUT},
+        {"PATCH",   HTTPRequest::Method::PATCH},
+        {"DELETE",  HTTPRequest::Method::DELETE},
+        {"TRACE",   HTTPRequest::Method::TRACE},
+        {"CONNECT", HTTPRequest::Method::CONNECT}
+    };
+
+    auto result = methods.find(s);
+
+    return result == methods.end() ? HTTPRequest::Method::None : result->second;
+}
+
+static void StringToMethod(benchmark::State& state)
+{
+    std::size_t index = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(HTTPRequest::stringToMethod(Methods[index++ % std::size(Methods)]));
+    }
+}
+
+BENCHMARK(StringToMethod);
+
+static void StringToMethodMap(benchmark::State& state)
+{
+    std::size_t index = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(mapStringToMethod(Methods[index++ % std::size(Methods)]));
+    }
+}
+
+BENCHMARK(StringToMethodMap);
+
+static void MethodToString(benchmark::State& state)
+{
+    std::size_t index = 0;
+
+    for (auto _ : state)
+    {
+        auto method = static_cast<HTTPRequest::Method>(index++ % 10);
+
+        benchmark::DoNotOptimize(HTTPRequest::methodToString(method));
+    }
+}
+
+BENCHMARK(MethodToString);
+
+static void RequestParse(benchmark::State& state, std::string_view corpus)
+{
+    std::string buffer(corpus);
+    auto* bytes = reinterpret_cast<std::byte*>(buffer.data());
+
+    // Request is placed into arena, like in connection
+    HTTPArena arena;
+
+    auto allocations = Allocations::Count();
+
+    for (auto _ : state)
+    {
+        {
+            HTTPRequest request(&arena);
+
+            benchmark::DoNotOptimize(request.parse(bytes, buffer.size()));
+        }
+
+        arena.reset();
+    }
+
+    Allocations::Report(state, allocations);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+
+BENCHMARK_CAPTURE(RequestParse, curl, Corpus::Curl);
+BENCHMARK_CAPTURE(RequestParse, browser, Corpus::Browser);
+BENCHMARK_CAPTURE(RequestParse, api_client, Corpus::APIClient);
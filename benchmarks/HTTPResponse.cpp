@@ -0,0 +1,88 @@
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <HTTPArena.hpp>
+#include <HTTPResponse.hpp>
+#include <ResponseWriter.hpp>
+#include "Allocations.hpp"
+
+/**
+ * @brief Function for forming usual API response.
+ * @param resource Memory resource.
+ * @param body Response body.
+ * @return Response.
+ */
+static HTTPResponse makeResponse(std::pmr::memory_resource* resource, const std::string& body)
+{
+    HTTPResponse response(resource);
+
+    response.version() = "HTTP/1.1";
+    response.statusCode() = HTTPResponse::StatusCode::Ok;
+
+    response.header().addHeader({"Content-Type", "application/json"});
+    response.header().addHeader({"Cache-Control", "no-cache, no-store, must-revalidate"});
+    response.header().addHeader({"Date", "Sun, 18 Oct 2026 12:00:00 GMT"});
+    response.header().addHeader({"Server", "SimpleHTTPServer"});
+    response.header().addHeader({"X-Request-Id", "3f1c9a52-8b7e-4d2a-9c61-0e5f4b7a2d18"});
+    response.header().addHeader({"Content-Length", std::to_string(body.size())});
+
+    response.setData(reinterpret_cast<std::byte*>(const_cast<char*>(body.data())), body.size());
+
+    return response;
+}
+
+static void ResponseSerialize(benchmark::State& state)
+{
+    std::string body(static_cast<std::size_t>(state.range(0)), 'x');
+
+    HTTPArena arena;
+
+    auto response = makeResponse(&arena, body);
+
+    std::vector<std::byte> buffer(response.calculateSerializedSize());
+
+    auto allocations = Allocations::Count();
+
+    for (auto _ : state)
+    {
+        response.serialize(buffer.data());
+
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    Allocations::Report(state, allocations);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+
+BENCHMARK(ResponseSerialize)->Arg(0)->Arg(1024)->Arg(64 * 1024);
+
+static void ResponseWriteHead(benchmark::State& state)
+{
+    std::string body(1024, 'x');
+
+    HTTPArena arena;
+
+    auto response = makeResponse(&arena, body);
+
+    // Buffer keeps capacity, like in connection
+    std::vector<std::byte> buffer;
+
+    auto allocations = Allocations::Count();
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+
+        ResponseWriter writer(buffer);
+        writer.writeHead(response);
+
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    Allocations::Report(state, allocations);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+
+BENCHMARK(ResponseWriteHead);
@@ -0,0 +1,91 @@
+#include <string>
+#include <string_view>
+#include <benchmark/benchmark.h>
+#include <HTTPRouter.hpp>
+#include "Allocations.hpp"
+
+using Method = HTTPRequest::Method;
+
+/**
+ * @brief Routes of usual REST API.
+ */
+static const std::pair<Method, std::string_view> Routes[] = {
+    {Method::GET,    "/api/version"},
+    {Method::GET,    "/api/status"},
+    {Method::GET,    "/api/users"},
+    {Method::POST,   "/api/users"},
+    {Method::GET,    "/api/users/me"},
+    {Method::GET,    "/api/users/:id"},
+    {Method::PUT,    "/api/users/:id"},
+    {Method::DELETE, "/api/users/:id"},
+    {Method::GET,    "/api/users/:id/orders"},
+    {Method::GET,    "/api/users/:id/orders/:order"},
+    {Method::GET,    "/api/orders"},
+    {Method::POST,   "/api/orders"},
+    {Method::GET,    "/api/orders/:order"},
+    {Method::GET,    "/api/orders/:order/items"},
+    {Method::POST,   "/api/orders/:order/items"},
+    {Method::GET,    "/api/orders/:order/items/:item"},
+    {Method::GET,    "/api/products"},
+    {Method::GET,    "/api/products/:product"},
+    {Method::GET,    "/api/products/:product/reviews"},
+    {Method::GET,    "/api/search"},
+    {Method::GET,    "/static/*path"},
+    {Method::GET,    "/health"},
+    {Method::GET,    "/metrics"}
+};
+
+/**
+ * @brief Lookups with static, parameter,
+ * wildcard and missing routes.
+ */
+static const std::pair<Method, std::string_view> Lookups[] = {
+    {Method::GET,    "/api/version"},
+    {Method::GET,    "/api/users/42"},
+    {Method::GET,    "/api/users/me"},
+    {Method::PUT,    "/api/users/42"},
+    {Method::GET,    "/api/users/42/orders/1001"},
+    {Method::POST,   "/api/orders/1001/items"},
+    {Method::GET,    "/api/orders/1001/items/7"},
+    {Method::GET,    "/static/js/main.3f1c9a52.js"},
+    {Method::GET,    "/api/unknown"},
+    {Method::PATCH,  "/api/users/42"},
+    {Method::GET,    "/health"},
+    {Method::GET,    "/api/products/15/reviews"}
+};
+
+static void RouteLookup(benchmark::State& state)
+{
+    HTTPRouter<int> router;
+
+    int value = 0;
+
+    for (auto&& [method, pattern] : Routes)
+    {
+        router.add(method, pattern, value++);
+    }
+
+    std::size_t size = 0;
+
+    for (auto&& lookup : Lookups)
+    {
+        size += lookup.second.size();
+    }
+
+    auto allocations = Allocations::Count();
+
+    for (auto _ : state)
+    {
+        for (auto&& [method, path] : Lookups)
+        {
+            benchmark::DoNotOptimize(router.find(method, path));
+        }
+    }
+
+    Allocations::Report(state, allocations);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(Lookups)));
+}
+
+BENCHMARK(RouteLookup);
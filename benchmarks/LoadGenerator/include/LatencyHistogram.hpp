@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Log-linear histogram of latencies in
+ * nanoseconds. Every power of two range is split
+ * into 512 buckets, so value is kept with 0.2%
+ * precision. Recording does not allocate memory.
+ */
+class LatencyHistogram
+{
+public:
+
+    /**
+     * @brief Constructor.
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Method for recording value.
+     * @param value Latency in nanoseconds.
+     */
+    void record(uint64_t value);
+
+    /**
+     * @brief Method for recording value with
+     * correction of coordinated omission. If value
+     * is larger than expected interval, values for
+     * requests, that would be sent during it, are
+     * recorded too.
+     * @param value Latency in nanoseconds.
+     * @param expectedInterval Expected interval
+     * between requests in nanoseconds. 0 disables
+     * correction.
+     */
+    void recordCorrected(uint64_t value, uint64_t expectedInterval);
+
+    /**
+     * @brief Method for adding values of
+     * other histogram.
+     * @param other Histogram.
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Method for getting number of values.
+     * @return Number of values.
+     */
+    uint64_t count() const;
+
+    /**
+     * @brief Method for getting value at percentile.
+     * @param percentile Percentile in [0, 100].
+     * @return Highest value of bucket, that holds
+     * percentile.
+     */
+    uint64_t percentile(double percentile) const;
+
+    /**
+     * @brief Method for getting maximum value.
+     * @return Maximum value.
+     */
+    uint64_t max() const;
+
+private:
+
+    static std::size_t index(uint64_t value);
+
+    static uint64_t highestValue(std::size_t index);
+
+    std::vector<uint64_t> m_counts;
+    uint64_t m_count;
+    uint64_t m_max;
+};
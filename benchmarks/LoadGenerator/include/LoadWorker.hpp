@@ -0,0 +1,303 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <HTTPChunkedDecoder.hpp>
+#include "LatencyHistogram.hpp"
+
+/**
+ * @brief Options of load run.
+ */
+struct LoadOptions
+{
+    /**
+     * @brief Load modes.
+     */
+    enum class Mode
+    {
+          Closed ///< Next request is sent after response.
+        , Open   ///< Requests are sent with fixed rate.
+    };
+
+    Mode mode = Mode::Closed;
+
+    /**
+     * @brief Total rate of open mode in
+     * requests per second.
+     */
+    double rate = 1000;
+
+    std::size_t connections = 16;
+    std::size_t threads = 1;
+
+    /**
+     * @brief Number of requests, that are sent
+     * without waiting for responses.
+     */
+    std::size_t pipeline = 1;
+
+    /**
+     * @brief Keep connection between requests,
+     * or open new one for every request.
+     */
+    bool keepAlive = true;
+
+    std::size_t bodySize = 0;
+    std::string path = "/";
+
+    uint16_t port = 18080;
+
+    std::chrono::nanoseconds warmup = std::chrono::seconds(1);
+    std::chrono::nanoseconds duration = std::chrono::seconds(5);
+
+    /**
+     * @brief Expected interval between requests
+     * of closed mode for correction of coordinated
+     * omission. 0 disables correction.
+     */
+    std::chrono::nanoseconds expectedInterval = std::chrono::nanoseconds(0);
+};
+
+/**
+ * @brief Load generator thread. It drives own
+ * set of connections with edge-triggered epoll
+ * and measures latency of every response.
+ *
+ * In open mode latency is measured from time,
+ * when request had to be sent by schedule, not
+ * when it was actually sent. So server stalls
+ * are not hidden by client, waiting for them
+ * (coordinated omission).
+ */
+class LoadWorker
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param options Run options.
+     * @param connections Number of connections
+     * of this worker.
+     * @param rate Rate of this worker in open mode.
+     */
+    LoadWorker(const LoadOptions& options, std::size_t connections, double rate);
+
+    /**
+     * @brief Destructor. Closes connections.
+     */
+    ~LoadWorker();
+
+    LoadWorker(const LoadWorker&) = delete;
+    LoadWorker& operator=(const LoadWorker&) = delete;
+
+    /**
+     * @brief Method for executing run. It's
+     * finished after warmup, duration and
+     * waiting for responses.
+     */
+    void run();
+
+    /**
+     * @brief Method for getting latency histogram
+     * of responses after warmup.
+     * @return Histogram.
+     */
+    const LatencyHistogram& histogram() const;
+
+    /**
+     * @brief Method for getting number of
+     * received responses after warmup. Unlike
+     * histogram count, it doesn't include values
+     * of coordinated omission correction.
+     * @return Number of responses.
+     */
+    uint64_t responses() const;
+
+    /**
+     * @brief Method for getting number of
+     * failed requests after warmup.
+     * @return Number of errors.
+     */
+    uint64_t errors() const;
+
+    /**
+     * @brief Method for getting number of
+     * received bytes after warmup.
+     * @return Number of bytes.
+     */
+    uint64_t bytesReceived() const;
+
+private:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Response parsing state.
+     */
+    enum class ResponseState
+    {
+          Header
+        , Body
+        , Chunked
+        , Closing ///< Waiting for server to close connection.
+    };
+
+    /**
+     * @brief Result of response parsing.
+     */
+    enum class ParseResult
+    {
+          Incomplete
+        , Complete
+        , Malformed
+    };
+
+    /**
+     * @brief Client connection.
+     */
+    struct Connection
+    {
+        int socket = -1;
+
+        std::string output;
+        std::size_t outputSent = 0;
+
+        std::vector<char> input;
+        std::size_t inputBegin = 0;
+        std::size_t inputEnd = 0;
+
+        /**
+         * @brief Start times of requests, that
+         * wait for response.
+         */
+        std::deque<uint64_t> inFlight;
+
+        ResponseState state = ResponseState::Header;
+        std::size_t bodyRemaining = 0;
+        bool closeAfterResponse = false;
+        bool statusFailed = false;
+        HTTPChunkedDecoder decoder;
+    };
+
+    /**
+     * @brief Function for getting monotonic time.
+     * @return Time in nanoseconds.
+     */
+    static uint64_t now();
+
+    /**
+     * @brief Method for opening connection.
+     * @param connection Connection.
+     * @return False on socket error.
+     */
+    bool connect(Connection& connection);
+
+    /**
+     * @brief Method for closing connection.
+     * @param connection Connection.
+     * @param failed If it's true, requests without
+     * responses are failed, otherwise they are sent
+     * again with other connection.
+     */
+    void disconnect(Connection& connection, bool failed);
+
+    /**
+     * @brief Method for checking, can request be
+     * sent with connection now.
+     * @param connection Connection.
+     * @return Can request be sent.
+     */
+    bool canSend(const Connection& connection) const;
+
+    /**
+     * @brief Method for sending request.
+     * @param connection Connection. It's opened,
+     * if it's closed.
+     * @param start Start time of request latency.
+     */
+    void send(Connection& connection, uint64_t start);
+
+    /**
+     * @brief Method for sending requests of backlog
+     * and, in closed mode, filling pipelines.
+     */
+    void dispatch();
+
+    /**
+     * @brief Method for sending pending output,
+     * until socket would block.
+     * @param connection Connection.
+     * @return False on send error.
+     */
+    bool flush(Connection& connection);
+
+    /**
+     * @brief Method for receiving and parsing
+     * responses, until socket would block.
+     * @param connection Connection.
+     */
+    void receive(Connection& connection);
+
+    /**
+     * @brief Method for parsing one response
+     * from input buffer.
+     * @param connection Connection.
+     * @return Parse result.
+     */
+    ParseResult parseResponse(Connection& connection);
+
+    /**
+     * @brief Method for recording completed response.
+     * @param connection Connection.
+     */
+    void finishResponse(Connection& connection);
+
+    /**
+     * @brief Method for checking, is request
+     * started in measured interval.
+     * @param start Start time of request.
+     * @return Is request measured.
+     */
+    bool isMeasured(uint64_t start) const;
+
+    /**
+     * @brief Method for recording latency of
+     * measured request.
+     * @param start Start time.
+     * @param end End time.
+     */
+    void recordLatency(uint64_t start, uint64_t end);
+
+    /**
+     * @brief Method for arming wake up timer.
+     * @param time Absolute monotonic time.
+     */
+    void armTimer(uint64_t time);
+
+    LoadOptions m_options;
+    uint64_t m_interval;
+
+    std::string m_request;
+
+    int m_epoll;
+    int m_timer;
+
+    std::vector<Connection> m_connections;
+    std::size_t m_nextConnection;
+
+    std::deque<uint64_t> m_backlog;
+    uint64_t m_nextIntended;
+
+    uint64_t m_warmupEnd;
+    uint64_t m_end;
+    bool m_stopping;
+
+    LatencyHistogram m_histogram;
+    uint64_t m_responses;
+    uint64_t m_errors;
+    uint64_t m_bytesReceived;
+};
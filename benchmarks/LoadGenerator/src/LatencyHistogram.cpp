@@ -0,0 +1,129 @@
+#include <bit>
+#include <cmath>
+#include <algorithm>
+#include "LatencyHistogram.hpp"
+
+/**
+ * @brief Values below this are stored exactly.
+ */
+static constexpr uint64_t LinearCount = 1024;
+
+/**
+ * @brief Number of buckets in every
+ * following power of two.
+ */
+static constexpr uint64_t SubBucketCount = LinearCount / 2;
+
+/**
+ * @brief Number of power of two ranges
+ * above linear ones.
+ */
+static constexpr uint64_t RangesCount = 64 - 10;
+
+LatencyHistogram::LatencyHistogram() :
+    m_counts(LinearCount + RangesCount * SubBucketCount, 0),
+    m_count(0),
+    m_max(0)
+{
+
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    ++m_counts[index(value)];
+    ++m_count;
+    m_max = std::max(m_max, value);
+}
+
+void LatencyHistogram::recordCorrected(uint64_t value, uint64_t expectedInterval)
+{
+    record(value);
+
+    if (expectedInterval == 0)
+    {
+        return;
+    }
+
+    // Requests, that were not sent, while this one
+    // was waited, would see decreasing latencies
+    for (auto missing = value; missing > expectedInterval; )
+    {
+        missing -= expectedInterval;
+        record(missing);
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (std::size_t i = 0; i < m_counts.size(); ++i)
+    {
+        m_counts[i] += other.m_counts[i];
+    }
+
+    m_count += other.m_count;
+    m_max = std::max(m_max, other.m_max);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+
+    target = std::clamp<uint64_t>(target, 1, m_count);
+
+    uint64_t accumulated = 0;
+
+    for (std::size_t i = 0; i < m_counts.size(); ++i)
+    {
+        accumulated += m_counts[i];
+
+        if (accumulated >= target)
+        {
+            return std::min(highestValue(i), m_max);
+        }
+    }
+
+    return m_max;
+}
+
+uint64_t LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+std::size_t LatencyHistogram::index(uint64_t value)
+{
+    if (value < LinearCount)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    // Value is shifted into [512, 1024)
+    auto shift = static_cast<uint64_t>(std::bit_width(value)) - 10;
+
+    return static_cast<std::size_t>(
+        LinearCount + (shift - 1) * SubBucketCount + ((value >> shift) - SubBucketCount)
+    );
+}
+
+uint64_t LatencyHistogram::highestValue(std::size_t index)
+{
+    if (index < LinearCount)
+    {
+        return index;
+    }
+
+    auto shift = (index - LinearCount) / SubBucketCount + 1;
+    auto subBucket = (index - LinearCount) % SubBucketCount + SubBucketCount;
+
+    return ((subBucket + 1) << shift) - 1;
+}
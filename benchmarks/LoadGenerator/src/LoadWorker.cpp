@@ -0,0 +1,709 @@
+#include <cerrno>
+#include <charconv>
+#include <algorithm>
+#include <string_view>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <HTTPHeader.hpp>
+#include "LoadWorker.hpp"
+
+/**
+ * @brief Epoll data of timer. Connections
+ * use their indices.
+ */
+static constexpr uint64_t TimerData = UINT64_MAX;
+
+/**
+ * @brief Time of waiting for responses
+ * after end of run.
+ */
+static constexpr uint64_t DrainTime = 1'000'000'000;
+
+/**
+ * @brief Maximum size of response head.
+ */
+static constexpr std::size_t MaxHeadSize = 64 * 1024;
+
+static constexpr std::size_t ReadChunkSize = 16 * 1024;
+
+LoadWorker::LoadWorker(const LoadOptions& options, std::size_t connections, double rate) :
+    m_options(options),
+    m_interval(rate > 0 ? static_cast<uint64_t>(1e9 / rate) : 0),
+    m_request(),
+    m_epoll(epoll_create1(EPOLL_CLOEXEC)),
+    m_timer(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+    m_connections(std::max<std::size_t>(connections, 1)),
+    m_nextConnection(0),
+    m_backlog(),
+    m_nextIntended(0),
+    m_warmupEnd(0),
+    m_end(0),
+    m_stopping(false),
+    m_histogram(),
+    m_responses(0),
+    m_errors(0),
+    m_bytesReceived(0)
+{
+    m_request = (options.bodySize > 0 ? "POST " : "GET ") + options.path + " HTTP/1.1\r\n"
+                "Host: 127.0.0.1\r\n";
+
+    if (!options.keepAlive)
+    {
+        m_request += "Connection: close\r\n";
+    }
+
+    if (options.bodySize > 0)
+    {
+        m_request += "Content-Type: application/octet-stream\r\n"
+                     "Content-Length: " + std::to_string(options.bodySize) + "\r\n";
+    }
+
+    m_request += "\r\n";
+    m_request.append(options.bodySize, 'x');
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = TimerData;
+
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_timer, &event);
+}
+
+LoadWorker::~LoadWorker()
+{
+    for (auto&& connection : m_connections)
+    {
+        if (connection.socket != -1)
+        {
+            ::close(connection.socket);
+        }
+    }
+
+    ::close(m_timer);
+    ::close(m_epoll);
+}
+
+void LoadWorker::run()
+{
+    auto start = now();
+
+    m_warmupEnd = start + static_cast<uint64_t>(m_options.warmup.count());
+    m_end = m_warmupEnd + static_cast<uint64_t>(m_options.duration.count());
+    m_nextIntended = start;
+
+    uint64_t drainEnd = 0;
+
+    epoll_event events[64];
+
+    while (true)
+    {
+        auto time = now();
+
+        if (!m_stopping && time >= m_end)
+        {
+            m_stopping = true;
+            drainEnd = time + DrainTime;
+        }
+
+        if (m_stopping)
+        {
+            bool isIdle = std::all_of(
+                m_connections.begin(),
+                m_connections.end(),
+                [](const Connection& connection)
+                {
+                    return connection.inFlight.empty();
+                }
+            );
+
+            if (isIdle || time >= drainEnd)
+            {
+                break;
+            }
+
+            armTimer(drainEnd);
+        }
+        else
+        {
+            if (m_options.mode == LoadOptions::Mode::Open)
+            {
+                // Schedule doesn't depend on responses
+                for (; m_nextIntended <= time; m_nextIntended += m_interval)
+                {
+                    m_backlog.push_back(m_nextIntended);
+                }
+
+                armTimer(std::min(m_nextIntended, m_end));
+            }
+            else
+            {
+                armTimer(m_end);
+            }
+
+            dispatch();
+        }
+
+        auto count = epoll_wait(m_epoll, events, static_cast<int>(std::size(events)), -1);
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (events[i].data.u64 == TimerData)
+            {
+                uint64_t expirations;
+
+                while (::read(m_timer, &expirations, sizeof(expirations)) > 0)
+                {
+                }
+
+                continue;
+            }
+
+            auto& connection = m_connections[events[i].data.u64];
+
+            if (connection.socket == -1)
+            {
+                continue;
+            }
+
+            if (events[i].events & EPOLLERR)
+            {
+                disconnect(connection, true);
+                continue;
+            }
+
+            if ((events[i].events & EPOLLOUT) && !flush(connection))
+            {
+                disconnect(connection, true);
+                continue;
+            }
+
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLRDHUP))
+            {
+                receive(connection);
+            }
+        }
+    }
+
+    // Requests without responses are recorded with
+    // time they waited, so stalls are not hidden
+    auto time = now();
+
+    for (auto start : m_backlog)
+    {
+        if (isMeasured(start))
+        {
+            recordLatency(start, time);
+            ++m_errors;
+        }
+    }
+
+    for (auto&& connection : m_connections)
+    {
+        for (auto start : connection.inFlight)
+        {
+            if (isMeasured(start))
+            {
+                recordLatency(start, time);
+                ++m_errors;
+            }
+        }
+    }
+}
+
+const LatencyHistogram& LoadWorker::histogram() const
+{
+    return m_histogram;
+}
+
+uint64_t LoadWorker::responses() const
+{
+    return m_responses;
+}
+
+uint64_t LoadWorker::errors() const
+{
+    return m_errors;
+}
+
+uint64_t LoadWorker::bytesReceived() const
+{
+    return m_bytesReceived;
+}
+
+uint64_t LoadWorker::now()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()
+        ).count()
+    );
+}
+
+bool LoadWorker::connect(Connection& connection)
+{
+    connection.socket = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (connection.socket == -1)
+    {
+        return false;
+    }
+
+    int enabled = 1;
+    setsockopt(connection.socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(m_options.port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (::connect(connection.socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 &&
+        errno != EINPROGRESS)
+    {
+        ::close(connection.socket);
+        connection.socket = -1;
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.u64 = static_cast<uint64_t>(&connection - m_connections.data());
+
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, connection.socket, &event);
+
+    return true;
+}
+
+void LoadWorker::disconnect(Connection& connection, bool failed)
+{
+    if (connection.socket != -1)
+    {
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, connection.socket, nullptr);
+        ::close(connection.socket);
+        connection.socket = -1;
+    }
+
+    if (failed)
+    {
+        for (auto start : connection.inFlight)
+        {
+            if (isMeasured(start))
+            {
+                ++m_errors;
+            }
+        }
+    }
+    else
+    {
+        // Server closed connection after keep alive
+        // limit, so pipelined requests are sent again
+        m_backlog.insert(m_backlog.begin(), connection.inFlight.begin(), connection.inFlight.end());
+    }
+
+    connection.output.clear();
+    connection.outputSent = 0;
+    connection.inputBegin = 0;
+    connection.inputEnd = 0;
+    connection.inFlight.clear();
+    connection.state = ResponseState::Header;
+    connection.bodyRemaining = 0;
+    connection.closeAfterResponse = false;
+    connection.statusFailed = false;
+}
+
+bool LoadWorker::canSend(const Connection& connection) const
+{
+    if (!m_options.keepAlive)
+    {
+        // Every request opens new connection
+        return connection.socket == -1;
+    }
+
+    return connection.state != ResponseState::Closing &&
+           connection.inFlight.size() < m_options.pipeline;
+}
+
+void LoadWorker::send(Connection& connection, uint64_t start)
+{
+    if (connection.socket == -1 && !connect(connection))
+    {
+        if (isMeasured(start))
+        {
+            ++m_errors;
+        }
+
+        return;
+    }
+
+    connection.output += m_request;
+    connection.inFlight.push_back(start);
+
+    if (!flush(connection))
+    {
+        disconnect(connection, true);
+    }
+}
+
+void LoadWorker::dispatch()
+{
+    auto connectionsCount = m_connections.size();
+
+    // Requests are spread between connections
+    // with free pipeline slots
+    while (!m_backlog.empty())
+    {
+        std::size_t checked = 0;
+
+        while (checked < connectionsCount && !canSend(m_connections[m_nextConnection]))
+        {
+            m_nextConnection = (m_nextConnection + 1) % connectionsCount;
+            ++checked;
+        }
+
+        if (checked == connectionsCount)
+        {
+            return;
+        }
+
+        auto start = m_backlog.front();
+        m_backlog.pop_front();
+
+        send(m_connections[m_nextConnection], start);
+
+        m_nextConnection = (m_nextConnection + 1) % connectionsCount;
+    }
+
+    if (m_options.mode != LoadOptions::Mode::Closed)
+    {
+        return;
+    }
+
+    for (auto&& connection : m_connections)
+    {
+        while (canSend(connection))
+        {
+            send(connection, now());
+
+            if (connection.socket == -1)
+            {
+                break;
+            }
+        }
+    }
+}
+
+bool LoadWorker::flush(Connection& connection)
+{
+    while (connection.outputSent < connection.output.size())
+    {
+        auto sent = ::send(
+            connection.socket,
+            connection.output.data() + connection.outputSent,
+            connection.output.size() - connection.outputSent,
+            MSG_NOSIGNAL
+        );
+
+        if (sent == -1)
+        {
+            // Socket may be still connecting
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOTCONN)
+            {
+                return true;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        connection.outputSent += static_cast<std::size_t>(sent);
+    }
+
+    connection.output.clear();
+    connection.outputSent = 0;
+
+    return true;
+}
+
+void LoadWorker::receive(Connection& connection)
+{
+    while (true)
+    {
+        if (connection.input.size() - connection.inputEnd < ReadChunkSize)
+        {
+            if (connection.inputBegin > 0)
+            {
+                std::copy(
+                    connection.input.begin() + connection.inputBegin,
+                    connection.input.begin() + connection.inputEnd,
+                    connection.input.begin()
+                );
+
+                connection.inputEnd -= connection.inputBegin;
+                connection.inputBegin = 0;
+            }
+
+            if (connection.input.size() - connection.inputEnd < ReadChunkSize)
+            {
+                connection.input.resize(std::max(connection.input.size() * 2, ReadChunkSize * 4));
+            }
+        }
+
+        auto received = ::recv(
+            connection.socket,
+            connection.input.data() + connection.inputEnd,
+            connection.input.size() - connection.inputEnd,
+            0
+        );
+
+        if (received == 0)
+        {
+            // Closing is expected only after response
+            disconnect(
+                connection,
+                connection.state != ResponseState::Closing && !connection.inFlight.empty()
+            );
+            return;
+        }
+
+        if (received == -1)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            disconnect(connection, true);
+            return;
+        }
+
+        connection.inputEnd += static_cast<std::size_t>(received);
+
+        if (isMeasured(now()))
+        {
+            m_bytesReceived += static_cast<uint64_t>(received);
+        }
+
+        while (true)
+        {
+            auto result = parseResponse(connection);
+
+            if (result == ParseResult::Malformed)
+            {
+                disconnect(connection, true);
+                return;
+            }
+
+            if (result == ParseResult::Incomplete)
+            {
+                break;
+            }
+
+            finishResponse(connection);
+        }
+    }
+}
+
+LoadWorker::ParseResult LoadWorker::parseResponse(Connection& connection)
+{
+    auto* data = connection.input.data() + connection.inputBegin;
+    auto size = connection.inputEnd - connection.inputBegin;
+
+    switch (connection.state)
+    {
+    case ResponseState::Header:
+    {
+        std::string_view input(data, size);
+
+        auto end = input.find("\r\n\r\n");
+
+        if (end == std::string_view::npos)
+        {
+            return size > MaxHeadSize ? ParseResult::Malformed : ParseResult::Incomplete;
+        }
+
+        auto head = input.substr(0, end + 2);
+
+        int status = 0;
+
+        if (head.substr(0, 7) != "HTTP/1." ||
+            head.size() < 12 ||
+            std::from_chars(head.data() + 9, head.data() + 12, status).ec != std::errc())
+        {
+            return ParseResult::Malformed;
+        }
+
+        connection.statusFailed = status >= 400;
+        connection.bodyRemaining = 0;
+
+        bool isChunked = false;
+
+        // Status line is skipped
+        head.remove_prefix(head.find("\r\n") + 2);
+
+        while (!head.empty())
+        {
+            auto line = head.substr(0, head.find("\r\n"));
+            head.remove_prefix(line.size() + 2);
+
+            auto colon = line.find(':');
+
+            if (colon == std::string_view::npos)
+            {
+                continue;
+            }
+
+            auto name = line.substr(0, colon);
+            auto value = line.substr(colon + 1);
+
+            while (!value.empty() && value.front() == ' ')
+            {
+                value.remove_prefix(1);
+            }
+
+            if (HTTPHeader::equalsIgnoreCase(name, "Content-Length"))
+            {
+                std::from_chars(value.data(), value.data() + value.size(), connection.bodyRemaining);
+            }
+            else if (HTTPHeader::equalsIgnoreCase(name, "Transfer-Encoding"))
+            {
+                isChunked = HTTPHeader::equalsIgnoreCase(value, "chunked");
+            }
+            else if (HTTPHeader::equalsIgnoreCase(name, "Connection"))
+            {
+                connection.closeAfterResponse = HTTPHeader::equalsIgnoreCase(value, "close");
+            }
+        }
+
+        connection.inputBegin += end + 4;
+
+        if (isChunked)
+        {
+            connection.decoder.reset();
+            connection.state = ResponseState::Chunked;
+        }
+        else
+        {
+            connection.state = ResponseState::Body;
+        }
+
+        return parseResponse(connection);
+    }
+
+    case ResponseState::Body:
+    {
+        auto consumed = std::min(size, connection.bodyRemaining);
+
+        connection.inputBegin += consumed;
+        connection.bodyRemaining -= consumed;
+
+        return connection.bodyRemaining == 0 ? ParseResult::Complete : ParseResult::Incomplete;
+    }
+
+    case ResponseState::Chunked:
+    {
+        std::size_t consumed = 0;
+        std::size_t produced = 0;
+
+        // Body is decoded in place and dropped
+        auto* bytes = reinterpret_cast<std::byte*>(data);
+
+        auto status = connection.decoder.decode(bytes, size, bytes, consumed, produced);
+
+        connection.inputBegin += consumed;
+
+        switch (status)
+        {
+        case HTTPChunkedDecoder::Status::Complete:
+            return ParseResult::Complete;
+
+        case HTTPChunkedDecoder::Status::Error:
+            return ParseResult::Malformed;
+
+        case HTTPChunkedDecoder::Status::Incomplete:
+            break;
+        }
+
+        return ParseResult::Incomplete;
+    }
+
+    case ResponseState::Closing:
+        break;
+    }
+
+    // Nothing is expected before connection is closed
+    connection.inputBegin = connection.inputEnd;
+
+    return ParseResult::Incomplete;
+}
+
+void LoadWorker::finishResponse(Connection& connection)
+{
+    auto start = connection.inFlight.front();
+    connection.inFlight.pop_front();
+
+    recordLatency(start, now());
+
+    if (isMeasured(start))
+    {
+        ++m_responses;
+
+        if (connection.statusFailed)
+        {
+            ++m_errors;
+        }
+    }
+
+    connection.state = (!m_options.keepAlive || connection.closeAfterResponse) ?
+                       ResponseState::Closing :
+                       ResponseState::Header;
+
+    connection.closeAfterResponse = false;
+}
+
+bool LoadWorker::isMeasured(uint64_t start) const
+{
+    return start >= m_warmupEnd && start < m_end;
+}
+
+void LoadWorker::recordLatency(uint64_t start, uint64_t end)
+{
+    if (!isMeasured(start))
+    {
+        return;
+    }
+
+    // Closed mode sends next request only after
+    // response, so missed requests are estimated
+    m_histogram.recordCorrected(
+        end - start,
+        m_options.mode == LoadOptions::Mode::Closed ?
+            static_cast<uint64_t>(m_options.expectedInterval.count()) :
+            0
+    );
+}
+
+void LoadWorker::armTimer(uint64_t time)
+{
+    itimerspec timer{};
+    timer.it_value.tv_sec = static_cast<time_t>(time / 1'000'000'000);
+    timer.it_value.tv_nsec = static_cast<long>(time % 1'000'000'000);
+
+    // Zero value disarms timer
+    if (time == 0)
+    {
+        timer.it_value.tv_nsec = 1;
+    }
+
+    timerfd_settime(m_timer, TFD_TIMER_ABSTIME, &timer, nullptr);
+}
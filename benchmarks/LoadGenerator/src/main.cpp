@@ -0,0 +1,429 @@
+#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <limits>
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <HTTPServer.hpp>
+#include <RESTServer.hpp>
+#include "LoadWorker.hpp"
+
+/**
+ * @brief Server, that answers any request
+ * with body of fixed size.
+ */
+class FixedServer : public HTTPServer
+{
+public:
+
+    explicit FixedServer(std::size_t size) :
+        m_body(size, 'x')
+    {
+
+    }
+
+protected:
+
+    HTTPResponse proceedRequest(HTTPRequest request) override
+    {
+        HTTPResponse response(request.memoryResource());
+        response.version() = "HTTP/1.1";
+        response.statusCode() = HTTPResponse::StatusCode::Ok;
+        response.setData(reinterpret_cast<std::byte*>(m_body.data()), m_body.size());
+
+        return response;
+    }
+
+private:
+    std::string m_body;
+};
+
+/**
+ * @brief Options of generator, that are not
+ * options of single run.
+ */
+struct GeneratorOptions
+{
+    LoadOptions load;
+
+    /**
+     * @brief In-process server: "http", "rest"
+     * or "none" for external server.
+     */
+    std::string server = "http";
+    std::size_t workers = 1;
+    std::size_t responseSize = 0;
+    bool scenarios = false;
+};
+
+/**
+ * @brief Function for parsing command line.
+ * Options have `--name=value` form.
+ * @param argc Number of arguments.
+ * @param argv Arguments.
+ * @param options Parsed options.
+ * @return Success.
+ */
+static bool parseOptions(int argc, char** argv, GeneratorOptions& options)
+{
+    auto seconds = [](const std::string& value)
+    {
+        return std::chrono::nanoseconds(static_cast<int64_t>(std::atof(value.c_str()) * 1e9));
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        if (argument.substr(0, 2) != "--")
+        {
+            return false;
+        }
+
+        auto separator = argument.find('=');
+        auto name = argument.substr(2, separator == std::string::npos ? std::string::npos : separator - 2);
+        auto value = separator == std::string::npos ? std::string() : argument.substr(separator + 1);
+        auto number = static_cast<std::size_t>(std::atoll(value.c_str()));
+
+        if (name == "mode")
+        {
+            if (value != "closed" && value != "open")
+            {
+                return false;
+            }
+
+            options.load.mode = value == "open" ? LoadOptions::Mode::Open : LoadOptions::Mode::Closed;
+        }
+        else if (name == "rate")
+        {
+            options.load.rate = std::atof(value.c_str());
+        }
+        else if (name == "connections")
+        {
+            options.load.connections = number;
+        }
+        else if (name == "threads")
+        {
+            options.load.threads = number;
+        }
+        else if (name == "pipeline")
+        {
+            options.load.pipeline = number;
+        }
+        else if (name == "close")
+        {
+            options.load.keepAlive = false;
+        }
+        else if (name == "body")
+        {
+            options.load.bodySize = number;
+        }
+        else if (name == "response")
+        {
+            options.responseSize = number;
+        }
+        else if (name == "port")
+        {
+            options.load.port = static_cast<uint16_t>(number);
+        }
+        else if (name == "path")
+        {
+            options.load.path = value;
+        }
+        else if (name == "server")
+        {
+            if (value != "http" && value != "rest" && value != "none")
+            {
+                return false;
+            }
+
+            options.server = value;
+        }
+        else if (name == "workers")
+        {
+            options.workers = number;
+        }
+        else if (name == "duration")
+        {
+            options.load.duration = seconds(value);
+        }
+        else if (name == "warmup")
+        {
+            options.load.warmup = seconds(value);
+        }
+        else if (name == "expected-interval")
+        {
+            options.load.expectedInterval = seconds(value);
+        }
+        else if (name == "scenarios")
+        {
+            options.scenarios = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return options.load.connections > 0 &&
+           options.load.threads > 0 &&
+           options.load.pipeline > 0 &&
+           options.load.rate > 0;
+}
+
+/**
+ * @brief Function for waiting, until server
+ * accepts connections.
+ * @param port Server port.
+ * @return Success.
+ */
+static bool waitServer(uint16_t port)
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for (int attempt = 0; attempt < 100; ++attempt)
+    {
+        auto descriptor = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        auto result = ::connect(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+
+        ::close(descriptor);
+
+        if (result == 0)
+        {
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    return false;
+}
+
+/**
+ * @brief Function for starting in-process server
+ * on background thread. Server is never stopped,
+ * process exits with it.
+ * @param options Generator options.
+ * @return Success.
+ */
+static bool startServer(const GeneratorOptions& options)
+{
+    std::unique_ptr<HTTPServer> server;
+
+    if (options.server == "http")
+    {
+        server = std::make_unique<FixedServer>(options.responseSize);
+    }
+    else
+    {
+        auto rest = std::make_unique<RESTServer>();
+
+        rest->addProcessor(
+            HTTPRequest::Method::GET,
+            "/api/version",
+            [](RESTServer::Arguments, std::byte*, std::size_t) -> nlohmann::json
+            {
+                return {{"version", "testing"}};
+            }
+        );
+
+        rest->addProcessor(
+            HTTPRequest::Method::POST,
+            "/api/echo",
+            [](RESTServer::Arguments, std::byte*, std::size_t s) -> nlohmann::json
+            {
+                return {{"size", s}};
+            }
+        );
+
+        server = std::move(rest);
+    }
+
+    server->setWorkersCount(options.workers);
+    server->setMaxKeepAliveRequests(std::numeric_limits<std::size_t>::max());
+
+    std::thread(
+        [server = std::move(server), port = options.load.port]()
+        {
+            server->exec(INADDR_LOOPBACK, port);
+        }
+    ).detach();
+
+    return waitServer(options.load.port);
+}
+
+/**
+ * @brief Function for executing run with all
+ * worker threads and printing its results.
+ * @param name Run name.
+ * @param options Run options.
+ */
+static void runLoad(const std::string& name, const LoadOptions& options)
+{
+    std::vector<std::unique_ptr<LoadWorker>> workers;
+
+    for (std::size_t i = 0; i < options.threads; ++i)
+    {
+        // Connections and rate are split between threads
+        auto connections = options.connections / options.threads +
+                           (i < options.connections % options.threads ? 1 : 0);
+
+        workers.push_back(std::make_unique<LoadWorker>(
+            options,
+            connections,
+            options.rate / static_cast<double>(options.threads)
+        ));
+    }
+
+    std::vector<std::thread> threads;
+
+    for (auto&& worker : workers)
+    {
+        threads.emplace_back(&LoadWorker::run, worker.get());
+    }
+
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+
+    LatencyHistogram histogram;
+    uint64_t responses = 0;
+    uint64_t errors = 0;
+    uint64_t bytes = 0;
+
+    for (auto&& worker : workers)
+    {
+        histogram.merge(worker->histogram());
+        responses += worker->responses();
+        errors += worker->errors();
+        bytes += worker->bytesReceived();
+    }
+
+    auto duration = std::chrono::duration<double>(options.duration).count();
+
+    auto milliseconds = [&](double percentile)
+    {
+        return static_cast<double>(histogram.percentile(percentile)) / 1e6;
+    };
+
+    std::printf(
+        "%-36s %12.0f %10.2f %8llu %10.3f %10.3f %10.3f %10.3f\n",
+        name.c_str(),
+        static_cast<double>(responses) / duration,
+        static_cast<double>(bytes) / duration / (1024 * 1024),
+        static_cast<unsigned long long>(errors),
+        milliseconds(50),
+        milliseconds(99),
+        milliseconds(99.9),
+        static_cast<double>(histogram.max()) / 1e6
+    );
+
+    std::fflush(stdout);
+}
+
+/**
+ * @brief Function for getting run name.
+ * @param options Run options.
+ * @return Name.
+ */
+static std::string runName(const LoadOptions& options)
+{
+    std::string name = options.mode == LoadOptions::Mode::Open ?
+                       "open/" + std::to_string(static_cast<uint64_t>(options.rate)) :
+                       "closed";
+
+    name += options.keepAlive ? "/keepalive" : "/close";
+    name += "/c" + std::to_string(options.connections);
+    name += "/p" + std::to_string(options.pipeline);
+    name += "/b" + std::to_string(options.bodySize);
+
+    return name;
+}
+
+int main(int argc, char** argv)
+{
+    GeneratorOptions options;
+
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "Wrong usage. Usage: " << std::endl
+                  << "    " << argv[0] << " [--mode=closed|open] [--rate=<rps>] [--connections=<n>]" << std::endl
+                  << "        [--threads=<n>] [--pipeline=<n>] [--close] [--body=<bytes>]" << std::endl
+                  << "        [--response=<bytes>] [--port=<port>] [--server=http|rest|none]" << std::endl
+                  << "        [--workers=<n>] [--path=<path>] [--duration=<s>] [--warmup=<s>]" << std::endl
+                  << "        [--expected-interval=<s>] [--scenarios]" << std::endl;
+
+        return -1;
+    }
+
+    if (options.server != "none" && !startServer(options))
+    {
+        std::cerr << "Server is not started on port " << options.load.port << "." << std::endl;
+        return -2;
+    }
+
+    std::printf(
+        "%-36s %12s %10s %8s %10s %10s %10s %10s\n",
+        "run", "req/s", "MB/s", "errors", "p50 ms", "p99 ms", "p99.9 ms", "max ms"
+    );
+
+    if (!options.scenarios)
+    {
+        runLoad(runName(options.load), options.load);
+    }
+    else
+    {
+        // Connection reuse, pipelining and body
+        // size are changed one at a time
+        std::vector<LoadOptions> runs;
+
+        auto base = options.load;
+        base.pipeline = 1;
+        base.bodySize = 0;
+        base.keepAlive = true;
+
+        for (auto keepAlive : {true, false})
+        {
+            auto run = base;
+            run.keepAlive = keepAlive;
+            runs.push_back(run);
+        }
+
+        for (std::size_t pipeline : {8, 32})
+        {
+            auto run = base;
+            run.pipeline = pipeline;
+            runs.push_back(run);
+        }
+
+        for (std::size_t bodySize : {1024, 64 * 1024})
+        {
+            auto run = base;
+            run.bodySize = bodySize;
+            runs.push_back(run);
+        }
+
+        auto open = base;
+        open.mode = LoadOptions::Mode::Open;
+        runs.push_back(open);
+
+        for (auto&& run : runs)
+        {
+            runLoad(runName(run), run);
+        }
+    }
+
+    // Server thread is never joined
+    std::fflush(stdout);
+    _exit(0);
+}
@@ -0,0 +1,89 @@
+#include <string_view>
+#include <benchmark/benchmark.h>
+#include <HTTPArena.hpp>
+#include <RESTServer.hpp>
+#include "Allocations.hpp"
+
+/**
+ * @brief URIs of usual API requests.
+ */
+static const std::string_view URIs[] = {
+    "/api/version",
+    "/api/v2/orders/12345/items?expand=product&limit=50",
+    "/api/users/42",
+    "/api/search?q=simple+http+server&page=2&sort=desc&lang=en%2Dus",
+    "/static/js/main.3f1c9a52.js",
+    "/api/v1/status?verbose"
+};
+
+static std::size_t urisSize()
+{
+    std::size_t result = 0;
+
+    for (auto&& uri : URIs)
+    {
+        result += uri.size();
+    }
+
+    return result;
+}
+
+static void SplitUri(benchmark::State& state)
+{
+    HTTPArena arena;
+
+    auto allocations = Allocations::Count();
+
+    for (auto _ : state)
+    {
+        for (auto&& uri : URIs)
+        {
+            std::string_view path;
+            RESTServer::Arguments arguments(&arena);
+
+            benchmark::DoNotOptimize(RESTServer::splitUri(uri, path, arguments));
+            benchmark::DoNotOptimize(path);
+        }
+
+        arena.reset();
+    }
+
+    Allocations::Report(state, allocations);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * urisSize()));
+}
+
+BENCHMARK(SplitUri);
+
+static void SplitUriArguments(benchmark::State& state)
+{
+    HTTPArena arena;
+
+    auto allocations = Allocations::Count();
+
+    // Every argument is read, so query is
+    // parsed and decoded
+    for (auto _ : state)
+    {
+        for (auto&& uri : URIs)
+        {
+            std::string_view path;
+            RESTServer::Arguments arguments(&arena);
+
+            RESTServer::splitUri(uri, path, arguments);
+
+            for (std::size_t i = 0; i < arguments.size(); ++i)
+            {
+                benchmark::DoNotOptimize(arguments.argument(i));
+            }
+        }
+
+        arena.reset();
+    }
+
+    Allocations::Report(state, allocations);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * urisSize()));
+}
+
+BENCHMARK(SplitUriArguments);
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <netinet/in.h>
+#include <Loggers/BasicLogger.hpp>
+#include <CurrentLogger.hpp>
+#include <HTTPServer.hpp>
+
+/**
+ * @brief Server, that answers `/sleep/<ms>`
+ * requests after delay. Worker keeps serving
+ * other connections, while handler is suspended.
+ */
+class AsyncServer : public HTTPServer
+{
+protected:
+    Task<HTTPResponse> proceedRequestAsync(HTTPRequest& request) override
+    {
+        constexpr std::string_view prefix = "/sleep/";
+
+        HTTPResponse response;
+        response.version() = "HTTP/1.1";
+
+        if (request.uri().substr(0, prefix.size()) != prefix)
+        {
+            response.statusCode() = HTTPResponse::StatusCode::NotFound;
+            co_return response;
+        }
+
+        auto milliseconds = std::atoi(std::string(request.uri().substr(prefix.size())).c_str());
+
+        co_await HTTPExecutor::current()->sleep(std::chrono::milliseconds(milliseconds));
+
+        response.statusCode() = HTTPResponse::StatusCode::Ok;
+        response.setData("Slept " + std::to_string(milliseconds) + " ms\n");
+
+        co_return response;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Wrong usage. Usage: " << std::endl;
+        if (argc > 0)
+        {
+            std::cerr << "    " << argv[0] << " <port> [workers]" << std::endl;
+        }
+
+        return -1;
+    }
+
+    auto port = std::atoi(argv[1]);
+
+    if (port == 0)
+    {
+        std::cerr << "Wrong port value." << std::endl;
+        return -2;
+    }
+
+    CurrentLogger::setCurrentLogger(std::make_shared<Loggers::BasicLogger>());
+
+    AsyncServer server;
+
+    if (argc > 2)
+    {
+        server.setWorkersCount(static_cast<std::size_t>(std::atoi(argv[2])));
+    }
+
+    server.exec(INADDR_ANY, static_cast<uint16_t>(port));
+
+    return 0;
+}
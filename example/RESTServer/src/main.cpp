@@ -16,7 +16,7 @@ int main(int argc, char** argv)
         std::cerr << "Wrong usage. Usage: " << std::endl;
         if (argc > 0)
         {
-            std::cerr << "    " << argv[0] << " <port>" << std::endl;
+            std::cerr << "    " << argv[0] << " <port> [workers]" << std::endl;
         }
 
         return -1;
@@ -34,6 +34,13 @@ int main(int argc, char** argv)
 
     RESTServer server;
 
+    if (argc > 2)
+    {
+        server.setWorkersCount(static_cast<std::size_t>(std::atoi(argv[2])));
+    }
+
+    server.setMetricsPath("/metrics");
+
     server.addProcessor(
         HTTPRequest::Method::GET,
         "/api/version",
@@ -56,6 +63,33 @@ int main(int argc, char** argv)
         }
     );
 
+    server.addProcessor(
+        HTTPRequest::Method::POST,
+        "/api/echo",
+        [](RESTServer::Arguments args, std::byte* data, std::size_t s) -> nlohmann::json
+        {
+            nlohmann::json result;
+
+            result["size"] = s;
+            result["data"] = std::string(reinterpret_cast<const char*>(data), s);
+
+            return result;
+        }
+    );
+
+    server.addProcessor(
+        HTTPRequest::Method::GET,
+        "/api/users/:id",
+        [](RESTServer::Arguments args, std::byte* data, std::size_t s) -> nlohmann::json
+        {
+            nlohmann::json result;
+
+            result["id"] = args["id"];
+
+            return result;
+        }
+    );
+
     server.exec(INADDR_ANY, static_cast<uint16_t>(port));
 
     return 0;
@@ -0,0 +1,42 @@
+#include <iostream>
+#include <netinet/in.h>
+#include <Loggers/BasicLogger.hpp>
+#include <CurrentLogger.hpp>
+#include <StaticFileServer.hpp>
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Wrong usage. Usage: " << std::endl;
+        if (argc > 0)
+        {
+            std::cerr << "    " << argv[0] << " <port> <directory> [workers]" << std::endl;
+        }
+
+        return -1;
+    }
+
+    auto port = std::atoi(argv[1]);
+
+    if (port == 0)
+    {
+        std::cerr << "Wrong port value." << std::endl;
+        return -2;
+    }
+
+    CurrentLogger::setCurrentLogger(std::make_shared<Loggers::BasicLogger>());
+
+    StaticFileServer server;
+
+    if (argc > 3)
+    {
+        server.setWorkersCount(static_cast<std::size_t>(std::atoi(argv[3])));
+    }
+
+    server.addDirectory("/", argv[2]);
+
+    server.exec(INADDR_ANY, static_cast<uint16_t>(port));
+
+    return 0;
+}
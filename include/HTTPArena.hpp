@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Monotonic memory resource, that is
+ * reset after every response. Deallocation
+ * does nothing, and blocks are kept after
+ * reset, so after first requests of connection
+ * parsing and response building don't call
+ * upstream allocator.
+ */
+class HTTPArena : public std::pmr::memory_resource
+{
+public:
+
+    /**
+     * @brief Constructor. First block is
+     * allocated on first allocation.
+     * @param blockSize Size of first block. Next
+     * blocks are twice bigger than previous one.
+     * @param upstream Resource of blocks.
+     */
+    explicit HTTPArena(std::size_t blockSize = 4096,
+                       std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    /**
+     * @brief Destructor. Returns all blocks
+     * to upstream resource.
+     */
+    ~HTTPArena() override;
+
+    HTTPArena(const HTTPArena&) = delete;
+    HTTPArena& operator=(const HTTPArena&) = delete;
+
+    /**
+     * @brief Method for releasing all allocations
+     * at once. Blocks are kept for reuse. Objects,
+     * allocated from arena, must not be used after
+     * this call.
+     */
+    void reset();
+
+    /**
+     * @brief Method for getting total size
+     * of allocated blocks.
+     * @return Size in bytes.
+     */
+    std::size_t capacity() const;
+
+protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+
+    /**
+     * @brief Memory block, received from
+     * upstream resource.
+     */
+    struct Block
+    {
+        std::byte* memory;
+        std::size_t size;
+    };
+
+    std::size_t m_blockSize;
+    std::pmr::memory_resource* m_upstream;
+
+    std::vector<Block> m_blocks;
+    std::size_t m_current;
+    std::size_t m_offset;
+};
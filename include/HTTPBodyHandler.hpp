@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include "HTTPRequest.hpp"
+#include "HTTPResponse.hpp"
+
+/**
+ * @brief Interface of streaming request body
+ * receiver. Instance is created by
+ * `HTTPServer::createBodyHandler` for single
+ * request, and it receives decoded body
+ * chunks as soon as they arrive, so body
+ * is never buffered whole.
+ */
+class HTTPBodyHandler
+{
+public:
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HTTPBodyHandler() = default;
+
+    /**
+     * @brief Method for processing next body chunk.
+     * Data is valid only until method returns.
+     * @param data Pointer to chunk data.
+     * @param size Chunk size in bytes.
+     * @return False if rest of body has to be
+     * skipped. `finish` is called immediately and
+     * connection is closed after response.
+     */
+    virtual bool proceedChunk(std::byte* data, std::size_t size) = 0;
+
+    /**
+     * @brief Method for forming response after
+     * whole body was received. Request has no data.
+     * @param request Request object.
+     * @return Response, that has to be sent to request
+     * peer.
+     */
+    virtual HTTPResponse finish(HTTPRequest request) = 0;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Interface of streaming response body
+ * source. Connection requests body in parts,
+ * when previous part is sent, so body is never
+ * formed whole. If body ends in first part, it's
+ * sent with `Content-Length`, otherwise with
+ * chunked transfer encoding.
+ */
+class HTTPBodyStream
+{
+public:
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HTTPBodyStream() = default;
+
+    /**
+     * @brief Method for writing next part of body.
+     * Part may be larger than requested size, but
+     * it's expected to be close to it.
+     * @param buffer Buffer, bytes have to be
+     * appended to.
+     * @param size Requested size of part in bytes.
+     * @return False if body is finished.
+     */
+    virtual bool write(std::vector<std::byte>& buffer, std::size_t size) = 0;
+};
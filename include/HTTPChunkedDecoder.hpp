@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Resumable decoder of `Transfer-Encoding: chunked`
+ * body. Decoding can be performed in place,
+ * because decoded data is never longer than
+ * encoded one.
+ *
+ * Example:
+ * ```
+ * 4\r\n
+ * Wiki\r\n
+ * 0\r\n
+ * \r\n
+ * ```
+ */
+class HTTPChunkedDecoder
+{
+public:
+
+    /**
+     * @brief Decoding status.
+     */
+    enum class Status
+    {
+          Incomplete
+        , Complete
+        , Error
+    };
+
+    /**
+     * @brief Maximum length of chunk size line
+     * or trailer line.
+     */
+    static constexpr std::size_t MaxLineSize = 4096;
+
+    /**
+     * @brief Constructor.
+     */
+    HTTPChunkedDecoder();
+
+    /**
+     * @brief Method for resetting decoder state
+     * before decoding new body.
+     */
+    void reset();
+
+    /**
+     * @brief Method for decoding next part of
+     * encoded bytes. Incomplete lines are not
+     * consumed, so they have to be passed again
+     * with following bytes.
+     * @param input Pointer to encoded bytes.
+     * @param size Size of encoded bytes.
+     * @param output Pointer to output buffer. It
+     * may point to the same memory as input, but
+     * it has to be <= input.
+     * @param consumed Number of consumed encoded bytes.
+     * @param produced Number of decoded bytes, written
+     * to output.
+     * @return Decoding status.
+     */
+    Status decode(
+        const std::byte* input,
+        std::size_t size,
+        std::byte* output,
+        std::size_t& consumed,
+        std::size_t& produced
+    );
+
+private:
+
+    /**
+     * @brief Decoder state.
+     */
+    enum class State
+    {
+          Size
+        , Data
+        , DataEnd
+        , Trailer
+        , Finished
+    };
+
+    /**
+     * @brief Method for parsing chunk size line.
+     * @param line Pointer to line.
+     * @param size Line size without line break.
+     * @return Parsing success.
+     */
+    bool parseSize(const std::byte* line, std::size_t size);
+
+    State m_state;
+    std::size_t m_chunkRemaining;
+};
@@ -0,0 +1,535 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <Tools/Network.hpp>
+#include "HTTPArena.hpp"
+#include "HTTPRequest.hpp"
+#include "HTTPResponse.hpp"
+#include "HTTPTimerWheel.hpp"
+#include "HTTPBodyHandler.hpp"
+#include "HTTPChunkedDecoder.hpp"
+
+/**
+ * @brief Class, that describes single client
+ * connection, handled by server event loop.
+ * Connection is a state machine:
+ * `Reading` -> `Handling` -> `Writing`.
+ * Request is parsed incrementally, while
+ * it's bytes are received.
+ */
+class HTTPConnection
+{
+public:
+
+    /**
+     * @brief Connection states.
+     */
+    enum class State
+    {
+          Reading
+        , Handling
+        , Writing
+    };
+
+    /**
+     * @brief Timeouts of connection, that
+     * limit waiting for client.
+     */
+    enum class Timeout
+    {
+          None
+        , KeepAlive
+        , Header
+        , Body
+        , Write
+    };
+
+    /**
+     * @brief Maximum size of request header. If
+     * header terminator was not received in this
+     * amount of bytes, connection is dropped.
+     */
+    static constexpr std::size_t MaxHeaderSize = 64 * 1024;
+
+    /**
+     * @brief Initial size of input buffer. Buffer
+     * is doubled, when less than quarter of this
+     * size is free.
+     */
+    static constexpr std::size_t ReadChunkSize = 4096;
+
+    /**
+     * @brief Size of first block of connection
+     * arena. Parsed request, response header and
+     * data, allocated by handler from request
+     * memory resource, are placed in arena, that
+     * is reset after every response.
+     */
+    static constexpr std::size_t ArenaBlockSize = 4096;
+
+    /**
+     * @brief Size of part, that is requested from
+     * response body stream. Only one part is kept
+     * in memory at once.
+     */
+    static constexpr std::size_t StreamPartSize = 16 * 1024;
+
+    /**
+     * @brief Constructor.
+     * @param socket Accepted non blocking client socket.
+     * Connection takes ownership of socket.
+     * @param address Peer address.
+     */
+    HTTPConnection(socket_t socket, sockaddr_in address);
+
+    /**
+     * @brief Destructor. Closes client socket.
+     */
+    ~HTTPConnection();
+
+    HTTPConnection(const HTTPConnection&) = delete;
+    HTTPConnection& operator=(const HTTPConnection&) = delete;
+
+    /**
+     * @brief Method for getting client socket.
+     * @return Socket.
+     */
+    socket_t socket() const;
+
+    /**
+     * @brief Method for getting peer address.
+     * @return Peer address.
+     */
+    const sockaddr_in& address() const;
+
+    /**
+     * @brief Method for getting string
+     * representation of peer address.
+     * @return Peer address. Example: "127.0.0.1:51234"
+     */
+    std::string peerAddress() const;
+
+    /**
+     * @brief Method for getting connection state.
+     * @return State.
+     */
+    State state() const;
+
+    /**
+     * @brief Method for setting connection state.
+     * @param state New state.
+     */
+    void setState(State state);
+
+    /**
+     * @brief Method for reading available data
+     * from socket, until it would block. Received
+     * bytes are passed to request parser and body
+     * decoder. Reading stops after request header
+     * or whole request is received.
+     * @return False on receive error.
+     */
+    bool readAvailable();
+
+    /**
+     * @brief Method for checking is connection
+     * waiting for more request bytes.
+     * @return Is header or body being received.
+     */
+    bool isInputExpected() const;
+
+    /**
+     * @brief Method for passing bytes, received
+     * by completion based I/O, to request parser
+     * and body decoder.
+     * @param data Pointer to received bytes.
+     * @param size Size of received bytes.
+     */
+    void appendInput(const std::byte* data, std::size_t size);
+
+    /**
+     * @brief Method for marking, that peer closed
+     * it's side of connection.
+     */
+    void setPeerClosed();
+
+    /**
+     * @brief Method for checking is peer closed
+     * it's side of connection.
+     * @return Is end of stream received.
+     */
+    bool isPeerClosed() const;
+
+    /**
+     * @brief Method for checking is request
+     * header received and body reading has to
+     * be started with `prepareBody`.
+     * @return Is header received.
+     */
+    bool isHeaderReceived() const;
+
+    /**
+     * @brief Method for determining request body
+     * framing by `Transfer-Encoding` and
+     * `Content-Length` headers. If request has no
+     * body, request becomes received. Request with
+     * both headers or repeated `Transfer-Encoding`
+     * is malformed.
+     * @param maxBodySize Maximum size of buffered body.
+     * @return True if body is expected and has to
+     * be started with `beginBody`.
+     */
+    bool prepareBody(std::size_t maxBodySize);
+
+    /**
+     * @brief Method for starting body receiving.
+     * Sends `100 Continue` if client expects it.
+     * @param handler Streaming body handler. If it's
+     * nullptr, body is buffered whole.
+     */
+    void beginBody(std::unique_ptr<HTTPBodyHandler> handler);
+
+    /**
+     * @brief Method for checking is whole
+     * request received.
+     * @return Is request ready for handling.
+     */
+    bool isRequestReceived() const;
+
+    /**
+     * @brief Method for checking is received
+     * request malformed or too large.
+     * @return Is request parsing failed.
+     */
+    bool isRequestMalformed() const;
+
+    /**
+     * @brief Method for getting status code, that
+     * has to be sent for malformed request.
+     * @return Status code.
+     */
+    HTTPResponse::StatusCode requestError() const;
+
+    /**
+     * @brief Method for getting parsed request
+     * reference. Request is valid only if header
+     * is received. Request data is valid only if
+     * request is received and body is not streamed.
+     * @return Request reference.
+     */
+    HTTPRequest& request();
+
+    /**
+     * @brief Method for getting streaming body
+     * handler of current request.
+     * @return Pointer to handler or nullptr.
+     */
+    HTTPBodyHandler* bodyHandler() const;
+
+    /**
+     * @brief Method for checking is body
+     * receiving aborted by body handler.
+     * @return Is rest of body skipped.
+     */
+    bool isBodyAborted() const;
+
+    /**
+     * @brief Method for setting response, that has
+     * to be sent. Previous output is dropped.
+     * `Content-Length` and `Connection` headers are
+     * added to response, if it doesn't have them.
+     * Only status line and header are serialized,
+     * response data is sent from it's own buffer
+     * or file. Body stream is sent with
+     * `Content-Length`, if it ends in first part,
+     * or with chunked transfer encoding otherwise.
+     * @param response Response. It's kept by
+     * connection until it's sent.
+     * @param keepAlive Keep connection after response.
+     * @param headOnly Send only status line and header.
+     * It's used for responses to `HEAD` requests.
+     */
+    void setResponse(HTTPResponse response, bool keepAlive, bool headOnly);
+
+    /**
+     * @brief Method for setting serialized response,
+     * that is copied as is. Connection is closed
+     * after it's sent.
+     * @param data Response bytes.
+     * @param size Response size.
+     */
+    void setRawResponse(const std::byte* data, std::size_t size);
+
+    /**
+     * @brief Method for checking, will connection
+     * be kept after current response.
+     * @return Keep alive flag.
+     */
+    bool isKeepAlive() const;
+
+    /**
+     * @brief Method for getting number of requests,
+     * processed with this connection.
+     * @return Number of requests.
+     */
+    std::size_t requestsCount() const;
+
+    /**
+     * @brief Method for preparing connection for
+     * next request. Bytes, received after current
+     * request, are kept.
+     */
+    void reset();
+
+    /**
+     * @brief Method for getting number of bytes,
+     * received and sent since previous call.
+     * @param received Received bytes.
+     * @param sent Sent bytes.
+     */
+    void takeTraffic(uint64_t& received, uint64_t& sent);
+
+    /**
+     * @brief Method for marking current request as
+     * counted by in-flight requests limit.
+     * @param admitted Admitted flag.
+     */
+    void setAdmitted(bool admitted);
+
+    /**
+     * @brief Method for checking, is current request
+     * counted by in-flight requests limit.
+     * @return Admitted flag.
+     */
+    bool isAdmitted() const;
+
+    /**
+     * @brief Method for checking is any byte
+     * of current request received.
+     * @return Is request started.
+     */
+    bool isRequestStarted() const;
+
+    /**
+     * @brief Method for checking is request
+     * body being received.
+     * @return Is body expected.
+     */
+    bool isBodyExpected() const;
+
+    /**
+     * @brief Method for getting timer of
+     * connection timeouts.
+     * @return Timer.
+     */
+    HTTPTimerWheel::Timer& timer();
+
+    /**
+     * @brief Method for getting timeout, that
+     * timer is armed for.
+     * @return Timeout.
+     */
+    Timeout timeout() const;
+
+    /**
+     * @brief Method for setting timeout, that
+     * timer is armed for.
+     * @param timeout Timeout.
+     */
+    void setTimeout(Timeout timeout);
+
+    /**
+     * @brief Method for sending pending output,
+     * until it's finished or socket would block.
+     * @return False on send error.
+     */
+    bool writePending();
+
+    /**
+     * @brief Method for getting unsent status line,
+     * header and data. File data is not included.
+     * @param buffers Array of at least 2 buffers.
+     * @return Number of filled buffers. 0 if only
+     * file data is left.
+     */
+    int pendingOutput(iovec* buffers);
+
+    /**
+     * @brief Method for checking is output, returned
+     * by `pendingOutput`, last one. It's false, while
+     * body stream has parts, that are not written.
+     * @return Is pending output last.
+     */
+    bool isLastOutputPending() const;
+
+    /**
+     * @brief Method for advancing output after
+     * bytes were sent by completion based I/O.
+     * @param size Number of sent bytes.
+     */
+    void outputSent(std::size_t size);
+
+    /**
+     * @brief Method for checking is response
+     * data sent from file.
+     * @return Has response file.
+     */
+    bool hasFileOutput() const;
+
+    /**
+     * @brief Method for taking ownership of client
+     * socket. Socket is not closed by connection
+     * after this call.
+     * @return Socket.
+     */
+    socket_t releaseSocket();
+
+    /**
+     * @brief Method for checking is whole output
+     * sent.
+     * @return Is output finished.
+     */
+    bool isOutputFinished() const;
+
+private:
+
+    /**
+     * @brief Request receiving state.
+     */
+    enum class InputState
+    {
+          Header
+        , HeaderReceived
+        , Body
+        , Received
+        , Malformed
+    };
+
+    /**
+     * @brief Response body stream framing.
+     */
+    enum class StreamFraming
+    {
+          Identity
+        , Chunked
+    };
+
+    /**
+     * @brief Request body framing.
+     */
+    enum class BodyFraming
+    {
+          None
+        , Length
+        , Chunked
+    };
+
+    /**
+     * @brief Method for growing input buffer, so
+     * enough free space is available for receiving.
+     */
+    void reserveInput();
+
+    /**
+     * @brief Method for passing received bytes
+     * to request parser or body decoder.
+     */
+    void proceedInput();
+
+    /**
+     * @brief Method for consuming received
+     * body bytes.
+     */
+    void consumeBody();
+
+    /**
+     * @brief Method for passing decoded body
+     * bytes to body handler. Passed and consumed
+     * bytes are dropped from input buffer.
+     * @param size Size of decoded data at body offset.
+     */
+    void streamBody(std::size_t size);
+
+    /**
+     * @brief Method for finishing request receiving.
+     */
+    void finishBody();
+
+    /**
+     * @brief Method for writing next part of response
+     * body stream after space for chunk size.
+     * @return False on stream error.
+     */
+    bool readStream();
+
+    /**
+     * @brief Method for adding chunk size and
+     * terminator to current part of body stream.
+     */
+    void frameStreamPart();
+
+    /**
+     * @brief Method for getting size of current
+     * part of body stream with framing.
+     * @return Size in bytes.
+     */
+    std::size_t streamPartSize() const;
+
+    /**
+     * @brief Method for marking request as malformed.
+     * @param code Status code, that has to be sent.
+     */
+    void setMalformed(HTTPResponse::StatusCode code);
+
+    socket_t m_socket;
+    sockaddr_in m_address;
+    State m_state;
+
+    HTTPArena m_arena;
+
+    std::vector<std::byte> m_inputBuffer;
+    std::size_t m_received;
+
+    InputState m_inputState;
+    HTTPRequest m_request;
+    HTTPResponse::StatusCode m_requestError;
+    std::size_t m_requestSize;
+    bool m_peerClosed;
+
+    BodyFraming m_bodyFraming;
+    std::size_t m_maxBodySize;
+    std::size_t m_bodyRemaining;
+    std::size_t m_bodyOffset;
+    std::size_t m_bodySize;
+    std::size_t m_bodyTotal;
+    std::size_t m_rawPosition;
+    HTTPChunkedDecoder m_chunkedDecoder;
+    std::unique_ptr<HTTPBodyHandler> m_bodyHandler;
+    bool m_bodyAborted;
+
+    HTTPResponse m_response;
+    std::vector<std::byte> m_outputBuffer;
+    std::size_t m_sent;
+
+    std::vector<std::byte> m_streamBuffer;
+    std::size_t m_streamBegin;
+    std::size_t m_streamSent;
+    bool m_streamFinished;
+    StreamFraming m_streamFraming;
+    bool m_chunkedAllowed;
+
+    bool m_keepAlive;
+    bool m_admitted;
+    std::size_t m_requestsCount;
+
+    HTTPTimerWheel::Timer m_timer;
+    Timeout m_timeout;
+
+    uint64_t m_bytesReceived;
+    uint64_t m_bytesSent;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include "HTTPWorker.hpp"
+
+/**
+ * @brief Worker, that runs edge-triggered
+ * epoll event loop with non blocking sockets.
+ */
+class HTTPEpollWorker : public HTTPWorker
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param server Server, that processes requests.
+     */
+    explicit HTTPEpollWorker(HTTPServer& server);
+
+    /**
+     * @brief Destructor.
+     */
+    ~HTTPEpollWorker() override;
+
+    /**
+     * @brief Method for initializing listening
+     * socket and epoll instance.
+     * @param address Binding address.
+     * @param port Binding port.
+     * @param options Listening socket options.
+     * @return Initializing success.
+     */
+    bool initialize(uint32_t address, uint16_t port, const HTTPServerOptions& options) override;
+
+    /**
+     * @brief Event loop execution method.
+     */
+    void exec() override;
+
+private:
+
+    /**
+     * @brief Method for accepting batch of pending
+     * connections and registering them in event loop.
+     * @return False on fatal accept error.
+     */
+    bool acceptConnections();
+
+    /**
+     * @brief Method for enabling or disabling
+     * readiness events of listening socket.
+     * @param enabled Are events enabled.
+     * @return False on fatal error.
+     */
+    bool setAcceptEnabled(bool enabled);
+
+    /**
+     * @brief Method for moving connection state
+     * machine as far as possible without blocking.
+     * Connection may be destroyed after this call.
+     * @param connection Connection.
+     */
+    void proceedConnection(HTTPConnection& connection);
+
+    /**
+     * @brief Method for processing connections,
+     * which timers are expired.
+     * @param now Current time.
+     */
+    void proceedTimeouts(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Method for closing and destroying
+     * connection. Connection reference is invalid
+     * after this call.
+     * @param connection Connection.
+     */
+    void closeConnection(HTTPConnection& connection);
+
+    /**
+     * @brief Method for closing listening socket.
+     */
+    void closeSocket();
+
+    socket_t m_recvSocket;
+    int m_epoll;
+
+    std::size_t m_acceptBatchSize;
+    bool m_acceptPaused;
+    std::chrono::steady_clock::time_point m_nextTick;
+
+    std::unordered_map<
+        socket_t,
+        std::unique_ptr<HTTPConnection>
+    > m_connections;
+};
+
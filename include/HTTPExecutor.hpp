@@ -0,0 +1,199 @@
+#pragma once
+
+#include <mutex>
+#include <queue>
+#include <chrono>
+#include <vector>
+#include <functional>
+#include <coroutine>
+
+/**
+ * @brief Event loop part of worker, that runs
+ * functions and resumes coroutines on worker
+ * thread. Every worker owns executor, and it's
+ * available to request handler with `current`.
+ * Executor is woken with eventfd and timerfd,
+ * that are watched by worker event loop.
+ */
+class HTTPExecutor
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Awaiter, that resumes coroutine
+     * on executor thread.
+     */
+    class ScheduleAwaiter
+    {
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param executor Executor.
+         */
+        explicit ScheduleAwaiter(HTTPExecutor& executor);
+
+        bool await_ready() const noexcept;
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() const noexcept;
+
+    private:
+        HTTPExecutor& m_executor;
+    };
+
+    /**
+     * @brief Awaiter, that resumes coroutine
+     * after deadline is reached.
+     */
+    class SleepAwaiter
+    {
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param executor Executor.
+         * @param deadline Resuming time.
+         */
+        SleepAwaiter(HTTPExecutor& executor, Clock::time_point deadline);
+
+        bool await_ready() const noexcept;
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() const noexcept;
+
+    private:
+        HTTPExecutor& m_executor;
+        Clock::time_point m_deadline;
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    HTTPExecutor();
+
+    /**
+     * @brief Destructor.
+     */
+    ~HTTPExecutor();
+
+    HTTPExecutor(const HTTPExecutor&) = delete;
+    HTTPExecutor& operator=(const HTTPExecutor&) = delete;
+
+    /**
+     * @brief Method for getting executor of
+     * calling worker thread.
+     * @return Executor or nullptr, if it's called
+     * not from worker thread.
+     */
+    static HTTPExecutor* current();
+
+    /**
+     * @brief Method for creating wakeup descriptors.
+     * @return Initializing success.
+     */
+    bool initialize();
+
+    /**
+     * @brief Method for making executor current
+     * for calling thread. It's called by worker
+     * before event loop is started.
+     */
+    void attach();
+
+    /**
+     * @brief Method for getting descriptor, that
+     * becomes readable, when function is posted.
+     * @return eventfd descriptor.
+     */
+    int postDescriptor() const;
+
+    /**
+     * @brief Method for getting descriptor, that
+     * becomes readable, when nearest timer expires.
+     * @return timerfd descriptor.
+     */
+    int timerDescriptor() const;
+
+    /**
+     * @brief Method for running function on
+     * executor thread. Thread safe.
+     * @param function Function.
+     */
+    void post(std::function<void()> function);
+
+    /**
+     * @brief Method for moving awaiting coroutine
+     * to executor thread. Thread safe. It's used
+     * by coroutines, that were resumed by other
+     * threads.
+     * Example: `co_await executor.schedule();`
+     * @return Awaiter.
+     */
+    ScheduleAwaiter schedule();
+
+    /**
+     * @brief Method for suspending awaiting
+     * coroutine for some time without blocking
+     * worker. Has to be awaited on executor thread.
+     * Example: `co_await executor.sleep(100ms);`
+     * @param duration Duration.
+     * @return Awaiter.
+     */
+    SleepAwaiter sleep(Clock::duration duration);
+
+    /**
+     * @brief Method for running posted functions
+     * and resuming coroutines with expired timers.
+     * It's called by worker, when any of executor
+     * descriptors is readable.
+     */
+    void proceed();
+
+private:
+
+    /**
+     * @brief Suspended coroutine with it's
+     * resuming time.
+     */
+    struct Timer
+    {
+        Clock::time_point deadline;
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Timer& timer) const
+        {
+            return deadline > timer.deadline;
+        }
+    };
+
+    /**
+     * @brief Method for adding timer.
+     * @param deadline Resuming time.
+     * @param handle Coroutine.
+     */
+    void addTimer(Clock::time_point deadline, std::coroutine_handle<> handle);
+
+    /**
+     * @brief Method for arming timerfd with
+     * nearest deadline or disarming it.
+     */
+    void armTimer();
+
+    int m_postDescriptor;
+    int m_timerDescriptor;
+
+    std::mutex m_postedMutex;
+    std::vector<std::function<void()>> m_posted;
+    std::vector<std::function<void()>> m_running;
+
+    std::priority_queue<
+        Timer,
+        std::vector<Timer>,
+        std::greater<Timer>
+    > m_timers;
+};
@@ -3,7 +3,9 @@
 #include <vector>
 #include <string>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 
 /**
  * @brief Container for HTTP header.
@@ -14,19 +16,92 @@ public:
 
     using HeaderType = std::pair<std::string_view, std::string_view>;
 
-    using HeadersContainer = std::vector<HeaderType>;
+    using HeadersContainer = std::pmr::vector<HeaderType>;
 
+    /**
+     * @brief Well-known field names. Names are
+     * interned at adding of field, so search of
+     * these fields compares integers only.
+     */
+    enum class Token : uint8_t
+    {
+          Unknown
+        , Accept
+        , AcceptCharset
+        , AcceptEncoding
+        , AcceptLanguage
+        , AcceptRanges
+        , Age
+        , Allow
+        , Authorization
+        , CacheControl
+        , Connection
+        , ContentDisposition
+        , ContentEncoding
+        , ContentLanguage
+        , ContentLength
+        , ContentLocation
+        , ContentRange
+        , ContentType
+        , Cookie
+        , Date
+        , DNT
+        , ETag
+        , Expect
+        , Expires
+        , Forwarded
+        , From
+        , Host
+        , IfMatch
+        , IfModifiedSince
+        , IfNoneMatch
+        , IfRange
+        , IfUnmodifiedSince
+        , KeepAlive
+        , LastModified
+        , Location
+        , Origin
+        , Pragma
+        , Range
+        , Referer
+        , RetryAfter
+        , SecFetchDest
+        , SecFetchMode
+        , SecFetchSite
+        , SecFetchUser
+        , Server
+        , SetCookie
+        , TE
+        , Trailer
+        , TransferEncoding
+        , Upgrade
+        , UpgradeInsecureRequests
+        , UserAgent
+        , Vary
+        , Via
+        , WWWAuthenticate
+        , XForwardedFor
+        , XRequestedWith
+    };
 
     /**
      * @brief Constructor.
+     * @param resource Memory resource of headers.
      */
-    HTTPHeader();
+    explicit HTTPHeader(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Destructor.
      */
     ~HTTPHeader() = default;
 
+    /**
+     * @brief Method for getting memory resource,
+     * headers are allocated from.
+     * @return Memory resource.
+     */
+    std::pmr::memory_resource* memoryResource() const;
+
     /**
      * @brief Method for getting number of
      * headers.
@@ -43,11 +118,55 @@ public:
 
     /**
      * @brief Method for getting header reference by index.
+     * Name must not be changed with this reference,
+     * because token of field is not updated.
      * @param index Header index.
      * @return Reference to header.
      */
     HeaderType& header(HeadersContainer::size_type index);
 
+    /**
+     * @brief Method for getting token of
+     * field name by index.
+     * @param index Header index.
+     * @return Token or `Token::Unknown`.
+     */
+    Token token(HeadersContainer::size_type index) const;
+
+    /**
+     * @brief Method for searching first field
+     * with case insensitive name.
+     * @param name Field name.
+     * @return Pointer to field or nullptr.
+     */
+    const HeaderType* find(std::string_view name) const;
+
+    /**
+     * @brief Method for searching first field
+     * with well-known name.
+     * @param token Token of name.
+     * @return Pointer to field or nullptr.
+     */
+    const HeaderType* find(Token token) const;
+
+    /**
+     * @brief Method for getting value of first
+     * field with case insensitive name.
+     * @param name Field name.
+     * @param defaultValue Value, if field is not found.
+     * @return Field value.
+     */
+    std::string_view get(std::string_view name, std::string_view defaultValue = {}) const;
+
+    /**
+     * @brief Method for getting value of first
+     * field with well-known name.
+     * @param token Token of name.
+     * @param defaultValue Value, if field is not found.
+     * @return Field value.
+     */
+    std::string_view get(Token token, std::string_view defaultValue = {}) const;
+
     /**
      * @brief Method for adding new header to request.
      * @param header Header.
@@ -72,6 +191,13 @@ public:
      */
     void clear();
 
+    /**
+     * @brief Method for reserving space for
+     * headers, to avoid reallocations.
+     * @param count Expected number of headers.
+     */
+    void reserve(HeadersContainer::size_type count);
+
     /**
      * @brief Method for parsing bytes.
      * Bytes has to be actual until object
@@ -95,11 +221,41 @@ public:
      * buffer. Buffer size has to be >= than
      * size calculated by `HTTPRequest::calculateSerializedSize`.
      * @param buffer Pointer to buffer.
+     * @return Pointer to byte after serialized header.
+     */
+    std::byte* serialize(std::byte* buffer) const;
+
+    /**
+     * @brief Method for getting token of name.
+     * Well-known names are found with perfect
+     * hash, built at compile time.
+     * @param name Field name in any case.
+     * @return Token or `Token::Unknown`.
+     */
+    static Token tokenize(std::string_view name);
+
+    /**
+     * @brief Method for getting canonical
+     * name of token.
+     * @param token Token.
+     * @return Name or empty string for
+     * `Token::Unknown`.
+     */
+    static std::string_view tokenName(Token token);
+
+    /**
+     * @brief Method for case insensitive
+     * comparison of ASCII strings, as field
+     * names are compared.
+     * @param a First string.
+     * @param b Second string.
+     * @return Are strings equal.
      */
-    void serialize(std::byte* buffer);
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b);
 
 private:
 
     HeadersContainer m_headers;
+    std::pmr::vector<Token> m_tokens;
 };
 
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <condition_variable>
+#include <netinet/in.h>
+
+/**
+ * @brief Asynchronous log of request path. Calling
+ * thread only copies arguments into binary record
+ * of own lock-free ring buffer. Records are formatted
+ * and written by background thread, so request
+ * processing never waits for log I/O. If ring is
+ * full, record is dropped and counted.
+ *
+ * Every log site is static `HTTPLog::Site` with
+ * sampling and rate limit, that are applied per
+ * thread before record is written. Skipped records
+ * are reported with next written record of site.
+ *
+ * Example:
+ * ```
+ * static HTTPLog::Site RequestSite{HTTPLog::Level::Info, "Requested \"{}\" by {}.", 1, 100};
+ *
+ * HTTPLog::write(RequestSite, uri, connection.address());
+ * ```
+ */
+class HTTPLog
+{
+public:
+
+    /**
+     * @brief Record levels.
+     */
+    enum class Level
+    {
+          Info
+        , Warning
+        , Error
+    };
+
+    /**
+     * @brief Log site.
+     */
+    struct Site
+    {
+        /**
+         * @brief Constructor.
+         * @param level Level of records.
+         * @param format Format with "{}" placeholders,
+         * that are replaced by arguments.
+         * @param sampling Only every n-th record is
+         * written. 1 disables sampling.
+         * @param rateLimit Maximum number of records per
+         * second of every thread. 0 disables limit.
+         */
+        Site(Level level, const char* format, uint32_t sampling = 1, uint32_t rateLimit = 0);
+
+        Level level;
+        const char* format;
+        uint32_t sampling;
+        uint32_t rateLimit;
+
+        /**
+         * @brief Index of site state in thread buffers.
+         */
+        std::size_t index;
+    };
+
+    /**
+     * @brief Function, that receives formatted records.
+     */
+    using SinkFunction = std::function<void(Level, std::string_view)>;
+
+    /**
+     * @brief Size of single record in ring buffer.
+     */
+    static constexpr std::size_t RecordSize = 256;
+
+    /**
+     * @brief Number of records in ring buffer
+     * of every thread.
+     */
+    static constexpr std::size_t RingCapacity = 1024;
+
+    /**
+     * @brief Function for writing record. Arguments
+     * may be integers, strings and `sockaddr_in`.
+     * Strings are truncated, if record is full.
+     * @param site Log site.
+     * @param arguments Arguments.
+     */
+    template<typename... Arguments>
+    static void write(const Site& site, const Arguments&... arguments)
+    {
+        auto* record = instance().beginRecord(site);
+
+        if (record == nullptr)
+        {
+            return;
+        }
+
+        (append(*record, arguments), ...);
+
+        instance().commitRecord();
+    }
+
+    /**
+     * @brief Function for setting sink of formatted
+     * records. By default records are passed to
+     * current logger.
+     * @param sink Sink function or nullptr for
+     * default sink.
+     */
+    static void setSink(SinkFunction sink);
+
+    /**
+     * @brief Function for formatting and writing all
+     * records, that were written before call.
+     */
+    static void flush();
+
+    /**
+     * @brief Function for getting number of records,
+     * that were dropped, because ring buffer was full.
+     * @return Number of records.
+     */
+    static uint64_t droppedCount();
+
+private:
+
+    /**
+     * @brief Argument types of binary record.
+     */
+    enum class ArgumentType : uint8_t
+    {
+          Signed
+        , Unsigned
+        , String
+        , Address
+    };
+
+    /**
+     * @brief Binary record.
+     */
+    struct Record
+    {
+        const Site* site;
+
+        /**
+         * @brief Number of records of site, skipped
+         * by sampling and rate limit before this one.
+         */
+        uint32_t skipped;
+        uint32_t size;
+
+        std::array<char, RecordSize - sizeof(const Site*) - 2 * sizeof(uint32_t)> data;
+    };
+
+    static_assert(sizeof(Record) == RecordSize);
+
+    /**
+     * @brief State of site in single thread.
+     */
+    struct SiteState
+    {
+        uint64_t count = 0;
+        uint32_t skipped = 0;
+        uint32_t windowCount = 0;
+        std::chrono::steady_clock::time_point windowStart;
+    };
+
+    /**
+     * @brief Single producer single consumer ring
+     * buffer of thread.
+     */
+    struct Ring
+    {
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+
+        /**
+         * @brief Thread has finished, ring is
+         * removed after it's drained.
+         */
+        std::atomic<bool> closed{false};
+
+        std::array<Record, RingCapacity> records;
+
+        /**
+         * @brief Site states, owned by producer.
+         */
+        std::vector<SiteState> sites;
+    };
+
+    /**
+     * @brief Owner of thread ring, that closes
+     * it, when thread is finished.
+     */
+    struct RingHolder
+    {
+        ~RingHolder();
+
+        std::shared_ptr<Ring> ring;
+    };
+
+    HTTPLog();
+
+    ~HTTPLog();
+
+    static HTTPLog& instance();
+
+    /**
+     * @brief Method for applying sampling and rate
+     * limit and getting free record of thread ring.
+     * @param site Log site.
+     * @return Record or nullptr, if record is skipped.
+     */
+    Record* beginRecord(const Site& site);
+
+    /**
+     * @brief Method for publishing record, that was
+     * returned by `beginRecord`.
+     */
+    void commitRecord();
+
+    /**
+     * @brief Method for getting ring of calling thread.
+     * @return Ring.
+     */
+    Ring& threadRing();
+
+    /**
+     * @brief Method of background thread.
+     */
+    void run();
+
+    /**
+     * @brief Method for formatting and writing
+     * published records of all rings.
+     * @return Number of written records.
+     */
+    std::size_t drain();
+
+    /**
+     * @brief Method for formatting record.
+     * @param record Record.
+     * @param output Output text.
+     */
+    static void format(const Record& record, std::string& output);
+
+    /**
+     * @brief Function for appending argument bytes.
+     * If record is full, argument is truncated.
+     * @param record Record.
+     * @param type Argument type.
+     * @param data Argument bytes.
+     * @param size Argument size.
+     */
+    static void appendBytes(Record& record, ArgumentType type, const void* data, std::size_t size);
+
+    template<typename T>
+    static void append(Record& record, const T& value)
+    {
+        if constexpr (std::is_same_v<T, sockaddr_in>)
+        {
+            appendBytes(record, ArgumentType::Address, &value, sizeof(value));
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            auto converted = static_cast<int64_t>(value);
+            appendBytes(record, ArgumentType::Signed, &converted, sizeof(converted));
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            auto converted = static_cast<uint64_t>(value);
+            appendBytes(record, ArgumentType::Unsigned, &converted, sizeof(converted));
+        }
+        else
+        {
+            std::string_view string(value);
+            appendBytes(record, ArgumentType::String, string.data(), string.size());
+        }
+    }
+
+    static std::atomic<std::size_t> s_sitesCount;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    std::vector<std::shared_ptr<Ring>> m_rings;
+    SinkFunction m_sink;
+
+    std::mutex m_drainMutex;
+    std::atomic<uint64_t> m_dropped;
+    uint64_t m_reportedDropped;
+
+    bool m_stopping;
+    std::thread m_thread;
+};
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include "HTTPRequest.hpp"
+#include "HTTPResponse.hpp"
+
+/**
+ * @brief Server metrics in Prometheus text format.
+ * Every worker writes only own shard, so counters
+ * are updated without locked instructions and
+ * shared cache lines. Shards are summed, when
+ * metrics are serialized.
+ *
+ * Routes are labels of requests and handler
+ * duration histograms. They are registered before
+ * `HTTPServer::exec` and set by handler with
+ * `setRoute`, so number of series doesn't depend
+ * on requested URIs. Route 0 is unnamed route of
+ * requests, handler didn't set route for.
+ */
+class HTTPMetrics
+{
+public:
+
+    /**
+     * @brief Number of request methods.
+     */
+    static constexpr std::size_t MethodsCount =
+        static_cast<std::size_t>(HTTPRequest::Method::CONNECT) + 1;
+
+    /**
+     * @brief Range of counted status codes. Other
+     * codes are counted as 0.
+     */
+    static constexpr std::size_t StatusCodesCount = 600;
+
+    /**
+     * @brief HDR-style latency histogram. Values are
+     * counted with 4 buckets per power of two, so
+     * bucket width is 25% of it's value from 1 us
+     * to 68 s.
+     */
+    class Histogram
+    {
+    public:
+
+        static constexpr unsigned SubBucketBits = 2;
+        static constexpr unsigned MinMagnitude = 10;
+        static constexpr unsigned MaxMagnitude = 36;
+
+        /**
+         * @brief Number of buckets: one below minimal
+         * magnitude, sub buckets of every magnitude and
+         * one for values over maximal magnitude.
+         */
+        static constexpr std::size_t BucketsCount =
+            (MaxMagnitude - MinMagnitude) * (1u << SubBucketBits) + 2;
+
+        /**
+         * @brief Method for recording value. Only
+         * owning thread may record values.
+         * @param value Value in nanoseconds.
+         */
+        void record(uint64_t value);
+
+        /**
+         * @brief Function for getting bucket of value.
+         * @param value Value in nanoseconds.
+         * @return Bucket index.
+         */
+        static std::size_t index(uint64_t value);
+
+        /**
+         * @brief Function for getting exclusive upper
+         * bound of bucket. Last bucket is unbounded.
+         * @param index Bucket index.
+         * @return Bound in nanoseconds.
+         */
+        static uint64_t upperBound(std::size_t index);
+
+        std::array<std::atomic<uint64_t>, BucketsCount> buckets{};
+        std::atomic<uint64_t> sum{0};
+    };
+
+    /**
+     * @brief Metrics of single worker.
+     */
+    struct alignas(64) Shard
+    {
+        /**
+         * @brief Constructor.
+         * @param routesCount Number of routes.
+         */
+        explicit Shard(std::size_t routesCount);
+
+        std::size_t routesCount;
+
+        std::atomic<uint64_t> connections{0};
+        std::atomic<uint64_t> bytesReceived{0};
+        std::atomic<uint64_t> bytesSent{0};
+
+        std::array<std::atomic<uint64_t>, StatusCodesCount> statusCodes{};
+
+        /**
+         * @brief Requests, indexed by route and method.
+         */
+        std::unique_ptr<std::atomic<uint64_t>[]> requests;
+
+        /**
+         * @brief Handler durations, indexed by route.
+         */
+        std::unique_ptr<Histogram[]> durations;
+
+        /**
+         * @brief Method for recording handled request.
+         * @param method Request method.
+         * @param route Route index.
+         * @param duration Handler duration.
+         * @param code Response status code.
+         */
+        void recordRequest(HTTPRequest::Method method,
+                           std::size_t route,
+                           std::chrono::nanoseconds duration,
+                           HTTPResponse::StatusCode code);
+
+        /**
+         * @brief Method for recording response
+         * without handler, like errors of parsing.
+         * @param code Response status code.
+         */
+        void recordStatus(HTTPResponse::StatusCode code);
+
+        /**
+         * @brief Method for recording connection traffic.
+         * @param received Received bytes.
+         * @param sent Sent bytes.
+         */
+        void recordTraffic(uint64_t received, uint64_t sent);
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    HTTPMetrics();
+
+    /**
+     * @brief Method for registering route. It has to
+     * be called before workers are started.
+     * @param name Route name, usually path pattern.
+     * @return Route index. Same name gets same index.
+     */
+    std::size_t addRoute(std::string_view name);
+
+    /**
+     * @brief Method for creating shard of worker.
+     * @return Shard. It's valid while metrics exist.
+     */
+    Shard& createShard();
+
+    /**
+     * @brief Method for summing shards into
+     * Prometheus text exposition format.
+     * @return Metrics text.
+     */
+    std::string serialize() const;
+
+    /**
+     * @brief Function for setting route of request,
+     * handled by calling thread. Handler has to call
+     * it before it's suspended.
+     * @param route Route index from `addRoute`.
+     */
+    static void setRoute(std::size_t route);
+
+    /**
+     * @brief Function for getting route, set by
+     * handler, and resetting it to unnamed.
+     * @return Route index.
+     */
+    static std::size_t takeRoute();
+
+    /**
+     * @brief Function for incrementing counter,
+     * that is written by single thread. Plain load
+     * and store are used instead of `fetch_add`,
+     * readers only need to see atomic values.
+     * @param counter Counter.
+     * @param value Increment.
+     */
+    static void add(std::atomic<uint64_t>& counter, uint64_t value = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+private:
+    mutable std::mutex m_mutex;
+
+    std::vector<std::string> m_routes;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
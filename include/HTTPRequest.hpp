@@ -1,7 +1,9 @@
 #pragma once
 
 
+#include <vector>
 #include <string_view>
+#include <memory_resource>
 #include "HTTPHeader.hpp"
 
 /**
@@ -33,10 +35,32 @@ public:
         , CONNECT
     };
 
+    /**
+     * @brief Incremental parsing status.
+     */
+    enum class ParseStatus
+    {
+          Incomplete
+        , Complete
+        , Error
+    };
+
     /**
      * @brief Constructor.
+     * @param resource Memory resource of parsed
+     * headers. Server passes arena of connection,
+     * that is reset after response is sent.
+     */
+    explicit HTTPRequest(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Method for getting memory resource
+     * of request. Handler may allocate response
+     * and temporary objects from it.
+     * Example: `HTTPResponse response(request.memoryResource());`
+     * @return Memory resource.
      */
-    HTTPRequest();
+    std::pmr::memory_resource* memoryResource() const;
 
     /**
      * @brief Method for getting pointer to data.
@@ -50,6 +74,13 @@ public:
      */
     std::size_t dataSize() const;
 
+    /**
+     * @brief Method for setting pointer to data.
+     * @param data Pointer to data.
+     * @param size Data size in bytes.
+     */
+    void setData(std::byte* data, std::size_t size);
+
     /**
      * @brief Method for getting
      * reference to request method.
@@ -111,7 +142,7 @@ public:
      * @brief Method for getting header.
      * @return Header.
      */
-    HTTPHeader header() const;
+    const HTTPHeader& header() const;
 
     /**
      * @brief Method for getting header reference.
@@ -136,6 +167,37 @@ public:
      */
     bool parse(std::byte* bytes, std::size_t size);
 
+    /**
+     * @brief Method for resumable parsing. Has to be
+     * called each time new bytes are received. Bytes
+     * before already parsed position are not scanned
+     * again. Buffer may be reallocated between calls,
+     * as parser keeps offsets instead of pointers.
+     * On `Complete` request fields are pointing into
+     * bytes, that has to be actual until object
+     * instance exists. If buffer was reallocated after
+     * completion, calling this method again updates
+     * fields to new buffer.
+     * @param bytes Pointer to all received bytes.
+     * @param size Number of received bytes.
+     * @return Parsing status.
+     */
+    ParseStatus parsePartial(std::byte* bytes, std::size_t size);
+
+    /**
+     * @brief Method for resetting parser state
+     * before parsing new request.
+     */
+    void resetParser();
+
+    /**
+     * @brief Method for getting size of parsed
+     * request line and headers, including
+     * terminating empty line.
+     * @return Size in bytes.
+     */
+    std::size_t headerSize() const;
+
     /**
      * @brief Static method for parsing
      * string to method. If parsing was
@@ -156,6 +218,54 @@ public:
 
 
 private:
+
+    /**
+     * @brief Incremental parser state.
+     */
+    enum class ParseState
+    {
+          RequestLine
+        , Headers
+        , Finished
+    };
+
+    /**
+     * @brief Offset and size of token in
+     * parsed bytes.
+     */
+    struct Range
+    {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    /**
+     * @brief Method for parsing request line.
+     * @param bytes Pointer to bytes.
+     * @param line Line range without line break.
+     * @return Parsing success.
+     */
+    bool parseRequestLine(std::byte* bytes, Range line);
+
+    /**
+     * @brief Method for parsing header line.
+     * @param bytes Pointer to bytes.
+     * @param line Line range without line break.
+     * @param colon Pointer to first colon of
+     * line or nullptr.
+     * @return Parsing success.
+     */
+    bool parseHeaderLine(std::byte* bytes, Range line, const std::byte* colon);
+
+    /**
+     * @brief Method for creating fields from
+     * parsed ranges. Fields are not recreated,
+     * if bytes were not moved since last call.
+     * @param bytes Pointer to bytes.
+     * @param size Size of bytes.
+     */
+    void commitParsed(std::byte* bytes, std::size_t size);
+
     Method m_method;
 
     std::string_view m_uri;
@@ -165,5 +275,20 @@ private:
 
     std::byte* m_data;
     std::size_t m_dataSize;
+
+    ParseState m_parseState;
+    std::size_t m_lineStart;
+    std::size_t m_scanPosition;
+    std::size_t m_headerSize;
+
+    Method m_parsedMethod;
+    Range m_uriRange;
+    Range m_versionRange;
+    std::pmr::vector<std::pair<Range, Range>> m_headerRanges;
+
+    static constexpr std::size_t ExpectedHeadersCount = 32;
+
+    std::byte* m_committedBytes;
+    std::size_t m_committedSize;
 };
 
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <string_view>
+#include <memory_resource>
 #include "HTTPHeader.hpp"
+#include "HTTPBodyStream.hpp"
 
 /**
  * @brief Class, that describes http response.
@@ -119,8 +123,17 @@ public:
 
     /**
      * @brief Constructor.
+     * @param resource Memory resource of header
+     * and data, set with `std::pmr::string`.
      */
-    HTTPResponse();
+    explicit HTTPResponse(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Method for getting memory resource
+     * of response.
+     * @return Memory resource.
+     */
+    std::pmr::memory_resource* memoryResource() const;
 
     /**
      * @brief Method for getting response status
@@ -151,7 +164,7 @@ public:
      * @brief Method for getting header.
      * @return Header.
      */
-    HTTPHeader header() const;
+    const HTTPHeader& header() const;
 
     /**
      * @brief Method for getting header reference.
@@ -173,11 +186,114 @@ public:
 
     /**
      * @brief Method for setting pointer to data.
+     * Data is not copied, so it has to be valid
+     * until response is sent.
      * @param data Pointer to data.
      * @param size Data size in bytes.
      */
     void setData(std::byte* data, std::size_t size);
 
+    /**
+     * @brief Method for setting data, owned by
+     * response. Data is kept alive until response
+     * is sent.
+     * @param data Data.
+     */
+    void setData(std::string data);
+
+    /**
+     * @brief Method for setting data, owned by
+     * response. It's used for data, allocated
+     * from arena of request.
+     * @param data Data.
+     */
+    void setData(std::pmr::string data);
+
+    /**
+     * @brief Method for setting copy of string
+     * as data. Copy is allocated from memory
+     * resource of response.
+     * @param data Null terminated string.
+     */
+    void setData(const char* data);
+
+    /**
+     * @brief Method for setting file as response
+     * data. File is sent with `sendfile` and never
+     * copied through user space. Response takes
+     * ownership of descriptor and closes it, when
+     * last copy of response is destroyed.
+     * @param descriptor Opened file descriptor.
+     * @param offset Offset of data in file.
+     * @param size Data size in bytes.
+     */
+    void setFile(int descriptor, std::size_t offset, std::size_t size);
+
+    /**
+     * @brief Method for getting file descriptor,
+     * set by `setFile`.
+     * @return File descriptor or -1, if response
+     * has no file.
+     */
+    int fileDescriptor() const;
+
+    /**
+     * @brief Method for getting offset of data
+     * in file.
+     * @return Offset in bytes.
+     */
+    std::size_t fileOffset() const;
+
+    /**
+     * @brief Method for getting size of file data.
+     * @return Size in bytes.
+     */
+    std::size_t fileSize() const;
+
+    /**
+     * @brief Method for setting stream as response
+     * data. Body is written by stream in parts,
+     * while it's sent. Stream is shared between
+     * response copies.
+     * @param stream Body stream.
+     */
+    void setStream(std::shared_ptr<HTTPBodyStream> stream);
+
+    /**
+     * @brief Method for getting body stream,
+     * set by `setStream`.
+     * @return Pointer to stream or nullptr, if
+     * response has no stream.
+     */
+    HTTPBodyStream* stream() const;
+
+    /**
+     * @brief Method for getting size of response
+     * body. It's size of file data if response
+     * has file, or size of data otherwise. Size
+     * of streamed body is unknown, so it's 0.
+     * @return Size in bytes.
+     */
+    std::size_t contentLength() const;
+
+    /**
+     * @brief Method for calculation serialized
+     * size of status line and header, without data.
+     * @return Size of serialized head in bytes.
+     */
+    std::size_t calculateHeadSize() const;
+
+    /**
+     * @brief Method for serializing status line
+     * and header into buffer. Data is not copied,
+     * so it can be sent from it's own buffer.
+     * Buffer has to be >= than size, calculated
+     * by `HTTPResponse::calculateHeadSize`.
+     * @param buffer Pointer to buffer.
+     * @return Pointer to byte after serialized head.
+     */
+    std::byte* serializeHead(std::byte* buffer);
+
     /**
      * @brief Method for calculation serialized
      * size.
@@ -187,7 +303,7 @@ public:
 
     /**
      * @brief Method for serializing data into
-     * byffer. Buffer has to be >= than
+     * byffer. File data is not serialized. Buffer has to be >= than
      * size, calculated by `HTTPResponse::calculateSerializedSize`.
      * @param buffer Pointer to buffer.
      */
@@ -205,5 +321,38 @@ private:
 
     std::byte* m_data;
     std::size_t m_dataSize;
+
+    /**
+     * @brief Storage of response data.
+     */
+    enum class DataStorage
+    {
+          Pointer
+        , String
+        , ResourceString
+    };
+
+    DataStorage m_dataStorage;
+    std::string m_ownedData;
+    std::pmr::string m_resourceData;
+
+    /**
+     * @brief Owner of file descriptor, that is
+     * shared between response copies.
+     */
+    struct File
+    {
+        explicit File(int descriptor);
+
+        ~File();
+
+        int descriptor;
+    };
+
+    std::shared_ptr<const File> m_file;
+    std::size_t m_fileOffset;
+    std::size_t m_fileSize;
+
+    std::shared_ptr<HTTPBodyStream> m_stream;
 };
 
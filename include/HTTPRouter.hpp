@@ -0,0 +1,375 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include "HTTPRequest.hpp"
+
+/**
+ * @brief Compressed radix tree of routes. Route
+ * pattern may contain parameters:
+ * - `:name` matches one path segment.
+ * - `*name` matches rest of path and has to be last.
+ *
+ * Static text has priority over parameter, and
+ * parameter has priority over wildcard. Every node
+ * keeps values in array, indexed by method. Lookup
+ * does not allocate memory.
+ *
+ * Example:
+ * ```
+ * HTTPRouter<int> router;
+ * router.add(HTTPRequest::Method::GET, "/users/:id", 1);
+ * router.add(HTTPRequest::Method::GET, "/files/" "*path", 2);
+ *
+ * auto match = router.find(HTTPRequest::Method::GET, "/users/42");
+ * // *match.value == 1, match.parameters[0] == {"id", "42"}
+ * ```
+ * @tparam Value Type of route value.
+ */
+template<typename Value>
+class HTTPRouter
+{
+public:
+
+    /**
+     * @brief Maximum number of parameters in
+     * single route.
+     */
+    static constexpr std::size_t MaxParameters = 8;
+
+    /**
+     * @brief Number of request methods.
+     */
+    static constexpr std::size_t MethodsCount =
+        static_cast<std::size_t>(HTTPRequest::Method::CONNECT) + 1;
+
+    /**
+     * @brief Path parameter. Both name and value
+     * point to router and path respectively.
+     */
+    struct Parameter
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    /**
+     * @brief Result of lookup.
+     */
+    struct Match
+    {
+        /**
+         * @brief Value for method or nullptr, if
+         * route is not found or has no value for
+         * method.
+         */
+        const Value* value = nullptr;
+
+        /**
+         * @brief Is any route found for path.
+         * If it's true and value is nullptr,
+         * method is not allowed.
+         */
+        bool pathFound = false;
+
+        std::array<Parameter, MaxParameters> parameters{};
+        std::size_t parametersCount = 0;
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    HTTPRouter() :
+        m_root(std::make_unique<Node>())
+    {
+
+    }
+
+    /**
+     * @brief Method for adding route. Value of
+     * same method and pattern is replaced.
+     * Throws `std::invalid_argument` if pattern
+     * is malformed or conflicts with other route.
+     * @param method Request method.
+     * @param pattern Route pattern.
+     * @param value Value.
+     */
+    void add(HTTPRequest::Method method, std::string_view pattern, Value value)
+    {
+        auto methodIndex = static_cast<std::size_t>(method);
+
+        if (method == HTTPRequest::Method::None ||
+            methodIndex >= MethodsCount)
+        {
+            throw std::invalid_argument("Unknown method of route.");
+        }
+
+        auto* node = m_root.get();
+        std::size_t parameters = 0;
+
+        while (!pattern.empty())
+        {
+            if (pattern.front() == ':' || pattern.front() == '*')
+            {
+                if (++parameters > MaxParameters)
+                {
+                    throw std::invalid_argument("Too many parameters in route.");
+                }
+
+                node = insertParameter(node, pattern);
+            }
+            else
+            {
+                node = insertStatic(node, pattern);
+            }
+        }
+
+        node->values[methodIndex] = std::move(value);
+        node->hasValues = true;
+    }
+
+    /**
+     * @brief Method for searching route.
+     * @param method Request method.
+     * @param path Path without query.
+     * @return Match. Parameters point to path.
+     */
+    Match find(HTTPRequest::Method method, std::string_view path) const
+    {
+        Match match;
+
+        auto* node = findNode(m_root.get(), path, match);
+
+        if (node == nullptr)
+        {
+            match.parametersCount = 0;
+            return match;
+        }
+
+        match.pathFound = true;
+
+        auto methodIndex = static_cast<std::size_t>(method);
+
+        if (methodIndex < MethodsCount && node->values[methodIndex])
+        {
+            match.value = &*node->values[methodIndex];
+        }
+
+        return match;
+    }
+
+private:
+
+    /**
+     * @brief Node of tree. Static children are
+     * distinguished by first byte of prefix.
+     */
+    struct Node
+    {
+        std::string prefix;
+        std::vector<std::unique_ptr<Node>> children;
+
+        std::string parameterName;
+        std::unique_ptr<Node> parameter;
+
+        std::string wildcardName;
+        std::unique_ptr<Node> wildcard;
+
+        std::array<std::optional<Value>, MethodsCount> values;
+        bool hasValues = false;
+    };
+
+    /**
+     * @brief Method for inserting static text
+     * from beginning of pattern. Nodes are split,
+     * if text matches only part of prefix.
+     * @param node Current node.
+     * @param pattern Rest of pattern. Inserted
+     * part is removed from it.
+     * @return Node after text.
+     */
+    static Node* insertStatic(Node* node, std::string_view& pattern)
+    {
+        auto text = pattern.substr(0, pattern.find_first_of(":*"));
+
+        for (auto&& child : node->children)
+        {
+            if (child->prefix.front() != text.front())
+            {
+                continue;
+            }
+
+            std::size_t common = 0;
+
+            while (common < text.size() &&
+                   common < child->prefix.size() &&
+                   text[common] == child->prefix[common])
+            {
+                ++common;
+            }
+
+            if (common < child->prefix.size())
+            {
+                // Child keeps common part and
+                // gets rest of itself as child
+                auto rest = std::make_unique<Node>();
+
+                rest->prefix = child->prefix.substr(common);
+                rest->children = std::move(child->children);
+                rest->parameterName = std::move(child->parameterName);
+                rest->parameter = std::move(child->parameter);
+                rest->wildcardName = std::move(child->wildcardName);
+                rest->wildcard = std::move(child->wildcard);
+                rest->values = std::move(child->values);
+                rest->hasValues = child->hasValues;
+
+                child->prefix.resize(common);
+                child->children.clear();
+                child->children.push_back(std::move(rest));
+                child->parameterName.clear();
+                child->wildcardName.clear();
+                child->values = {};
+                child->hasValues = false;
+            }
+
+            pattern.remove_prefix(common);
+
+            return child.get();
+        }
+
+        auto child = std::make_unique<Node>();
+        child->prefix = std::string(text);
+
+        node->children.push_back(std::move(child));
+
+        pattern.remove_prefix(text.size());
+
+        return node->children.back().get();
+    }
+
+    /**
+     * @brief Method for inserting parameter or
+     * wildcard from beginning of pattern.
+     * @param node Current node.
+     * @param pattern Rest of pattern. Inserted
+     * part is removed from it.
+     * @return Node after parameter.
+     */
+    static Node* insertParameter(Node* node, std::string_view& pattern)
+    {
+        bool isWildcard = pattern.front() == '*';
+
+        auto end = isWildcard ? pattern.size() : pattern.find('/');
+
+        if (end == std::string_view::npos)
+        {
+            end = pattern.size();
+        }
+
+        auto name = pattern.substr(1, end - 1);
+
+        if (name.empty() ||
+            name.find_first_of(":*") != std::string_view::npos)
+        {
+            throw std::invalid_argument("Wrong parameter name in route.");
+        }
+
+        if (isWildcard && name.find('/') != std::string_view::npos)
+        {
+            throw std::invalid_argument("Wildcard has to be last in route.");
+        }
+
+        auto& child = isWildcard ? node->wildcard : node->parameter;
+        auto& childName = isWildcard ? node->wildcardName : node->parameterName;
+
+        if (!child)
+        {
+            child = std::make_unique<Node>();
+            childName = std::string(name);
+        }
+        else if (childName != name)
+        {
+            throw std::invalid_argument("Parameter name conflicts with other route.");
+        }
+
+        pattern.remove_prefix(end);
+
+        return child.get();
+    }
+
+    /**
+     * @brief Method for searching node with
+     * values for path.
+     * @param node Current node, which prefix
+     * is already matched.
+     * @param path Rest of path.
+     * @param match Match with parameters.
+     * @return Node or nullptr.
+     */
+    static const Node* findNode(const Node* node, std::string_view path, Match& match)
+    {
+        if (path.empty() && node->hasValues)
+        {
+            return node;
+        }
+
+        if (!path.empty())
+        {
+            for (auto&& child : node->children)
+            {
+                if (child->prefix.front() != path.front())
+                {
+                    continue;
+                }
+
+                if (path.substr(0, child->prefix.size()) == child->prefix)
+                {
+                    if (auto* result = findNode(child.get(), path.substr(child->prefix.size()), match))
+                    {
+                        return result;
+                    }
+                }
+
+                // Only one child starts with this byte
+                break;
+            }
+        }
+
+        if (node->parameter && !path.empty() && path.front() != '/')
+        {
+            auto end = path.find('/');
+
+            if (end == std::string_view::npos)
+            {
+                end = path.size();
+            }
+
+            auto count = match.parametersCount;
+
+            match.parameters[match.parametersCount++] = {node->parameterName, path.substr(0, end)};
+
+            if (auto* result = findNode(node->parameter.get(), path.substr(end), match))
+            {
+                return result;
+            }
+
+            match.parametersCount = count;
+        }
+
+        if (node->wildcard && node->wildcard->hasValues)
+        {
+            match.parameters[match.parametersCount++] = {node->wildcardName, path};
+
+            return node->wildcard.get();
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<Node> m_root;
+};
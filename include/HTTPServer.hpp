@@ -1,10 +1,24 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
 #include <cstdint>
-#include <Tools/Network.hpp>
+#include <cstddef>
+#include "Task.hpp"
+#include "HTTPExecutor.hpp"
 #include "HTTPRequest.hpp"
 #include "HTTPResponse.hpp"
+#include "HTTPBodyHandler.hpp"
+#include "HTTPMetrics.hpp"
+#include "HTTPServerOptions.hpp"
 
+/**
+ * @brief HTTP server. Every worker thread runs own
+ * edge-triggered epoll event loop with own listening
+ * socket.
+ */
 class HTTPServer
 {
 public:
@@ -19,12 +33,134 @@ public:
      */
     virtual ~HTTPServer();
 
+    /**
+     * @brief Method for setting number of worker
+     * threads. If more than one worker is used, every
+     * worker binds own socket with `SO_REUSEPORT` and
+     * `proceedRequest` is called concurrently.
+     * @param count Workers count. 0 means number of
+     * hardware threads. Default: 1.
+     */
+    void setWorkersCount(std::size_t count);
+
+    /**
+     * @brief Method for getting number of worker threads.
+     * @return Workers count.
+     */
+    std::size_t workersCount() const;
+
+    /**
+     * @brief Method for setting time, persistent
+     * connection may wait for next request.
+     * @param timeout Timeout. Default: 5 seconds.
+     */
+    void setKeepAliveTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Method for setting time, client may
+     * send request header. It's counted from first
+     * received byte of request and isn't extended
+     * by received data, so slowly sent header
+     * doesn't hold connection. Request is answered
+     * with `RequestTimeout`.
+     * @param timeout Timeout. Default: 10 seconds.
+     */
+    void setHeaderTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Method for setting time, client may
+     * not send request body data. Request is
+     * answered with `RequestTimeout`.
+     * @param timeout Timeout. Default: 30 seconds.
+     */
+    void setBodyTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Method for setting time, client may
+     * not receive response data. Connection is
+     * closed after it.
+     * @param timeout Timeout. Default: 30 seconds.
+     */
+    void setWriteTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Method for setting maximum number of
+     * requests, processed with single connection.
+     * Connection is closed after last response.
+     * @param count Number of requests. Default: 1000.
+     */
+    void setMaxKeepAliveRequests(std::size_t count);
+
+    /**
+     * @brief Method for setting maximum size of
+     * request body, that is buffered for
+     * `proceedRequest`. Streamed bodies are not
+     * limited. Larger requests are answered with
+     * `PayloadTooLarge`.
+     * @param size Size in bytes. Default: 1 MiB.
+     */
+    void setMaxBodySize(std::size_t size);
+
+    /**
+     * @brief Method for setting maximum number of
+     * open connections. Limit is divided between
+     * workers. Connections over limit are answered
+     * with `ServiceUnavailable` and closed, before
+     * request is read.
+     * @param count Number of connections. 0 means
+     * no limit. Default: 0.
+     */
+    void setMaxConnections(std::size_t count);
+
+    /**
+     * @brief Method for setting maximum number of
+     * requests, that are handled or sent at the same
+     * time. Limit is divided between workers. Request
+     * over limit is answered with `ServiceUnavailable`
+     * after it's header is received, without calling
+     * handler, and connection is closed.
+     * @param count Number of requests. 0 means
+     * no limit. Default: 0.
+     */
+    void setMaxInflightRequests(std::size_t count);
+
+    /**
+     * @brief Method for setting `Retry-After` value
+     * of `ServiceUnavailable` responses.
+     * @param delay Delay. Default: 1 second.
+     */
+    void setRetryAfter(std::chrono::seconds delay);
+
+    /**
+     * @brief Method for setting path, server answers
+     * with metrics in Prometheus text format. Requests
+     * to it are not passed to `proceedRequest`.
+     * Metrics are collected only if path is set.
+     * @param path Path, like "/metrics". Empty path
+     * disables metrics. Default: empty.
+     */
+    void setMetricsPath(std::string path);
+
+    /**
+     * @brief Method for getting metrics path.
+     * @return Path or empty string.
+     */
+    const std::string& metricsPath() const;
+
+    /**
+     * @brief Method for getting server metrics.
+     * Routes have to be added before `exec`.
+     * @return Metrics.
+     */
+    HTTPMetrics& metrics();
+
     /**
      * @brief Main execution method.
      * @param address 4 byte ipv4 address.
      * @param port Port.
+     * @param options Listening socket options.
      */
-    void exec(uint32_t address, uint16_t port);
+    void exec(uint32_t address, uint16_t port, const HTTPServerOptions& options = HTTPServerOptions());
 
 protected:
 
@@ -32,32 +168,69 @@ protected:
      * @brief Virtual method for processing
      * http request. By default it's just logging
      * request and returing empty OK response.
+     * Has to be thread safe if more than one
+     * worker is used.
      * @param request Request object.
      * @return Response, that has to be sent to request
      * peer.
      */
     virtual HTTPResponse proceedRequest(HTTPRequest request);
 
-private:
+    /**
+     * @brief Virtual method for processing
+     * http request asynchronously. Handler may
+     * suspend on awaiters of worker executor,
+     * available with `HTTPExecutor::current()`,
+     * so worker serves other connections, while
+     * it's waiting. Request is kept by connection
+     * until response is returned. By default it
+     * calls `proceedRequest` and returns ready task.
+     * Has to be thread safe if more than one
+     * worker is used.
+     * @param request Request object.
+     * @return Task of response, that has to be
+     * sent to request peer.
+     */
+    virtual Task<HTTPResponse> proceedRequestAsync(HTTPRequest& request);
 
     /**
-     * @brief Method for initializing server socket.
-     * @param address Binding address.
-     * @param port Binding port.
-     * @return Initializing success.
+     * @brief Virtual method for creating streaming
+     * body handler. It's called after request header
+     * is received, if request has body. If handler
+     * is returned, body is passed to it in chunks and
+     * it forms response instead of `proceedRequest`.
+     * By default body is buffered whole.
+     * Has to be thread safe if more than one
+     * worker is used.
+     * @param request Request object without data.
+     * @return Body handler or nullptr.
      */
-    bool initializeSocket(uint32_t address, uint16_t port);
+    virtual std::unique_ptr<HTTPBodyHandler> createBodyHandler(const HTTPRequest& request);
+
+private:
+    friend class HTTPWorker;
 
     /**
-     * @brief Method for reading request from client.
-     * @param client Client socket.
-     * @param request Output request object.
-     * @return Reading success.
+     * @brief Method for serializing response of
+     * overloaded server, that is sent as is. It's
+     * prepared, when `Retry-After` value is set.
      */
-    bool readRequest(socket_t client, HTTPRequest& request);
+    void prepareUnavailableResponse();
 
-    socket_t m_recvSocket;
+    std::size_t m_workersCount;
 
-    std::vector<std::byte> m_requestBuffer;
-};
+    std::chrono::milliseconds m_keepAliveTimeout;
+    std::chrono::milliseconds m_headerTimeout;
+    std::chrono::milliseconds m_bodyTimeout;
+    std::chrono::milliseconds m_writeTimeout;
+    std::size_t m_maxKeepAliveRequests;
+    std::size_t m_maxBodySize;
+
+    std::size_t m_maxConnections;
+    std::size_t m_maxInflightRequests;
+    std::chrono::seconds m_retryAfter;
+    std::vector<std::byte> m_unavailableResponse;
 
+    std::string m_metricsPath;
+    HTTPMetrics m_metrics;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <sys/socket.h>
+
+/**
+ * @brief Options of listening sockets. Socket
+ * options of accepted connections are set on
+ * listening socket, so they are inherited
+ * without system calls per connection.
+ */
+struct HTTPServerOptions
+{
+    /**
+     * @brief Length of accept queue. It's
+     * limited by `net.core.somaxconn`.
+     */
+    int backlog = SOMAXCONN;
+
+    /**
+     * @brief Set `SO_REUSEADDR`, so server can be
+     * restarted, while sockets of previous process
+     * are in `TIME_WAIT` state.
+     */
+    bool reuseAddress = true;
+
+    /**
+     * @brief Set `SO_REUSEPORT`. It's always set,
+     * if more than one worker is used.
+     */
+    bool reusePort = false;
+
+    /**
+     * @brief Time `TCP_DEFER_ACCEPT`, while connection
+     * is not accepted until request data arrives.
+     * 0 disables option.
+     */
+    std::chrono::seconds deferAccept = std::chrono::seconds(0);
+
+    /**
+     * @brief Length of `TCP_FASTOPEN` queue.
+     * 0 disables option.
+     */
+    int fastOpenQueue = 0;
+
+    /**
+     * @brief Set `TCP_NODELAY`, so response parts
+     * are not delayed by Nagle's algorithm.
+     */
+    bool noDelay = true;
+
+    /**
+     * @brief Size of `SO_RCVBUF` in bytes.
+     * 0 keeps system default.
+     */
+    int receiveBufferSize = 0;
+
+    /**
+     * @brief Size of `SO_SNDBUF` in bytes.
+     * 0 keeps system default.
+     */
+    int sendBufferSize = 0;
+
+    /**
+     * @brief Maximum number of connections, accepted
+     * on single readiness of listening socket. Rest
+     * are accepted after ready connections are
+     * processed. It's used by epoll worker,
+     * io_uring worker accepts with multishot
+     * accept instead.
+     */
+    std::size_t acceptBatchSize = 64;
+};
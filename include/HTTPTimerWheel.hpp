@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Hierarchical timer wheel for connection
+ * timeouts. Timers are intrusive list nodes, so
+ * arming and cancelling are O(1) without allocations.
+ * Every level has 64 slots, slot of first level is
+ * single tick, slot of every next level is whole
+ * previous level. Timers of upper levels are moved
+ * down, when wheel reaches their slot.
+ *
+ * Wheel is used by single worker thread.
+ */
+class HTTPTimerWheel
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Duration of single tick. Timers are
+     * expired with this precision.
+     */
+    static constexpr auto TickDuration = std::chrono::milliseconds(100);
+
+    static constexpr unsigned SlotBits = 6;
+    static constexpr std::size_t SlotsCount = std::size_t(1) << SlotBits;
+    static constexpr std::size_t LevelsCount = 4;
+
+    /**
+     * @brief Maximum timeout in ticks. Longer
+     * timeouts are shortened to it.
+     */
+    static constexpr uint64_t MaxTicks = (uint64_t(1) << (SlotBits * LevelsCount)) - 1;
+
+    /**
+     * @brief Timer, owned by user. It's cancelled,
+     * when it's destroyed.
+     */
+    class Timer
+    {
+    public:
+
+        /**
+         * @brief Constructor.
+         */
+        Timer();
+
+        /**
+         * @brief Destructor.
+         */
+        ~Timer();
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        /**
+         * @brief Method for checking is timer armed.
+         * @return Is timer waiting for expiration.
+         */
+        bool isArmed() const;
+
+        /**
+         * @brief Method for cancelling timer. It
+         * does nothing, if timer is not armed.
+         */
+        void cancel();
+
+        /**
+         * @brief User data, that identifies
+         * owner of expired timer.
+         */
+        uint64_t data;
+
+    private:
+        friend class HTTPTimerWheel;
+
+        Timer* m_next;
+
+        /**
+         * @brief Pointer to pointer, that points to
+         * this timer. It's nullptr, if timer is not armed.
+         */
+        Timer** m_link;
+
+        uint64_t m_expiration;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param now Time of tick 0.
+     */
+    explicit HTTPTimerWheel(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Destructor. Armed timers are cancelled.
+     */
+    ~HTTPTimerWheel();
+
+    HTTPTimerWheel(const HTTPTimerWheel&) = delete;
+    HTTPTimerWheel& operator=(const HTTPTimerWheel&) = delete;
+
+    /**
+     * @brief Method for arming timer. Armed timer
+     * is rearmed. Timeout is rounded up to ticks
+     * and counted from last advanced tick.
+     * @param timer Timer.
+     * @param timeout Timeout.
+     */
+    void arm(Timer& timer, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Method for expiring timers up to
+     * current time. Timer is disarmed before
+     * function is called, so function may rearm
+     * it or destroy it's owner.
+     * @param now Current time.
+     * @param function Function, that is called
+     * with every expired timer.
+     */
+    template<typename Function>
+    void advance(Clock::time_point now, Function&& function)
+    {
+        auto target = static_cast<uint64_t>((now - m_start) / TickDuration);
+
+        while (m_current < target)
+        {
+            ++m_current;
+
+            cascade();
+
+            auto& slot = m_slots[0][m_current & (SlotsCount - 1)];
+
+            while (slot != nullptr)
+            {
+                auto* timer = slot;
+
+                timer->cancel();
+
+                function(*timer);
+            }
+        }
+    }
+
+private:
+
+    /**
+     * @brief Method for linking timer into slot
+     * by it's expiration tick.
+     * @param timer Timer.
+     */
+    void link(Timer& timer);
+
+    /**
+     * @brief Method for moving timers of upper
+     * levels, that are reached by current tick,
+     * to lower levels.
+     */
+    void cascade();
+
+    Clock::time_point m_start;
+    uint64_t m_current;
+
+    std::array<std::array<Timer*, SlotsCount>, LevelsCount> m_slots;
+};
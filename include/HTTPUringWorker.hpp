@@ -0,0 +1,225 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <Tools/IOURing.hpp>
+#include "HTTPWorker.hpp"
+
+/**
+ * @brief Worker, that runs completion based
+ * io_uring event loop. Connections are accepted
+ * with single multishot accept, requests are
+ * received into kernel selected buffers, and
+ * last response of connection is sent with
+ * linked close, so steady state needs only one
+ * `io_uring_enter` call per loop iteration.
+ */
+class HTTPUringWorker : public HTTPWorker
+{
+public:
+
+    /**
+     * @brief Number of submission queue entries.
+     */
+    static constexpr unsigned QueueSize = 256;
+
+    /**
+     * @brief Number of receive buffers, shared
+     * by all connections of worker.
+     */
+    static constexpr unsigned BuffersCount = 512;
+
+    /**
+     * @brief Size of single receive buffer.
+     */
+    static constexpr std::size_t BufferSize = 4096;
+
+    /**
+     * @brief Constructor.
+     * @param server Server, that processes requests.
+     */
+    explicit HTTPUringWorker(HTTPServer& server);
+
+    /**
+     * @brief Destructor.
+     */
+    ~HTTPUringWorker() override;
+
+    /**
+     * @brief Method for checking, that kernel
+     * supports all used io_uring features.
+     * @return Can worker be used.
+     */
+    static bool isSupported();
+
+    /**
+     * @brief Method for initializing listening
+     * socket and io_uring instance.
+     * @param address Binding address.
+     * @param port Binding port.
+     * @param options Listening socket options.
+     * @return Initializing success.
+     */
+    bool initialize(uint32_t address, uint16_t port, const HTTPServerOptions& options) override;
+
+    /**
+     * @brief Event loop execution method.
+     */
+    void exec() override;
+
+private:
+
+    /**
+     * @brief Kind of submitted operation. It's
+     * stored in lower byte of user data.
+     */
+    enum class Operation : uint8_t
+    {
+          Accept
+        , Receive
+        , Send
+        , Poll
+        , Close
+        , Timeout
+        , Executor
+        , Cancel
+    };
+
+    /**
+     * @brief Connection with state of it's
+     * submitted operations. Connection is destroyed
+     * only after all it's operations are completed.
+     */
+    struct Slot
+    {
+        std::unique_ptr<HTTPConnection> connection;
+        msghdr message;
+        iovec buffers[2];
+        std::size_t pending;
+        bool receiving;
+        bool sending;
+        bool closing;
+    };
+
+    /**
+     * @brief Method for submitting multishot accept.
+     * @return Submitting success.
+     */
+    bool submitAccept();
+
+    /**
+     * @brief Method for submitting timeout of
+     * single timer wheel tick.
+     * @return Submitting success.
+     */
+    bool submitTimeout();
+
+    /**
+     * @brief Method for submitting multishot
+     * waiting for executor descriptor readability.
+     * @param descriptor Executor descriptor.
+     * @return Submitting success.
+     */
+    bool submitExecutorPoll(int descriptor);
+
+    /**
+     * @brief Method for submitting cancelling of
+     * connection operation.
+     * @param id Connection id.
+     * @param operation Operation.
+     * @return Submitting success.
+     */
+    bool submitCancel(uint64_t id, Operation operation);
+
+    /**
+     * @brief Method for submitting receiving into
+     * kernel selected buffer.
+     * @param id Connection id.
+     * @param slot Connection slot.
+     * @return Submitting success.
+     */
+    bool submitReceive(uint64_t id, Slot& slot);
+
+    /**
+     * @brief Method for submitting sending of
+     * response head and data. Last response of
+     * connection is linked with socket closing.
+     * @param id Connection id.
+     * @param slot Connection slot.
+     * @return Submitting success.
+     */
+    bool submitSend(uint64_t id, Slot& slot);
+
+    /**
+     * @brief Method for submitting waiting for
+     * socket writability. It's used for file data,
+     * that is sent with `sendfile`.
+     * @param id Connection id.
+     * @param slot Connection slot.
+     * @return Submitting success.
+     */
+    bool submitPoll(uint64_t id, Slot& slot);
+
+    /**
+     * @brief Method for processing single completion.
+     * @param cqe Completion.
+     */
+    void proceedCompletion(const io_uring_cqe& cqe);
+
+    /**
+     * @brief Method for registering accepted connection.
+     * @param socket Accepted socket.
+     */
+    void acceptConnection(socket_t socket);
+
+    /**
+     * @brief Method for moving connection state
+     * machine as far as possible and submitting
+     * next operation. Slot may be destroyed after
+     * this call.
+     * @param id Connection id.
+     * @param slot Connection slot.
+     */
+    void proceedConnection(uint64_t id, Slot& slot);
+
+    /**
+     * @brief Method for continuing connection,
+     * after it's suspended handler set response.
+     * @param id Connection id.
+     */
+    void resumeConnection(uint64_t id);
+
+    /**
+     * @brief Method for closing connection. Slot is
+     * destroyed immediately, if connection has no
+     * submitted operations.
+     * @param id Connection id.
+     * @param slot Connection slot.
+     */
+    void closeConnection(uint64_t id, Slot& slot);
+
+    /**
+     * @brief Method for processing connections,
+     * which timers are expired.
+     * @param now Current time.
+     */
+    void proceedTimeouts(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Method for forming operation user data.
+     * @param id Connection id or descriptor.
+     * @param operation Operation.
+     * @return User data.
+     */
+    static uint64_t userData(uint64_t id, Operation operation);
+
+    socket_t m_recvSocket;
+    bool m_acceptArmed;
+    uint64_t m_nextId;
+    __kernel_timespec m_tickInterval;
+
+    std::unordered_map<uint64_t, Slot> m_connections;
+
+    IOURing m_ring;
+};
+
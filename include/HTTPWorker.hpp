@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include <Tools/Network.hpp>
+#include "HTTPExecutor.hpp"
+#include "HTTPRequest.hpp"
+#include "HTTPMetrics.hpp"
+#include "HTTPTimerWheel.hpp"
+#include "HTTPConnection.hpp"
+#include "HTTPServerOptions.hpp"
+
+class HTTPServer;
+
+/**
+ * @brief Base class of single server worker.
+ * Worker owns listening socket, event loop
+ * and connections, so workers don't share
+ * any state. Derived classes implement I/O,
+ * while request processing is common.
+ */
+class HTTPWorker
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param server Server, that processes requests.
+     */
+    explicit HTTPWorker(HTTPServer& server);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HTTPWorker() = default;
+
+    HTTPWorker(const HTTPWorker&) = delete;
+    HTTPWorker& operator=(const HTTPWorker&) = delete;
+
+    /**
+     * @brief Method for initializing listening
+     * socket and event loop.
+     * @param address Binding address.
+     * @param port Binding port.
+     * @param options Listening socket options.
+     * @return Initializing success.
+     */
+    virtual bool initialize(uint32_t address, uint16_t port, const HTTPServerOptions& options) = 0;
+
+    /**
+     * @brief Event loop execution method.
+     */
+    virtual void exec() = 0;
+
+    /**
+     * @brief Method for setting limits of worker.
+     * @param maxConnections Maximum number of
+     * connections. 0 means no limit.
+     * @param maxInflightRequests Maximum number of
+     * handled or sent requests. 0 means no limit.
+     */
+    void setLimits(std::size_t maxConnections, std::size_t maxInflightRequests);
+
+protected:
+
+    /**
+     * @brief Method for creating bound and
+     * listening socket.
+     * @param address Binding address.
+     * @param port Binding port.
+     * @param options Listening socket options.
+     * @return Non blocking socket or `INVALID_SOCKET`
+     * on error.
+     */
+    static socket_t createListener(uint32_t address, uint16_t port, const HTTPServerOptions& options);
+
+    /**
+     * @brief Method for blocking `SIGPIPE` for
+     * calling thread.
+     */
+    static void blockPipeSignal();
+
+    /**
+     * @brief Method for starting request body
+     * receiving, after request header was received.
+     * @param connection Connection.
+     */
+    void proceedBody(HTTPConnection& connection);
+
+    /**
+     * @brief Method for calling `proceedRequestAsync`
+     * or body handler and preparing response
+     * sending. If handler is suspended, connection
+     * stays in `Handling` state, until response
+     * is returned.
+     * @param connection Connection.
+     * @param resume Function, that is called after
+     * suspended handler set response and connection
+     * moved to `Writing` state. It's not called, if
+     * response is set before this method returns.
+     */
+    void proceedHandling(HTTPConnection& connection, std::function<void()> resume);
+
+    /**
+     * @brief Method for preparing error response
+     * sending. Connection is closed after response.
+     * @param connection Connection.
+     * @param code Response status code.
+     */
+    void proceedError(HTTPConnection& connection, HTTPResponse::StatusCode code);
+
+    /**
+     * @brief Method for checking connections limit
+     * for accepted socket. If limit is reached,
+     * socket is answered with `ServiceUnavailable`
+     * and closed.
+     * @param socket Accepted socket.
+     * @param address Peer address.
+     * @param connectionsCount Number of open
+     * connections of worker.
+     * @return Has connection to be served.
+     */
+    bool admitConnection(socket_t socket, const sockaddr_in& address, std::size_t connectionsCount);
+
+    /**
+     * @brief Method for recording accepted
+     * connection in metrics.
+     */
+    void recordAccepted();
+
+    /**
+     * @brief Method for accounting request, which
+     * response was sent: traffic is recorded and
+     * in-flight request is released. It has to be
+     * called before connection is reset.
+     * @param connection Connection.
+     */
+    void finishRequest(HTTPConnection& connection);
+
+    /**
+     * @brief Method for accounting connection,
+     * that is closed.
+     * @param connection Connection.
+     */
+    void releaseConnection(HTTPConnection& connection);
+
+    /**
+     * @brief Method for arming connection timer
+     * by connection state. It has to be called,
+     * when connection waits for next event. Keep
+     * alive and header timeouts are armed once,
+     * body and write timeouts are rearmed on
+     * every call.
+     * @param connection Connection.
+     */
+    void updateTimeout(HTTPConnection& connection);
+
+    /**
+     * @brief Method for processing expired
+     * connection timer. Request, that is not
+     * received in time, is answered with
+     * `RequestTimeout`.
+     * @param connection Connection.
+     * @return True, if response is set and
+     * connection has to be proceeded. False,
+     * if connection has to be closed.
+     */
+    bool proceedTimeout(HTTPConnection& connection);
+
+    /**
+     * @brief Method for checking is persistent
+     * connection requested by client, according
+     * to protocol version and `Connection` header.
+     * @param request Request.
+     * @return Keep alive flag.
+     */
+    static bool isKeepAliveRequested(const HTTPRequest& request);
+
+    HTTPServer& m_server;
+    HTTPExecutor m_executor;
+
+    /**
+     * @brief Connection timers. User data of
+     * timer is connection key of worker.
+     */
+    HTTPTimerWheel m_timers;
+
+    /**
+     * @brief Metrics shard of worker or nullptr,
+     * if metrics are disabled.
+     */
+    HTTPMetrics::Shard* m_metrics;
+
+private:
+
+    /**
+     * @brief Method for setting handler response
+     * and moving connection to `Writing` state.
+     * @param connection Connection.
+     * @param response Response.
+     * @param keepAlive Keep connection after response.
+     * @param headOnly Send only status line and header.
+     */
+    static void finishHandling(HTTPConnection& connection,
+                               HTTPResponse response,
+                               bool keepAlive,
+                               bool headOnly);
+
+    /**
+     * @brief Method for checking in-flight requests
+     * limit for request, which header was received.
+     * @param connection Connection.
+     * @return Has request to be handled.
+     */
+    bool admitRequest(HTTPConnection& connection);
+
+    /**
+     * @brief Method for recording handled request
+     * in metrics.
+     * @param method Request method.
+     * @param route Route, set by handler.
+     * @param started Time handler was called.
+     * @param response Response.
+     */
+    void recordHandling(HTTPRequest::Method method,
+                        std::size_t route,
+                        std::chrono::steady_clock::time_point started,
+                        const HTTPResponse& response);
+
+    /**
+     * @brief Method for checking is request
+     * addressed to metrics path.
+     * @param request Request.
+     * @return Has server to answer with metrics.
+     */
+    bool isMetricsRequest(const HTTPRequest& request) const;
+
+    /**
+     * @brief Method for forming metrics response.
+     * @param request Request.
+     * @return Response.
+     */
+    HTTPResponse metricsResponse(const HTTPRequest& request) const;
+
+    HTTPConnection* m_handling;
+
+    std::size_t m_maxConnections;
+    std::size_t m_maxInflightRequests;
+    std::size_t m_inflightRequests;
+};
+
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <memory_resource>
+#include "HTTPBodyStream.hpp"
+#include "nlohmann/json.hpp"
+
+/**
+ * @brief Body stream, that serializes JSON value
+ * in parts. Value is walked with explicit stack,
+ * so serialization stops, when part is filled, and
+ * continues from same place for next part. Scalars
+ * are serialized straight into connection buffer.
+ * Output is same as `nlohmann::json::dump()`.
+ *
+ * Example:
+ * ```
+ * response.setStream(std::allocate_shared<JSONBodyStream>(
+ *     std::pmr::polymorphic_allocator<JSONBodyStream>(resource),
+ *     std::move(value),
+ *     resource
+ * ));
+ * ```
+ */
+class JSONBodyStream : public HTTPBodyStream
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param value JSON value.
+     * @param resource Memory resource of internal state.
+     */
+    explicit JSONBodyStream(nlohmann::json value,
+                            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    bool write(std::vector<std::byte>& buffer, std::size_t size) override;
+
+private:
+
+    /**
+     * @brief Writer of scalars and keys into
+     * current buffer.
+     */
+    class Writer;
+
+    /**
+     * @brief Object or array, which elements
+     * are being serialized.
+     */
+    struct Frame
+    {
+        const nlohmann::json* container;
+        nlohmann::json::const_iterator position;
+    };
+
+    /**
+     * @brief Method for serializing next element
+     * of top container, or closing container.
+     */
+    void step();
+
+    /**
+     * @brief Method for serializing value. Non
+     * empty containers are opened and pushed
+     * to stack, other values are written whole.
+     * @param value Value.
+     */
+    void writeValue(const nlohmann::json& value);
+
+    nlohmann::json m_value;
+
+    std::shared_ptr<Writer> m_writer;
+
+    std::pmr::vector<Frame> m_stack;
+    bool m_started;
+};
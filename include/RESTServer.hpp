@@ -1,6 +1,12 @@
 #pragma once
 
+#include <string>
+#include <optional>
+#include <string_view>
+#include <memory_resource>
 #include "HTTPServer.hpp"
+#include "HTTPRouter.hpp"
+#include "URIArguments.hpp"
 #include "nlohmann/json.hpp"
 
 /**
@@ -19,8 +25,42 @@ public:
         , InvalidMethod    = 4
     };
 
-    using Arguments = std::map<std::string_view, std::string_view>;
+    /**
+     * @brief Body encodings. Response encoding is
+     * chosen by `Accept` header, request body is
+     * decoded by `Content-Type` header.
+     */
+    enum class Encoding
+    {
+          JSON
+        , CBOR
+        , MessagePack
+    };
+
+    /**
+     * @brief URI arguments and path parameters
+     * of route. Query is parsed on first access,
+     * decoded values are allocated from memory
+     * resource of request. Path parameter replaces
+     * query argument with same name.
+     */
+    using Arguments = URIArguments;
+    /**
+     * @brief Command processor, that receives raw
+     * body. Body in CBOR or MessagePack is converted
+     * to JSON text before processor is called, so
+     * processor receives JSON in any encoding.
+     */
     using ProcessorFunction = std::function<nlohmann::json(Arguments, std::byte*, std::size_t)>;
+    /**
+     * @brief Command processor, that receives body
+     * decoded by `Content-Type` header. Body without
+     * binary encoding is parsed as JSON, empty body
+     * is `null`. Binary bodies are not converted
+     * to JSON text, so CBOR byte strings are
+     * received as binary values.
+     */
+    using JSONProcessorFunction = std::function<nlohmann::json(Arguments, const nlohmann::json&)>;
     using ErrorProcessorFunction = std::function<nlohmann::json(ErrorCode, std::string)>;
 
     /**
@@ -30,9 +70,15 @@ public:
 
     /**
      * @brief Method for adding REST command processor.
+     * Throws `std::invalid_argument` if key is malformed.
      * @param method Request method.
-     * @param key Command key. Example: "/api/action"
+     * @param key Command key. It may contain `:name`
+     * segment and `*name` rest of path parameters.
+     * Example: "/api/action", "/api/users/:id",
+     * or "/api/files/" with `*path` segment.
      * @param function Command processor function.
+     * Key is route label of server metrics, so
+     * processors have to be added before `exec`.
      */
     void addProcessor(
         HTTPRequest::Method method,
@@ -40,6 +86,21 @@ public:
         ProcessorFunction function
     );
 
+    /**
+     * @brief Method for adding REST command processor,
+     * that receives decoded body. Malformed body is
+     * reported to error processor with
+     * `ErrorCode::InvalidArguments`.
+     * @param method Request method.
+     * @param key Command key.
+     * @param function Command processor function.
+     */
+    void addProcessor(
+        HTTPRequest::Method method,
+        std::string key,
+        JSONProcessorFunction function
+    );
+
     /**
      * @brief Method for setting error processor.
      * This processor is called on any error.
@@ -47,19 +108,86 @@ public:
      */
     void setErrorProcessor(ErrorProcessorFunction function);
 
+    /**
+     * @brief Method for parsing uri to components.
+     * Query is not parsed here, it's passed to
+     * arguments, that parse it on first access.
+     * @param uri Base URI.
+     * @param outPath Path without query.
+     * @param arguments Arguments, that receive query.
+     * @return Success.
+     */
+    static bool splitUri(
+        const std::string_view& uri,
+        std::string_view& outPath,
+        Arguments& arguments
+    );
+
+    /**
+     * @brief Method for choosing response encoding
+     * by value of `Accept` header. Media type with
+     * highest quality wins, JSON is used, if no
+     * supported type is accepted.
+     * @param accept Header value.
+     * @return Encoding.
+     */
+    static Encoding acceptedEncoding(std::string_view accept);
+
+    /**
+     * @brief Method for getting encoding of
+     * media type.
+     * @param mediaType Media type. Parameters
+     * are ignored. Example: "application/cbor".
+     * @return Encoding or `std::nullopt`, if type
+     * is not supported.
+     */
+    static std::optional<Encoding> mediaTypeEncoding(std::string_view mediaType);
+
+    /**
+     * @brief Method for getting media type
+     * of encoding.
+     * @param encoding Encoding.
+     * @return Media type.
+     */
+    static std::string_view encodingMediaType(Encoding encoding);
+
 protected:
     /**
      * @brief Overridden request processing, that
      * parses uri, search for processor by method and
-     * forming json response.
+     * forming response in accepted encoding.
      * @param request Request object.
      * @return Response object.
      */
     HTTPResponse proceedRequest(HTTPRequest request) override;
 
 private:
+
+    /**
+     * @brief Command processor with metrics
+     * route of it's key. Only one of processor
+     * functions is set.
+     */
+    struct Command
+    {
+        ProcessorFunction function;
+        JSONProcessorFunction jsonFunction;
+        std::size_t route;
+    };
+
     nlohmann::json proceedREST(HTTPRequest request);
 
+    /**
+     * @brief Method for decoding request body.
+     * Throws `nlohmann::json::exception` on
+     * malformed body.
+     * @param request Request object.
+     * @param encoding Body encoding.
+     * @return Decoded value or `null`, if
+     * body is empty.
+     */
+    static nlohmann::json decodeBody(const HTTPRequest& request, Encoding encoding);
+
     /**
      * @brief Default error processor.
      * @param error Error code.
@@ -68,28 +196,7 @@ private:
      */
     static nlohmann::json defaultErrorProcessor(ErrorCode error, std::string info);
 
-    /**
-     * @brief Method for parsing uri to components.
-     * @param uri Base URI.
-     * @param outPath
-     * @param arguments
-     * @return
-     */
-    bool splitUri(
-        const std::string_view& uri,
-        std::string_view& outPath,
-        Arguments& arguments
-    );
-
-    std::map<
-        std::string,
-        std::map<
-            HTTPRequest::Method,
-            ProcessorFunction
-        >
-    > m_processors;
+    HTTPRouter<Command> m_router;
     ErrorProcessorFunction m_errorProcessor;
-
-    std::string m_dataBuffer;
 };
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <string_view>
+#include "HTTPResponse.hpp"
+#include "HTTPHeader.hpp"
+
+/**
+ * @brief Class, that writes response head into
+ * growable buffer with single pass. Status lines
+ * of HTTP/1.1 are rendered at compile time, so
+ * nor size calculation, nor printf are required.
+ *
+ * Example:
+ * ```
+ * ResponseWriter writer(buffer);
+ * writer.writeStatusLine("HTTP/1.1", HTTPResponse::StatusCode::Ok);
+ * writer.writeHeader(response.header());
+ * writer.writeField("Content-Length", "12");
+ * writer.writeEnd();
+ * ```
+ */
+class ResponseWriter
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param buffer Buffer, that data is appended
+     * to. Capacity of buffer is reused, so after
+     * first responses it's not reallocated.
+     */
+    explicit ResponseWriter(std::vector<std::byte>& buffer);
+
+    /**
+     * @brief Method for writing status line.
+     * @param version Protocol version.
+     * @param code Status code.
+     */
+    void writeStatusLine(std::string_view version, HTTPResponse::StatusCode code);
+
+    /**
+     * @brief Method for writing single field.
+     * @param name Field name.
+     * @param value Field value.
+     */
+    void writeField(std::string_view name, std::string_view value);
+
+    /**
+     * @brief Method for writing all fields of header.
+     * @param header Header.
+     */
+    void writeHeader(const HTTPHeader& header);
+
+    /**
+     * @brief Method for writing empty line,
+     * that finishes head.
+     */
+    void writeEnd();
+
+    /**
+     * @brief Method for writing status line,
+     * header and empty line of response.
+     * @param response Response.
+     */
+    void writeHead(const HTTPResponse& response);
+
+    /**
+     * @brief Method for getting pre-rendered
+     * status line, like "HTTP/1.1 200 OK\r\n".
+     * @param code Status code.
+     * @return Status line with CRLF or empty
+     * string for unknown code.
+     */
+    static std::string_view statusLine(HTTPResponse::StatusCode code);
+
+    /**
+     * @brief Method for getting reason phrase
+     * of status code.
+     * @param code Status code.
+     * @return Reason phrase or "Unknown".
+     */
+    static std::string_view reasonPhrase(HTTPResponse::StatusCode code);
+
+private:
+
+    /**
+     * @brief Method for appending bytes to buffer.
+     * @param data String.
+     */
+    void append(std::string_view data);
+
+    std::vector<std::byte>& m_buffer;
+};
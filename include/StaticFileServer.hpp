@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <memory_resource>
+#include "HTTPServer.hpp"
+
+/**
+ * @brief HTTP server, that serves static files
+ * from directories, mounted at URI prefixes.
+ * Files are sent with `sendfile` and never copied
+ * through user space.
+ */
+class StaticFileServer : public HTTPServer
+{
+public:
+
+    /**
+     * @brief Name of file, that is sent if
+     * directory is requested.
+     */
+    static constexpr std::string_view IndexFile = "index.html";
+
+    /**
+     * @brief Constructor.
+     */
+    StaticFileServer();
+
+    /**
+     * @brief Method for mounting directory at
+     * URI prefix. If several prefixes match request
+     * URI, the longest one is used.
+     * @param prefix URI prefix. Example: "/static"
+     * @param directory Path to directory. Example: "/var/www"
+     */
+    void addDirectory(std::string prefix, std::string directory);
+
+    /**
+     * @brief Method for getting content type of
+     * file by it's extension.
+     * @param path File path.
+     * @return Content type. "application/octet-stream"
+     * for unknown extensions.
+     */
+    static std::string_view contentType(std::string_view path);
+
+protected:
+
+    /**
+     * @brief Overridden request processing, that
+     * searches for requested file in mounted
+     * directories and forms response with it.
+     * @param request Request object.
+     * @return Response object.
+     */
+    HTTPResponse proceedRequest(HTTPRequest request) override;
+
+private:
+
+    /**
+     * @brief Method for decoding URI path relative
+     * to mount prefix. Paths with ".." segments are
+     * rejected.
+     * @param uri URI path without query.
+     * @param path Decoded path.
+     * @return Decoding success.
+     */
+    static bool decodePath(std::string_view uri, std::pmr::string& path);
+
+    /**
+     * @brief Method for forming error response.
+     * @param code Status code.
+     * @param resource Memory resource of request.
+     * @return Response object.
+     */
+    static HTTPResponse errorResponse(HTTPResponse::StatusCode code,
+                                      std::pmr::memory_resource* resource);
+
+    std::vector<std::pair<std::string, std::string>> m_directories;
+};
+
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <utility>
+#include <optional>
+#include <type_traits>
+#include <exception>
+#include <coroutine>
+
+template<typename T>
+class Task;
+
+namespace Detail
+{
+    /**
+     * @brief Base of task promise. It keeps
+     * coroutine, that awaits task, and resumes it
+     * when task is finished.
+     */
+    class TaskPromiseBase
+    {
+    public:
+
+        /**
+         * @brief Awaiter of finished task, that
+         * transfers execution to awaiting coroutine.
+         */
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                auto continuation = handle.promise().m_continuation;
+
+                if (continuation)
+                {
+                    return continuation;
+                }
+
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept
+            {
+
+            }
+        };
+
+        /**
+         * @brief Task is started only when awaited.
+         */
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void unhandled_exception() noexcept
+        {
+            m_exception = std::current_exception();
+        }
+
+        /**
+         * @brief Method for setting coroutine, that
+         * has to be resumed after task is finished.
+         * @param continuation Awaiting coroutine.
+         */
+        void setContinuation(std::coroutine_handle<> continuation) noexcept
+        {
+            m_continuation = continuation;
+        }
+
+    protected:
+
+        /**
+         * @brief Method for rethrowing exception,
+         * that was thrown by task.
+         */
+        void rethrow() const
+        {
+            if (m_exception)
+            {
+                std::rethrow_exception(m_exception);
+            }
+        }
+
+    private:
+        std::coroutine_handle<> m_continuation;
+        std::exception_ptr m_exception;
+    };
+
+    template<typename T>
+    class TaskPromise : public TaskPromiseBase
+    {
+    public:
+
+        Task<T> get_return_object() noexcept;
+
+        void return_value(T value)
+        {
+            m_value.emplace(std::move(value));
+        }
+
+        /**
+         * @brief Method for taking task result.
+         * @return Returned value.
+         */
+        T result()
+        {
+            rethrow();
+
+            return std::move(*m_value);
+        }
+
+    private:
+        std::optional<T> m_value;
+    };
+
+    template<>
+    class TaskPromise<void> : public TaskPromiseBase
+    {
+    public:
+
+        Task<void> get_return_object() noexcept;
+
+        void return_void() const noexcept
+        {
+
+        }
+
+        void result() const
+        {
+            rethrow();
+        }
+    };
+}
+
+/**
+ * @brief Lazy coroutine task. Coroutine is
+ * started, when task is awaited, and awaiting
+ * coroutine is resumed, when it's finished.
+ * Task may also be created with ready value,
+ * so synchronous code returns it without
+ * coroutine frame allocation.
+ * @tparam T Type of result.
+ */
+template<typename T>
+class Task
+{
+public:
+    using promise_type = Detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /**
+     * @brief Method for creating finished task
+     * without coroutine.
+     * @param value Result.
+     * @return Task.
+     */
+    template<typename U = T>
+    static Task ready(U value)
+    {
+        Task task;
+
+        task.m_value.emplace(std::move(value));
+
+        return task;
+    }
+
+    /**
+     * @brief Constructor from coroutine handle.
+     * @param handle Coroutine, owned by task.
+     */
+    explicit Task(Handle handle) noexcept :
+        m_handle(handle),
+        m_value()
+    {
+
+    }
+
+    Task(Task&& task) noexcept :
+        m_handle(std::exchange(task.m_handle, nullptr)),
+        m_value(std::move(task.m_value))
+    {
+
+    }
+
+    Task& operator=(Task&& task) noexcept
+    {
+        if (this != &task)
+        {
+            destroy();
+
+            m_handle = std::exchange(task.m_handle, nullptr);
+            m_value = std::move(task.m_value);
+        }
+
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    /**
+     * @brief Destructor. Destroys coroutine frame.
+     */
+    ~Task()
+    {
+        destroy();
+    }
+
+    /**
+     * @brief Method for checking is task result
+     * available without suspending.
+     * @return Is task ready.
+     */
+    bool isReady() const noexcept
+    {
+        return m_handle ? m_handle.done() : true;
+    }
+
+    /**
+     * @brief Method for taking result of ready
+     * task. Exception, thrown by task, is rethrown.
+     * @return Result.
+     */
+    T result()
+    {
+        if (m_handle)
+        {
+            return m_handle.promise().result();
+        }
+
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::move(*m_value);
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return isReady();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_handle.promise().setContinuation(awaiting);
+
+        return m_handle;
+    }
+
+    T await_resume()
+    {
+        return result();
+    }
+
+private:
+
+    /**
+     * @brief Value holder. Void tasks are never
+     * created ready with value.
+     */
+    using Value = std::conditional_t<std::is_void_v<T>, std::optional<bool>, std::optional<T>>;
+
+    Task() noexcept :
+        m_handle(nullptr),
+        m_value()
+    {
+
+    }
+
+    void destroy() noexcept
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+            m_handle = nullptr;
+        }
+    }
+
+    Handle m_handle;
+    Value m_value;
+};
+
+template<typename T>
+Task<T> Detail::TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> Detail::TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(Task<void>::Handle::from_promise(*this));
+}
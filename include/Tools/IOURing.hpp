@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <linux/io_uring.h>
+
+/**
+ * @brief Минимальная обертка над io_uring,
+ * работающая через системные вызовы напрямую,
+ * без liburing. Кольцо, созданное в одном потоке,
+ * должно использоваться только в потоке, который
+ * вызвал `IOURing::enable`.
+ */
+class IOURing
+{
+public:
+
+    /**
+     * @brief Конструктор.
+     */
+    IOURing();
+
+    /**
+     * @brief Деструктор. Закрывает кольцо.
+     */
+    ~IOURing();
+
+    IOURing(const IOURing&) = delete;
+    IOURing& operator=(const IOURing&) = delete;
+
+    /**
+     * @brief Метод для проверки, поддерживает ли ядро
+     * все используемые возможности io_uring. Результат
+     * проверки кешируется.
+     * @return Поддерживается ли io_uring.
+     */
+    static bool isSupported();
+
+    /**
+     * @brief Метод для создания кольца. Если ядро
+     * поддерживает, кольцо создается выключенным и
+     * с единственным отправителем.
+     * @param entries Количество элементов очереди отправки.
+     * @return Успешность создания.
+     */
+    bool initialize(unsigned entries);
+
+    /**
+     * @brief Метод для включения кольца и
+     * регистрации его дескриптора в вызывающем
+     * потоке. Должен быть вызван в потоке, который
+     * будет использовать кольцо.
+     * @return Успешность включения.
+     */
+    bool enable();
+
+    /**
+     * @brief Метод для регистрации дескрипторов
+     * файлов. Зарегистрированный файл используется
+     * с флагом `IOSQE_FIXED_FILE` и своим индексом.
+     * @param files Указатель на массив дескрипторов.
+     * @param count Количество дескрипторов.
+     * @return Успешность регистрации.
+     */
+    bool registerFiles(const int* files, unsigned count);
+
+    /**
+     * @brief Метод для создания и регистрации
+     * кольца буферов, из которого ядро само выбирает
+     * буфер для операции с `IOSQE_BUFFER_SELECT`.
+     * @param count Количество буферов. Степень двойки.
+     * @param size Размер каждого буфера.
+     * @param group Идентификатор группы буферов.
+     * @return Успешность регистрации.
+     */
+    bool registerBuffers(unsigned count, std::size_t size, uint16_t group);
+
+    /**
+     * @brief Метод для получения буфера по
+     * идентификатору из результата операции.
+     * @param id Идентификатор буфера.
+     * @return Указатель на буфер.
+     */
+    std::byte* buffer(uint16_t id);
+
+    /**
+     * @brief Метод для возврата буфера ядру
+     * после обработки полученных в него данных.
+     * @param id Идентификатор буфера.
+     */
+    void recycleBuffer(uint16_t id);
+
+    /**
+     * @brief Метод для получения свободного элемента
+     * очереди отправки. Если очередь заполнена, она
+     * предварительно отправляется. Элемент обнулен.
+     * @return Указатель на элемент или nullptr при ошибке.
+     */
+    io_uring_sqe* getSQE();
+
+    /**
+     * @brief Метод для отправки подготовленных
+     * элементов и ожидания завершений.
+     * @param waitCount Минимальное количество ожидаемых
+     * завершений.
+     * @return Количество отправленных элементов или
+     * -errno при ошибке.
+     */
+    int submit(unsigned waitCount);
+
+    /**
+     * @brief Метод для получения следующего
+     * завершения без ожидания.
+     * @return Указатель на завершение или nullptr,
+     * если завершений нет.
+     */
+    io_uring_cqe* peekCQE();
+
+    /**
+     * @brief Метод для освобождения завершения,
+     * полученного с помощью `IOURing::peekCQE`.
+     */
+    void seenCQE();
+
+private:
+
+    /**
+     * @brief Метод для освобождения ресурсов кольца.
+     */
+    void close();
+
+    int m_ring;
+    int m_enterRing;
+    unsigned m_enterFlags;
+    bool m_disabled;
+
+    void* m_ringMemory;
+    std::size_t m_ringSize;
+    io_uring_sqe* m_sqes;
+    std::size_t m_sqesSize;
+
+    unsigned* m_sqHead;
+    unsigned* m_sqTail;
+    unsigned m_sqMask;
+    unsigned m_sqEntries;
+    unsigned m_sqLocalTail;
+
+    unsigned* m_cqHead;
+    unsigned* m_cqTail;
+    unsigned m_cqMask;
+    io_uring_cqe* m_cqes;
+
+    io_uring_buf_ring* m_bufferRing;
+    std::size_t m_bufferRingSize;
+    unsigned m_bufferMask;
+    std::size_t m_bufferSize;
+    uint16_t m_bufferGroup;
+    std::vector<std::byte> m_buffers;
+};
+
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ScanTools
+{
+    /**
+     * @brief Реализации поиска. Выбирается при
+     * первом вызове по возможностям процессора.
+     */
+    enum class Implementation
+    {
+          Scalar
+        , SSE2
+        , AVX2
+    };
+
+    /**
+     * @brief Функция поиска первого перевода строки
+     * и первого двоеточия перед ним за один проход.
+     * Байты проверяются по 16 или 32 за раз.
+     * @param begin Указатель на начало данных.
+     * @param end Указатель на конец данных.
+     * @param colon Указатель на первое двоеточие
+     * перед переводом строки или nullptr, если
+     * его нет. Если перевод строки не найден,
+     * это первое двоеточие в данных.
+     * @return Указатель на перевод строки или
+     * nullptr, если он не найден.
+     */
+    const std::byte* FindLineFeed(const std::byte* begin,
+                                  const std::byte* end,
+                                  const std::byte** colon);
+
+    /**
+     * @brief Функция поиска с заданной реализацией.
+     * Используется для проверки реализаций.
+     * @param implementation Реализация. Должна
+     * поддерживаться процессором.
+     * @param begin Указатель на начало данных.
+     * @param end Указатель на конец данных.
+     * @param colon Указатель на первое двоеточие.
+     * @return Указатель на перевод строки или nullptr.
+     */
+    const std::byte* FindLineFeed(Implementation implementation,
+                                  const std::byte* begin,
+                                  const std::byte* end,
+                                  const std::byte** colon);
+
+    /**
+     * @brief Функция получения реализации,
+     * выбранной для процессора.
+     * @return Реализация.
+     */
+    Implementation CurrentImplementation();
+}
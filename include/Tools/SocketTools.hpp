@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
+#include <sys/types.h>
 #include "Network.hpp"
 
 namespace SocketTools
@@ -38,6 +40,32 @@ namespace SocketTools
      */
     ssize_t Send(socket_t socket, const uint8_t* buffer, int len, int flags);
 
+    /**
+     * @brief Функция для отправки нескольких
+     * буфферов одним системным вызовом, без
+     * их копирования в общий буффер.
+     * @param socket Сокет.
+     * @param buffers Указатель на массив буфферов.
+     * @param count Количество буфферов.
+     * @param flags Флаги, передаваемые в sendmsg.
+     * @return Количество отправленных данных.
+     */
+    ssize_t SendVector(socket_t socket, const iovec* buffers, int count, int flags);
+
+    /**
+     * @brief Функция для отправки данных файла
+     * через сокет с помощью sendfile, без
+     * копирования данных в пользовательское
+     * пространство.
+     * @param socket Сокет.
+     * @param file Дескриптор файла.
+     * @param offset Смещение данных в файле. Сдвигается
+     * на количество отправленных данных.
+     * @param len Длина данных.
+     * @return Количество отправленных данных.
+     */
+    ssize_t SendFile(socket_t socket, int file, off_t& offset, std::size_t len);
+
     /**
      * @brief Кроссплатформенная функция для
      * закрытия сокета.
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <optional>
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+#include <memory_resource>
+
+/**
+ * @brief Arguments of URI query and path
+ * parameters. Query is parsed only on first
+ * access into flat storage, that keeps first
+ * arguments without allocations. Escaped
+ * values (`%xx` and `+`) are decoded into
+ * memory resource only when they are read.
+ *
+ * Example:
+ * ```
+ * URIArguments arguments(request.memoryResource());
+ * arguments.setQuery("id=42&name=John+Doe");
+ *
+ * auto id = arguments.get<int>("id");          // 42
+ * auto name = arguments.find("name");          // "John Doe"
+ * auto page = arguments.value("page", "1");    // "1"
+ * ```
+ */
+class URIArguments
+{
+public:
+
+    /**
+     * @brief Number of arguments, that are
+     * stored without allocation.
+     */
+    static constexpr std::size_t InlineCount = 8;
+
+    /**
+     * @brief Constructor.
+     * @param resource Memory resource for decoded
+     * values and arguments over `InlineCount`.
+     */
+    explicit URIArguments(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Destructor. Releases decoded values.
+     */
+    ~URIArguments();
+
+    URIArguments(URIArguments&& other) noexcept;
+
+    URIArguments(const URIArguments&) = delete;
+    URIArguments& operator=(const URIArguments&) = delete;
+    URIArguments& operator=(URIArguments&&) = delete;
+
+    /**
+     * @brief Method for setting query. It's
+     * not parsed until first access.
+     * @param query Query without "?". Has to be
+     * actual until object instance exists.
+     */
+    void setQuery(std::string_view query);
+
+    /**
+     * @brief Method for setting path parameter.
+     * Parameter replaces query argument with
+     * same name. It's not decoded.
+     * @param name Parameter name.
+     * @param value Parameter value.
+     */
+    void setParameter(std::string_view name, std::string_view value);
+
+    /**
+     * @brief Method for getting number of arguments
+     * and parameters.
+     * @return Number of arguments.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Method for getting decoded argument
+     * by index. Index has to be < `size()`.
+     * @param index Argument index.
+     * @return Name and value.
+     */
+    std::pair<std::string_view, std::string_view> argument(std::size_t index) const;
+
+    /**
+     * @brief Method for checking argument existence.
+     * @param name Decoded name.
+     * @return Does argument exist.
+     */
+    bool contains(std::string_view name) const;
+
+    /**
+     * @brief Method for searching decoded value of
+     * argument. If argument is repeated, last value
+     * is returned.
+     * @param name Decoded name.
+     * @return Value or `std::nullopt`.
+     */
+    std::optional<std::string_view> find(std::string_view name) const;
+
+    /**
+     * @brief Method for getting decoded value
+     * of argument.
+     * @param name Decoded name.
+     * @param defaultValue Value if argument is
+     * not found.
+     * @return Value.
+     */
+    std::string_view value(std::string_view name, std::string_view defaultValue = {}) const;
+
+    /**
+     * @brief Method for getting decoded value
+     * of argument or empty string.
+     * @param name Decoded name.
+     * @return Value.
+     */
+    std::string_view operator[](std::string_view name) const;
+
+    /**
+     * @brief Method for getting arithmetic value
+     * of argument. Whole value has to be number.
+     * @tparam T Arithmetic type.
+     * @param name Decoded name.
+     * @return Value or `std::nullopt` if argument
+     * is not found or is not a number.
+     */
+    template<typename T>
+    std::optional<T> get(std::string_view name) const
+    {
+        static_assert(std::is_arithmetic_v<T>, "Only numbers are supported.");
+
+        auto string = find(name);
+
+        if (!string)
+        {
+            return std::nullopt;
+        }
+
+        T result{};
+
+        auto* end = string->data() + string->size();
+        auto status = std::from_chars(string->data(), end, result);
+
+        if (status.ec != std::errc() || status.ptr != end)
+        {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Function for percent-decoding of
+     * query component. "+" is decoded to space,
+     * malformed escapes are kept as is.
+     * @param value Encoded value.
+     * @param output Output buffer of at least
+     * `value.size()` bytes.
+     * @return Decoded size.
+     */
+    static std::size_t decode(std::string_view value, char* output);
+
+private:
+
+    /**
+     * @brief Argument with view to query or
+     * to decoded value.
+     */
+    struct Argument
+    {
+        std::string_view name;
+        std::string_view value;
+        bool escaped;
+        bool parameter;
+    };
+
+    /**
+     * @brief Method for parsing query into arguments.
+     * Names are decoded immediately, values only
+     * on read.
+     */
+    void parse() const;
+
+    /**
+     * @brief Method for adding argument.
+     * @param argument Argument.
+     */
+    void append(Argument argument) const;
+
+    /**
+     * @brief Method for getting argument by index.
+     * @param index Argument index.
+     * @return Argument reference.
+     */
+    Argument& at(std::size_t index) const;
+
+    /**
+     * @brief Method for searching argument. Path
+     * parameter is preferred, then last query
+     * argument.
+     * @param name Decoded name.
+     * @return Argument or nullptr.
+     */
+    Argument* search(std::string_view name) const;
+
+    /**
+     * @brief Method for decoding value into
+     * memory resource.
+     * @param value Encoded value.
+     * @return Decoded value.
+     */
+    std::string_view decodeStored(std::string_view value) const;
+
+    std::pmr::memory_resource* m_resource;
+    std::string_view m_query;
+
+    mutable bool m_parsed;
+    mutable std::size_t m_size;
+    mutable std::array<Argument, InlineCount> m_inline;
+    mutable std::pmr::vector<Argument> m_overflow;
+    mutable std::pmr::vector<std::pair<char*, std::size_t>> m_decoded;
+};
@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <algorithm>
+#include "HTTPArena.hpp"
+
+HTTPArena::HTTPArena(std::size_t blockSize, std::pmr::memory_resource* upstream) :
+    m_blockSize(blockSize),
+    m_upstream(upstream),
+    m_blocks(),
+    m_current(0),
+    m_offset(0)
+{
+
+}
+
+HTTPArena::~HTTPArena()
+{
+    for (auto&& block : m_blocks)
+    {
+        m_upstream->deallocate(block.memory, block.size, alignof(std::max_align_t));
+    }
+}
+
+void HTTPArena::reset()
+{
+    m_current = 0;
+    m_offset = 0;
+}
+
+std::size_t HTTPArena::capacity() const
+{
+    std::size_t result = 0;
+
+    for (auto&& block : m_blocks)
+    {
+        result += block.size;
+    }
+
+    return result;
+}
+
+void* HTTPArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    // Searching for kept block with enough space
+    for (; m_current < m_blocks.size(); ++m_current, m_offset = 0)
+    {
+        auto& block = m_blocks[m_current];
+
+        auto base = reinterpret_cast<uintptr_t>(block.memory);
+        auto aligned = (base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+
+        if (aligned + bytes <= base + block.size)
+        {
+            m_offset = aligned + bytes - base;
+
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    auto size = std::max(
+        m_blocks.empty() ? m_blockSize : m_blocks.back().size * 2,
+        bytes + alignment
+    );
+
+    m_blocks.reserve(m_blocks.size() + 1);
+
+    auto* memory = static_cast<std::byte*>(m_upstream->allocate(size, alignof(std::max_align_t)));
+
+    m_blocks.push_back(Block{memory, size});
+
+    m_current = m_blocks.size() - 1;
+    m_offset = 0;
+
+    return do_allocate(bytes, alignment);
+}
+
+void HTTPArena::do_deallocate(void* /*pointer*/, std::size_t /*bytes*/, std::size_t /*alignment*/)
+{
+    // Memory is released by reset
+}
+
+bool HTTPArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
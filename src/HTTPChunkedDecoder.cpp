@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "HTTPChunkedDecoder.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of malformed chunked bodies.
+ */
+static const HTTPLog::Site LineTooLongSite{HTTPLog::Level::Warning, "Chunked body line is too long.", 1, 10};
+static const HTTPLog::Site LineBreakSite{HTTPLog::Level::Warning, "Can't find line break after chunk data.", 1, 10};
+static const HTTPLog::Site SizeRangeSite{HTTPLog::Level::Warning, "Chunk size is out of range.", 1, 10};
+static const HTTPLog::Site SizeParseSite{HTTPLog::Level::Warning, "Can't parse chunk size.", 1, 10};
+
+HTTPChunkedDecoder::HTTPChunkedDecoder() :
+    m_state(State::Size),
+    m_chunkRemaining(0)
+{
+
+}
+
+void HTTPChunkedDecoder::reset()
+{
+    m_state = State::Size;
+    m_chunkRemaining = 0;
+}
+
+HTTPChunkedDecoder::Status HTTPChunkedDecoder::decode(
+    const std::byte* input,
+    std::size_t size,
+    std::byte* output,
+    std::size_t& consumed,
+    std::size_t& produced)
+{
+    consumed = 0;
+    produced = 0;
+
+    while (m_state != State::Finished)
+    {
+        auto available = size - consumed;
+
+        if (m_state == State::Data)
+        {
+            auto length = std::min(available, m_chunkRemaining);
+
+            if (length == 0)
+            {
+                return Status::Incomplete;
+            }
+
+            // Regions may overlap with in place decoding
+            std::memmove(output + produced, input + consumed, length);
+
+            consumed += length;
+            produced += length;
+            m_chunkRemaining -= length;
+
+            if (m_chunkRemaining == 0)
+            {
+                m_state = State::DataEnd;
+            }
+
+            continue;
+        }
+
+        // Rest of states are line based
+        auto* lineFeed = static_cast<const std::byte*>(
+            std::memchr(input + consumed, '\n', available)
+        );
+
+        if (lineFeed == nullptr)
+        {
+            if (available > MaxLineSize)
+            {
+                HTTPLog::write(LineTooLongSite);
+                return Status::Error;
+            }
+
+            return Status::Incomplete;
+        }
+
+        auto* line = input + consumed;
+        auto lineSize = static_cast<std::size_t>(lineFeed - line);
+
+        consumed += lineSize + 1;
+
+        if (lineSize > 0 && line[lineSize - 1] == static_cast<std::byte>('\r'))
+        {
+            --lineSize;
+        }
+
+        switch (m_state)
+        {
+        case State::Size:
+            if (!parseSize(line, lineSize))
+            {
+                return Status::Error;
+            }
+
+            m_state = (m_chunkRemaining == 0) ? State::Trailer : State::Data;
+            break;
+
+        case State::DataEnd:
+            // Chunk data has to be followed by line break
+            if (lineSize != 0)
+            {
+                HTTPLog::write(LineBreakSite);
+                return Status::Error;
+            }
+
+            m_state = State::Size;
+            break;
+
+        case State::Trailer:
+            // Trailer fields are ignored until empty line
+            if (lineSize == 0)
+            {
+                m_state = State::Finished;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return Status::Complete;
+}
+
+bool HTTPChunkedDecoder::parseSize(const std::byte* line, std::size_t size)
+{
+    std::size_t result = 0;
+    std::size_t i = 0;
+
+    for (; i < size; ++i)
+    {
+        auto c = static_cast<char>(line[i]);
+
+        std::size_t digit;
+
+        if (c >= '0' && c <= '9')
+        {
+            digit = static_cast<std::size_t>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            digit = static_cast<std::size_t>(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            digit = static_cast<std::size_t>(c - 'A' + 10);
+        }
+        else
+        {
+            break;
+        }
+
+        if (result > (std::numeric_limits<std::size_t>::max() >> 4))
+        {
+            HTTPLog::write(SizeRangeSite);
+            return false;
+        }
+
+        result = (result << 4) | digit;
+    }
+
+    // Size is required. Chunk extensions after it are ignored.
+    if (i == 0 ||
+        (i < size &&
+         line[i] != static_cast<std::byte>(';') &&
+         line[i] != static_cast<std::byte>(' ') &&
+         line[i] != static_cast<std::byte>('\t')))
+    {
+        HTTPLog::write(SizeParseSite);
+        return false;
+    }
+
+    m_chunkRemaining = result;
+
+    return true;
+}
@@ -0,0 +1,984 @@
+#include <charconv>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <Tools/SocketTools.hpp>
+#include "HTTPConnection.hpp"
+#include "ResponseWriter.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of request path. Records, caused
+ * by clients, are limited, so they can't flood log.
+ */
+static const HTTPLog::Site ReceiveErrorSite{HTTPLog::Level::Error, "Received error: {}", 1, 10};
+static const HTTPLog::Site HeaderTooLargeSite{HTTPLog::Level::Warning, "Request header from {} is too large.", 1, 10};
+static const HTTPLog::Site TransferEncodingSite{HTTPLog::Level::Warning, "Unsupported transfer encoding \"{}\".", 1, 10};
+static const HTTPLog::Site ContentLengthSite{HTTPLog::Level::Warning, "Wrong content length \"{}\".", 1, 10};
+static const HTTPLog::Site AmbiguousFramingSite{HTTPLog::Level::Warning, "Ambiguous body framing of request from {}.", 1, 10};
+static const HTTPLog::Site BodyTooLargeSite{HTTPLog::Level::Warning, "Request body from {} is too large.", 1, 10};
+static const HTTPLog::Site FileEndSite{HTTPLog::Level::Error, "Can't send file data: unexpected end of file.", 1, 10};
+static const HTTPLog::Site SendErrorSite{HTTPLog::Level::Error, "Send error: {}", 1, 10};
+static const HTTPLog::Site StreamErrorSite{HTTPLog::Level::Error, "Can't write response body: {}", 1, 10};
+
+static const std::string_view ContinueResponse = "HTTP/1.1 100 Continue\r\n\r\n";
+
+/**
+ * @brief Space before part of body stream for
+ * chunk size: 16 hex digits and CRLF.
+ */
+static constexpr std::size_t ChunkSizeSpace = 18;
+
+static const std::string_view LastChunk = "0\r\n\r\n";
+
+HTTPConnection::HTTPConnection(socket_t socket, sockaddr_in address) :
+    m_socket(socket),
+    m_address(address),
+    m_state(State::Reading),
+    m_arena(ArenaBlockSize),
+    m_inputBuffer(),
+    m_received(0),
+    m_inputState(InputState::Header),
+    m_request(&m_arena),
+    m_requestError(HTTPResponse::StatusCode::Unknown),
+    m_requestSize(0),
+    m_peerClosed(false),
+    m_bodyFraming(BodyFraming::None),
+    m_maxBodySize(0),
+    m_bodyRemaining(0),
+    m_bodyOffset(0),
+    m_bodySize(0),
+    m_bodyTotal(0),
+    m_rawPosition(0),
+    m_chunkedDecoder(),
+    m_bodyHandler(),
+    m_bodyAborted(false),
+    m_response(&m_arena),
+    m_outputBuffer(),
+    m_sent(0),
+    m_streamBuffer(),
+    m_streamBegin(0),
+    m_streamSent(0),
+    m_streamFinished(false),
+    m_streamFraming(StreamFraming::Identity),
+    m_chunkedAllowed(false),
+    m_keepAlive(false),
+    m_admitted(false),
+    m_requestsCount(0),
+    m_timer(),
+    m_timeout(Timeout::None),
+    m_bytesReceived(0),
+    m_bytesSent(0)
+{
+
+}
+
+HTTPConnection::~HTTPConnection()
+{
+    if (m_socket != INVALID_SOCKET)
+    {
+        SocketTools::Close(m_socket);
+    }
+}
+
+socket_t HTTPConnection::socket() const
+{
+    return m_socket;
+}
+
+const sockaddr_in& HTTPConnection::address() const
+{
+    return m_address;
+}
+
+std::string HTTPConnection::peerAddress() const
+{
+    char buffer[INET_ADDRSTRLEN] = {0};
+
+    inet_ntop(AF_INET, &m_address.sin_addr, buffer, sizeof(buffer));
+
+    return std::string(buffer) + ':' + std::to_string(ntohs(m_address.sin_port));
+}
+
+HTTPConnection::State HTTPConnection::state() const
+{
+    return m_state;
+}
+
+void HTTPConnection::setState(HTTPConnection::State state)
+{
+    m_state = state;
+}
+
+bool HTTPConnection::readAvailable()
+{
+    while (isInputExpected())
+    {
+        reserveInput();
+
+        ssize_t currentlyReceived = SocketTools::Receive(
+            m_socket,
+            reinterpret_cast<uint8_t*>(m_inputBuffer.data() + m_received),
+            static_cast<int>(m_inputBuffer.size() - m_received),
+            0
+        );
+
+        if (currentlyReceived == 0)
+        {
+            // Peer closed connection. Already received
+            // request still can be answered.
+            m_peerClosed = true;
+            return true;
+        }
+
+        if (currentlyReceived == -1)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return true;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            HTTPLog::write(ReceiveErrorSite, strerror(errno));
+            return false;
+        }
+
+        m_received += currentlyReceived;
+        m_bytesReceived += static_cast<uint64_t>(currentlyReceived);
+
+        proceedInput();
+    }
+
+    return true;
+}
+
+bool HTTPConnection::isInputExpected() const
+{
+    return m_inputState == InputState::Header ||
+           m_inputState == InputState::Body;
+}
+
+void HTTPConnection::appendInput(const std::byte* data, std::size_t size)
+{
+    m_bytesReceived += size;
+
+    while (size > 0)
+    {
+        reserveInput();
+
+        auto length = std::min(size, m_inputBuffer.size() - m_received);
+
+        std::copy(data, data + length, m_inputBuffer.data() + m_received);
+
+        m_received += length;
+        data += length;
+        size -= length;
+
+        // Bytes after current request are
+        // parsed after `reset`
+        if (isInputExpected())
+        {
+            proceedInput();
+        }
+    }
+}
+
+void HTTPConnection::setPeerClosed()
+{
+    m_peerClosed = true;
+}
+
+void HTTPConnection::reserveInput()
+{
+    // Growing buffer, so every receive call
+    // reads whole free space of the buffer
+    if (m_inputBuffer.size() - m_received < ReadChunkSize / 4)
+    {
+        m_inputBuffer.resize(
+            std::max(m_inputBuffer.size() * 2, ReadChunkSize),
+            std::byte(0)
+        );
+    }
+}
+
+void HTTPConnection::proceedInput()
+{
+    if (m_inputState == InputState::Body)
+    {
+        consumeBody();
+        return;
+    }
+
+    if (m_inputState != InputState::Header)
+    {
+        return;
+    }
+
+    switch (m_request.parsePartial(m_inputBuffer.data(), m_received))
+    {
+    case HTTPRequest::ParseStatus::Complete:
+        m_requestSize = m_request.headerSize();
+        m_inputState = InputState::HeaderReceived;
+
+        // HTTP/1.0 clients don't support chunked responses
+        m_chunkedAllowed = m_request.version() == "HTTP/1.1";
+        break;
+
+    case HTTPRequest::ParseStatus::Error:
+        setMalformed(HTTPResponse::StatusCode::BadRequest);
+        break;
+
+    case HTTPRequest::ParseStatus::Incomplete:
+        if (m_received > MaxHeaderSize)
+        {
+            HTTPLog::write(HeaderTooLargeSite, m_address);
+            setMalformed(HTTPResponse::StatusCode::RequestHeaderFieldsTooLarge);
+        }
+        break;
+    }
+}
+
+bool HTTPConnection::isPeerClosed() const
+{
+    return m_peerClosed;
+}
+
+bool HTTPConnection::isHeaderReceived() const
+{
+    return m_inputState == InputState::HeaderReceived;
+}
+
+bool HTTPConnection::prepareBody(std::size_t maxBodySize)
+{
+    auto& header = request().header();
+
+    m_maxBodySize = maxBodySize;
+    m_bodyOffset = m_request.headerSize();
+    m_rawPosition = m_bodyOffset;
+    m_bodySize = 0;
+    m_bodyTotal = 0;
+
+    std::size_t transferEncodings = 0;
+    bool hasLength = false;
+
+    for (HTTPHeader::HeadersContainer::size_type i = 0;
+         i < header.numberOfHeaders();
+         ++i)
+    {
+        transferEncodings += header.token(i) == HTTPHeader::Token::TransferEncoding;
+        hasLength = hasLength || header.token(i) == HTTPHeader::Token::ContentLength;
+    }
+
+    // Proxy may frame such request differently,
+    // so it's rejected (RFC 7230 3.3.3)
+    if (transferEncodings > 1 || (transferEncodings == 1 && hasLength))
+    {
+        HTTPLog::write(AmbiguousFramingSite, m_address);
+        setMalformed(HTTPResponse::StatusCode::BadRequest);
+        return false;
+    }
+
+    if (auto* field = header.find(HTTPHeader::Token::TransferEncoding))
+    {
+        auto transferEncoding = field->second;
+
+        // Only chunked coding is supported
+        auto begin = transferEncoding.find_first_not_of(" \t");
+        auto end = transferEncoding.find_last_not_of(" \t");
+
+        auto coding = (begin == std::string_view::npos) ?
+                      std::string_view() :
+                      transferEncoding.substr(begin, end - begin + 1);
+
+        if (!HTTPHeader::equalsIgnoreCase(coding, "chunked"))
+        {
+            HTTPLog::write(TransferEncodingSite, transferEncoding);
+            setMalformed(HTTPResponse::StatusCode::NotImplemented);
+            return false;
+        }
+
+        m_bodyFraming = BodyFraming::Chunked;
+        m_chunkedDecoder.reset();
+        return true;
+    }
+
+    bool hasContentLength = false;
+    std::size_t contentLength = 0;
+
+    for (HTTPHeader::HeadersContainer::size_type i = 0;
+         i < header.numberOfHeaders();
+         ++i)
+    {
+        if (header.token(i) != HTTPHeader::Token::ContentLength)
+        {
+            continue;
+        }
+
+        auto value = header.header(i).second;
+
+        std::size_t length = 0;
+
+        auto result = std::from_chars(value.data(), value.data() + value.size(), length);
+
+        // Value has to be decimal number and all
+        // repeated fields has to be equal
+        if (value.empty() ||
+            result.ec != std::errc() ||
+            result.ptr != value.data() + value.size() ||
+            (hasContentLength && length != contentLength))
+        {
+            HTTPLog::write(ContentLengthSite, value);
+            setMalformed(HTTPResponse::StatusCode::BadRequest);
+            return false;
+        }
+
+        hasContentLength = true;
+        contentLength = length;
+    }
+
+    if (contentLength == 0)
+    {
+        m_bodyFraming = BodyFraming::None;
+        finishBody();
+        return false;
+    }
+
+    m_bodyFraming = BodyFraming::Length;
+    m_bodyRemaining = contentLength;
+
+    return true;
+}
+
+void HTTPConnection::beginBody(std::unique_ptr<HTTPBodyHandler> handler)
+{
+    m_bodyHandler = std::move(handler);
+    m_inputState = InputState::Body;
+
+    // Buffered body size is limited
+    if (!m_bodyHandler &&
+        m_bodyFraming == BodyFraming::Length &&
+        m_bodyRemaining > m_maxBodySize)
+    {
+        HTTPLog::write(BodyTooLargeSite, m_address);
+        setMalformed(HTTPResponse::StatusCode::PayloadTooLarge);
+        return;
+    }
+
+    // Client is waiting for confirmation
+    // before sending body
+    if (m_received == m_rawPosition &&
+        m_request.version() == "HTTP/1.1" &&
+        HTTPHeader::equalsIgnoreCase(
+            m_request.header().get(HTTPHeader::Token::Expect),
+            "100-continue"
+        ))
+    {
+        SocketTools::Send(
+            m_socket,
+            reinterpret_cast<const uint8_t*>(ContinueResponse.data()),
+            static_cast<int>(ContinueResponse.size()),
+            MSG_NOSIGNAL
+        );
+    }
+
+    // Body part may be received with header
+    consumeBody();
+}
+
+void HTTPConnection::consumeBody()
+{
+    auto* buffer = m_inputBuffer.data();
+
+    if (m_bodyFraming == BodyFraming::Length)
+    {
+        auto length = std::min(m_received - m_rawPosition, m_bodyRemaining);
+
+        m_bodyRemaining -= length;
+        m_bodyTotal += length;
+
+        if (m_bodyHandler)
+        {
+            streamBody(length);
+        }
+        else
+        {
+            m_rawPosition += length;
+            m_bodySize += length;
+        }
+
+        if (m_bodyRemaining == 0 && m_inputState == InputState::Body)
+        {
+            finishBody();
+        }
+
+        return;
+    }
+
+    std::size_t consumed = 0;
+    std::size_t produced = 0;
+
+    // Decoding in place
+    auto status = m_chunkedDecoder.decode(
+        buffer + m_rawPosition,
+        m_received - m_rawPosition,
+        buffer + m_bodyOffset + m_bodySize,
+        consumed,
+        produced
+    );
+
+    m_rawPosition += consumed;
+    m_bodySize += produced;
+    m_bodyTotal += produced;
+
+    if (status == HTTPChunkedDecoder::Status::Error)
+    {
+        setMalformed(HTTPResponse::StatusCode::BadRequest);
+        return;
+    }
+
+    if (m_bodyHandler)
+    {
+        streamBody(m_bodySize);
+    }
+    else if (m_bodyTotal > m_maxBodySize)
+    {
+        HTTPLog::write(BodyTooLargeSite, m_address);
+        setMalformed(HTTPResponse::StatusCode::PayloadTooLarge);
+        return;
+    }
+
+    if (status == HTTPChunkedDecoder::Status::Complete &&
+        m_inputState == InputState::Body)
+    {
+        finishBody();
+    }
+}
+
+void HTTPConnection::streamBody(std::size_t size)
+{
+    auto* buffer = m_inputBuffer.data();
+
+    if (size > 0 && !m_bodyHandler->proceedChunk(buffer + m_bodyOffset, size))
+    {
+        // Rest of body is not read, so connection
+        // can't be used for next request
+        m_bodyAborted = true;
+        finishBody();
+        return;
+    }
+
+    // Decoded bytes are placed at body offset. For
+    // Content-Length framing they are raw bytes.
+    auto dropFrom = (m_bodyFraming == BodyFraming::Length) ?
+                    m_bodyOffset + size :
+                    m_rawPosition;
+
+    std::copy(
+        buffer + dropFrom,
+        buffer + m_received,
+        buffer + m_bodyOffset
+    );
+
+    m_received -= dropFrom - m_bodyOffset;
+    m_rawPosition = m_bodyOffset;
+    m_bodySize = 0;
+}
+
+void HTTPConnection::finishBody()
+{
+    m_requestSize = m_rawPosition;
+    m_inputState = InputState::Received;
+}
+
+void HTTPConnection::setMalformed(HTTPResponse::StatusCode code)
+{
+    m_requestError = code;
+    m_inputState = InputState::Malformed;
+}
+
+bool HTTPConnection::isRequestReceived() const
+{
+    return m_inputState == InputState::Received;
+}
+
+bool HTTPConnection::isRequestMalformed() const
+{
+    return m_inputState == InputState::Malformed;
+}
+
+HTTPResponse::StatusCode HTTPConnection::requestError() const
+{
+    return m_requestError;
+}
+
+HTTPRequest& HTTPConnection::request()
+{
+    // Updating request fields, because input
+    // buffer may be reallocated after parsing
+    m_request.parsePartial(m_inputBuffer.data(), m_received);
+
+    if (m_inputState == InputState::Received && !m_bodyHandler)
+    {
+        m_request.setData(m_inputBuffer.data() + m_bodyOffset, m_bodySize);
+    }
+    else
+    {
+        m_request.setData(nullptr, 0);
+    }
+
+    return m_request;
+}
+
+HTTPBodyHandler* HTTPConnection::bodyHandler() const
+{
+    return m_bodyHandler.get();
+}
+
+bool HTTPConnection::isBodyAborted() const
+{
+    return m_bodyAborted;
+}
+
+void HTTPConnection::setResponse(HTTPResponse response, bool keepAlive, bool headOnly)
+{
+    m_response = std::move(response);
+
+    auto* connection = m_response.header().find(HTTPHeader::Token::Connection);
+
+    bool hasContentLength = m_response.header().find(HTTPHeader::Token::ContentLength) != nullptr;
+    bool hasConnection = connection != nullptr;
+
+    if (hasConnection && HTTPHeader::equalsIgnoreCase(connection->second, "close"))
+    {
+        keepAlive = false;
+    }
+
+    m_streamBuffer.clear();
+    m_streamBegin = 0;
+    m_streamSent = 0;
+    m_streamFinished = false;
+    m_streamFraming = StreamFraming::Identity;
+
+    bool isStreamed = m_response.stream() != nullptr && !headOnly;
+
+    // First part is written before head, so
+    // short body is sent with known length
+    if (isStreamed && !readStream())
+    {
+        m_response = HTTPResponse(&m_arena);
+        m_response.version() = "HTTP/1.1";
+        m_response.statusCode() = HTTPResponse::StatusCode::InternalServerError;
+
+        isStreamed = false;
+        hasContentLength = false;
+        hasConnection = false;
+        keepAlive = false;
+    }
+
+    bool isChunked = isStreamed &&
+                     !m_streamFinished &&
+                     !hasContentLength &&
+                     m_chunkedAllowed;
+
+    // Without chunked encoding body of unknown
+    // length ends with connection
+    if (isStreamed && !m_streamFinished && !hasContentLength && !isChunked)
+    {
+        keepAlive = false;
+    }
+
+    m_keepAlive = keepAlive;
+
+    // Head is written with single pass into
+    // buffer, that keeps capacity between responses
+    m_outputBuffer.clear();
+
+    ResponseWriter writer(m_outputBuffer);
+
+    writer.writeStatusLine(m_response.version(), m_response.statusCode());
+    writer.writeHeader(m_response.header());
+
+    if (isChunked)
+    {
+        m_streamFraming = StreamFraming::Chunked;
+
+        writer.writeField("Transfer-Encoding", "chunked");
+        frameStreamPart();
+    }
+    else if (!hasContentLength && (!isStreamed || m_streamFinished) &&
+             !(headOnly && m_response.stream() != nullptr))
+    {
+        char contentLength[24];
+
+        auto result = std::to_chars(
+            std::begin(contentLength),
+            std::end(contentLength),
+            isStreamed ? streamPartSize() : m_response.contentLength()
+        );
+
+        writer.writeField("Content-Length", std::string_view(contentLength, result.ptr - contentLength));
+    }
+
+    if (!hasConnection)
+    {
+        writer.writeField("Connection", keepAlive ? "keep-alive" : "close");
+    }
+
+    writer.writeEnd();
+
+    // Header of response to HEAD describes body,
+    // that is not sent
+    if (headOnly)
+    {
+        m_response.setData(nullptr, 0);
+    }
+
+    m_sent = 0;
+}
+
+void HTTPConnection::setRawResponse(const std::byte* data, std::size_t size)
+{
+    m_response = HTTPResponse(&m_arena);
+
+    m_streamBuffer.clear();
+    m_streamBegin = 0;
+    m_streamSent = 0;
+    m_streamFinished = false;
+    m_streamFraming = StreamFraming::Identity;
+
+    m_keepAlive = false;
+
+    m_outputBuffer.assign(data, data + size);
+    m_sent = 0;
+}
+
+bool HTTPConnection::writePending()
+{
+    while (!isOutputFinished())
+    {
+        iovec buffers[2];
+
+        // Head and data are sent with single call
+        auto count = pendingOutput(buffers);
+
+        ssize_t currentlySent;
+
+        if (count == 0)
+        {
+            // Body stream failed
+            if (!hasFileOutput())
+            {
+                return false;
+            }
+
+            auto bodySent = m_sent - m_outputBuffer.size();
+            auto offset = static_cast<off_t>(m_response.fileOffset() + bodySent);
+
+            currentlySent = SocketTools::SendFile(
+                m_socket,
+                m_response.fileDescriptor(),
+                offset,
+                m_response.fileSize() - bodySent
+            );
+
+            // File was truncated after response was formed
+            if (currentlySent == 0)
+            {
+                HTTPLog::write(FileEndSite);
+                return false;
+            }
+        }
+        else
+        {
+            // Head is merged with following file data
+            currentlySent = SocketTools::SendVector(
+                m_socket,
+                buffers,
+                count,
+                hasFileOutput() ? MSG_NOSIGNAL | MSG_MORE : MSG_NOSIGNAL
+            );
+        }
+
+        if (currentlySent == -1)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return true;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            HTTPLog::write(SendErrorSite, strerror(errno));
+            return false;
+        }
+
+        outputSent(static_cast<std::size_t>(currentlySent));
+    }
+
+    return true;
+}
+
+int HTTPConnection::pendingOutput(iovec* buffers)
+{
+    auto headSize = m_outputBuffer.size();
+    int count = 0;
+
+    if (m_sent < headSize)
+    {
+        buffers[count].iov_base = m_outputBuffer.data() + m_sent;
+        buffers[count].iov_len = headSize - m_sent;
+        ++count;
+    }
+
+    if (m_response.stream() != nullptr)
+    {
+        // Next part is written, when current
+        // one is sent
+        if (m_sent >= headSize + m_streamSent + streamPartSize() && !m_streamFinished)
+        {
+            m_streamSent += streamPartSize();
+
+            if (!readStream())
+            {
+                return 0;
+            }
+
+            if (m_streamFraming == StreamFraming::Chunked)
+            {
+                frameStreamPart();
+            }
+        }
+
+        auto partSent = m_sent > headSize + m_streamSent ? m_sent - headSize - m_streamSent : 0;
+
+        if (partSent < streamPartSize())
+        {
+            buffers[count].iov_base = m_streamBuffer.data() + m_streamBegin + partSent;
+            buffers[count].iov_len = streamPartSize() - partSent;
+            ++count;
+        }
+    }
+    else if (!hasFileOutput() && m_response.dataSize() > 0)
+    {
+        // Skipping already sent part
+        auto dataSent = m_sent > headSize ? m_sent - headSize : 0;
+
+        if (dataSent < m_response.dataSize())
+        {
+            buffers[count].iov_base = m_response.data() + dataSent;
+            buffers[count].iov_len = m_response.dataSize() - dataSent;
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+bool HTTPConnection::isLastOutputPending() const
+{
+    return m_response.stream() == nullptr || m_streamFinished;
+}
+
+void HTTPConnection::outputSent(std::size_t size)
+{
+    m_sent += size;
+    m_bytesSent += size;
+}
+
+bool HTTPConnection::hasFileOutput() const
+{
+    return m_response.fileDescriptor() != -1;
+}
+
+socket_t HTTPConnection::releaseSocket()
+{
+    auto socket = m_socket;
+
+    m_socket = INVALID_SOCKET;
+
+    return socket;
+}
+
+bool HTTPConnection::isOutputFinished() const
+{
+    if (m_response.stream() != nullptr)
+    {
+        return m_streamFinished &&
+               m_sent >= m_outputBuffer.size() + m_streamSent + streamPartSize();
+    }
+
+    return m_sent >= m_outputBuffer.size() + m_response.contentLength();
+}
+
+bool HTTPConnection::isKeepAlive() const
+{
+    return m_keepAlive;
+}
+
+std::size_t HTTPConnection::requestsCount() const
+{
+    return m_requestsCount;
+}
+
+void HTTPConnection::reset()
+{
+    // Moving pipelined bytes to buffer start
+    std::copy(
+        m_inputBuffer.begin() + m_requestSize,
+        m_inputBuffer.begin() + m_received,
+        m_inputBuffer.begin()
+    );
+
+    m_received -= m_requestSize;
+    m_requestSize = 0;
+
+    m_inputState = InputState::Header;
+    m_request = HTTPRequest(&m_arena);
+
+    m_bodyFraming = BodyFraming::None;
+    m_bodyRemaining = 0;
+    m_bodyOffset = 0;
+    m_bodySize = 0;
+    m_bodyTotal = 0;
+    m_rawPosition = 0;
+    m_bodyHandler.reset();
+    m_bodyAborted = false;
+
+    m_response = HTTPResponse(&m_arena);
+    m_outputBuffer.clear();
+    m_sent = 0;
+
+    m_streamBuffer.clear();
+    m_streamBegin = 0;
+    m_streamSent = 0;
+    m_streamFinished = false;
+    m_streamFraming = StreamFraming::Identity;
+    m_chunkedAllowed = false;
+
+    // Nothing is allocated from arena now
+    m_arena.reset();
+
+    m_state = State::Reading;
+    ++m_requestsCount;
+
+    // Deadline of next request is counted
+    // from end of current response
+    m_timeout = Timeout::None;
+
+    proceedInput();
+}
+
+bool HTTPConnection::readStream()
+{
+    m_streamBuffer.resize(ChunkSizeSpace);
+    m_streamBegin = ChunkSizeSpace;
+
+    bool hasMore = true;
+
+    try
+    {
+        // Empty part is skipped, because empty
+        // chunk terminates chunked body
+        while (hasMore && m_streamBuffer.size() == ChunkSizeSpace)
+        {
+            hasMore = m_response.stream()->write(m_streamBuffer, StreamPartSize);
+        }
+    }
+    catch (std::exception& exception)
+    {
+        HTTPLog::write(StreamErrorSite, exception.what());
+        return false;
+    }
+
+    m_streamFinished = !hasMore;
+
+    return true;
+}
+
+void HTTPConnection::frameStreamPart()
+{
+    auto size = m_streamBuffer.size() - ChunkSizeSpace;
+
+    if (size > 0)
+    {
+        char chunkSize[ChunkSizeSpace];
+
+        auto result = std::to_chars(std::begin(chunkSize), std::end(chunkSize), size, 16);
+
+        *result.ptr++ = '\r';
+        *result.ptr++ = '\n';
+
+        auto length = static_cast<std::size_t>(result.ptr - chunkSize);
+
+        m_streamBegin = ChunkSizeSpace - length;
+
+        std::memcpy(m_streamBuffer.data() + m_streamBegin, chunkSize, length);
+
+        auto* end = reinterpret_cast<const std::byte*>("\r\n");
+
+        m_streamBuffer.insert(m_streamBuffer.end(), end, end + 2);
+    }
+
+    if (m_streamFinished)
+    {
+        auto* end = reinterpret_cast<const std::byte*>(LastChunk.data());
+
+        m_streamBuffer.insert(m_streamBuffer.end(), end, end + LastChunk.size());
+    }
+}
+
+std::size_t HTTPConnection::streamPartSize() const
+{
+    return m_streamBuffer.size() - m_streamBegin;
+}
+
+void HTTPConnection::takeTraffic(uint64_t& received, uint64_t& sent)
+{
+    received = m_bytesReceived;
+    sent = m_bytesSent;
+
+    m_bytesReceived = 0;
+    m_bytesSent = 0;
+}
+
+void HTTPConnection::setAdmitted(bool admitted)
+{
+    m_admitted = admitted;
+}
+
+bool HTTPConnection::isAdmitted() const
+{
+    return m_admitted;
+}
+
+bool HTTPConnection::isRequestStarted() const
+{
+    return m_inputState != InputState::Header || m_received > 0;
+}
+
+bool HTTPConnection::isBodyExpected() const
+{
+    return m_inputState == InputState::Body;
+}
+
+HTTPTimerWheel::Timer& HTTPConnection::timer()
+{
+    return m_timer;
+}
+
+HTTPConnection::Timeout HTTPConnection::timeout() const
+{
+    return m_timeout;
+}
+
+void HTTPConnection::setTimeout(HTTPConnection::Timeout timeout)
+{
+    m_timeout = timeout;
+}
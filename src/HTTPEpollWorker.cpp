@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <sys/epoll.h>
+#include <CurrentLogger.hpp>
+#include <Tools/SocketTools.hpp>
+#include "HTTPEpollWorker.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of connections.
+ */
+static const HTTPLog::Site ConnectionSite{HTTPLog::Level::Info, "Received connection from {}", 1, 100};
+static const HTTPLog::Site WrongRequestSite{HTTPLog::Level::Warning, "Wrong request received from {}", 1, 10};
+static const HTTPLog::Site AcceptErrorSite{HTTPLog::Level::Warning, "Can't accept new connection. Error: {}", 1, 10};
+
+/**
+ * @brief Maximum number of events, received
+ * with single `epoll_wait` call.
+ */
+static constexpr int MaxEvents = 256;
+
+/**
+ * @brief Maximum time of `epoll_wait` call in
+ * milliseconds, so timers are expired in time.
+ */
+static constexpr int WaitInterval = static_cast<int>(HTTPTimerWheel::TickDuration.count());
+
+HTTPEpollWorker::HTTPEpollWorker(HTTPServer& server) :
+    HTTPWorker(server),
+    m_recvSocket(INVALID_SOCKET),
+    m_epoll(-1),
+    m_acceptBatchSize(1),
+    m_acceptPaused(false),
+    m_nextTick(),
+    m_connections()
+{
+
+}
+
+HTTPEpollWorker::~HTTPEpollWorker()
+{
+    m_connections.clear();
+
+    if (m_epoll != -1)
+    {
+        SocketTools::Close(m_epoll);
+    }
+
+    if (m_recvSocket != INVALID_SOCKET)
+    {
+        SocketTools::Close(m_recvSocket);
+    }
+}
+
+bool HTTPEpollWorker::initialize(uint32_t address, uint16_t port, const HTTPServerOptions& options)
+{
+    m_recvSocket = createListener(address, port, options);
+
+    if (m_recvSocket == INVALID_SOCKET)
+    {
+        return false;
+    }
+
+    m_acceptBatchSize = std::max(options.acceptBatchSize, std::size_t(1));
+
+    m_epoll = epoll_create1(0);
+
+    if (m_epoll == -1)
+    {
+        Error() << "Can't create epoll instance. Error: " << strerror(errno);
+        closeSocket();
+        return false;
+    }
+
+    // Listening socket is level triggered, so
+    // connections, that are left by accept batch,
+    // are reported by next wait
+    epoll_event event{0};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_recvSocket, &event) == -1)
+    {
+        Error() << "Can't register socket in epoll. Error: " << strerror(errno);
+        closeSocket();
+        return false;
+    }
+
+    if (!m_executor.initialize())
+    {
+        Error() << "Can't create executor descriptors. Error: " << strerror(errno);
+        closeSocket();
+        return false;
+    }
+
+    // Executor descriptors are drained by executor,
+    // so they are level triggered
+    event.events = EPOLLIN;
+    event.data.ptr = &m_executor;
+
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_executor.postDescriptor(), &event) == -1 ||
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_executor.timerDescriptor(), &event) == -1)
+    {
+        Error() << "Can't register executor in epoll. Error: " << strerror(errno);
+        closeSocket();
+        return false;
+    }
+
+    return true;
+}
+
+void HTTPEpollWorker::exec()
+{
+    blockPipeSignal();
+
+    m_executor.attach();
+
+    epoll_event events[MaxEvents];
+
+    while (true) // Endless loop
+    {
+        auto count = epoll_wait(m_epoll, events, MaxEvents, WaitInterval);
+
+        if (count == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            Error() << "Can't wait for events. Error: " << strerror(errno);
+            return;
+        }
+
+        bool executorReady = false;
+
+        for (int i = 0; i < count; ++i)
+        {
+            // Listening socket is registered with null pointer
+            if (events[i].data.ptr == nullptr)
+            {
+                if (!acceptConnections())
+                {
+                    return;
+                }
+
+                continue;
+            }
+
+            if (events[i].data.ptr == &m_executor)
+            {
+                executorReady = true;
+                continue;
+            }
+
+            auto* connection = static_cast<HTTPConnection*>(events[i].data.ptr);
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP))
+            {
+                // Request is used by suspended handler,
+                // so connection is closed after response
+                if (connection->state() == HTTPConnection::State::Handling)
+                {
+                    connection->setPeerClosed();
+                    continue;
+                }
+
+                closeConnection(*connection);
+                continue;
+            }
+
+            proceedConnection(*connection);
+        }
+
+        // Resumed handlers may close connections, so
+        // executor runs after their events are handled
+        if (executorReady)
+        {
+            m_executor.proceed();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+
+        if (now >= m_nextTick)
+        {
+            m_nextTick = now + HTTPTimerWheel::TickDuration;
+
+            if (m_acceptPaused && !setAcceptEnabled(true))
+            {
+                return;
+            }
+        }
+
+        proceedTimeouts(now);
+    }
+}
+
+bool HTTPEpollWorker::acceptConnections()
+{
+    for (std::size_t i = 0; i < m_acceptBatchSize; ++i)
+    {
+        sockaddr_in client{0};
+        socklen_t len = sizeof(client);
+
+        socket_t clientSocket = accept4(
+            m_recvSocket,
+            (sockaddr*) &client,
+            &len,
+            SOCK_NONBLOCK | SOCK_CLOEXEC
+        );
+
+        if (clientSocket == INVALID_SOCKET)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return true;
+            }
+
+            // Connection was aborted before accepting
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                HTTPLog::write(AcceptErrorSite, strerror(errno));
+                return true;
+            }
+
+            // Process is out of descriptors. Listening
+            // socket stays ready, so accepting is paused
+            // until next tick instead of busy loop.
+            if (errno == EMFILE || errno == ENFILE)
+            {
+                HTTPLog::write(AcceptErrorSite, strerror(errno));
+                return setAcceptEnabled(false);
+            }
+
+            Error() << "Can't accept new connection. Error: " << strerror(errno);
+            return false;
+        }
+
+        if (!admitConnection(clientSocket, client, m_connections.size()))
+        {
+            continue;
+        }
+
+        auto connection = std::make_unique<HTTPConnection>(clientSocket, client);
+
+        epoll_event event{0};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = connection.get();
+
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, clientSocket, &event) == -1)
+        {
+            Error() << "Can't register client socket. Error: " << strerror(errno);
+            continue;
+        }
+
+        HTTPLog::write(ConnectionSite, client);
+
+        recordAccepted();
+
+        connection->timer().data = static_cast<uint64_t>(clientSocket);
+        updateTimeout(*connection);
+
+        m_connections[clientSocket] = std::move(connection);
+    }
+
+    return true;
+}
+
+bool HTTPEpollWorker::setAcceptEnabled(bool enabled)
+{
+    epoll_event event{0};
+    event.events = enabled ? static_cast<uint32_t>(EPOLLIN) : 0u;
+    event.data.ptr = nullptr;
+
+    if (epoll_ctl(m_epoll, EPOLL_CTL_MOD, m_recvSocket, &event) == -1)
+    {
+        Error() << "Can't modify listening socket events. Error: " << strerror(errno);
+        return false;
+    }
+
+    m_acceptPaused = !enabled;
+
+    return true;
+}
+
+void HTTPEpollWorker::proceedConnection(HTTPConnection& connection)
+{
+    while (true)
+    {
+        switch (connection.state())
+        {
+        case HTTPConnection::State::Reading:
+            if (!connection.readAvailable())
+            {
+                closeConnection(connection);
+                return;
+            }
+
+            if (connection.isRequestMalformed())
+            {
+                HTTPLog::write(WrongRequestSite, connection.address());
+                proceedError(connection, connection.requestError());
+                break;
+            }
+
+            if (connection.isHeaderReceived())
+            {
+                proceedBody(connection);
+                break;
+            }
+
+            if (!connection.isRequestReceived())
+            {
+                if (connection.isPeerClosed())
+                {
+                    closeConnection(connection);
+                    return;
+                }
+
+                // Waiting for more data
+                updateTimeout(connection);
+                return;
+            }
+
+            proceedHandling(connection, [this, &connection]
+            {
+                proceedConnection(connection);
+            });
+            break;
+
+        case HTTPConnection::State::Writing:
+            if (!connection.writePending())
+            {
+                closeConnection(connection);
+                return;
+            }
+
+            if (!connection.isOutputFinished())
+            {
+                // Waiting for EPOLLOUT
+                updateTimeout(connection);
+                return;
+            }
+
+            if (!connection.isKeepAlive())
+            {
+                closeConnection(connection);
+                return;
+            }
+
+            finishRequest(connection);
+
+            // Next request may be already received, or
+            // it's readiness edge was consumed while writing
+            connection.reset();
+            break;
+
+        case HTTPConnection::State::Handling:
+            updateTimeout(connection);
+            return;
+        }
+    }
+}
+
+void HTTPEpollWorker::proceedTimeouts(std::chrono::steady_clock::time_point now)
+{
+    m_timers.advance(now, [this](HTTPTimerWheel::Timer& timer)
+    {
+        auto iterator = m_connections.find(static_cast<socket_t>(timer.data));
+
+        if (iterator == m_connections.end())
+        {
+            return;
+        }
+
+        auto& connection = *iterator->second;
+
+        if (!proceedTimeout(connection))
+        {
+            closeConnection(connection);
+            return;
+        }
+
+        proceedConnection(connection);
+    });
+}
+
+void HTTPEpollWorker::closeConnection(HTTPConnection& connection)
+{
+    releaseConnection(connection);
+
+    // Closing descriptor removes it from epoll set
+    m_connections.erase(connection.socket());
+}
+
+void HTTPEpollWorker::closeSocket()
+{
+    SocketTools::Close(m_recvSocket);
+    m_recvSocket = INVALID_SOCKET;
+}
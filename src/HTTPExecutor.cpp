@@ -0,0 +1,240 @@
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "HTTPExecutor.hpp"
+
+/**
+ * @brief Executor of calling worker thread.
+ */
+static thread_local HTTPExecutor* currentExecutor = nullptr;
+
+HTTPExecutor::ScheduleAwaiter::ScheduleAwaiter(HTTPExecutor& executor) :
+    m_executor(executor)
+{
+
+}
+
+bool HTTPExecutor::ScheduleAwaiter::await_ready() const noexcept
+{
+    // Coroutine is already at executor thread
+    return currentExecutor == &m_executor;
+}
+
+void HTTPExecutor::ScheduleAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    m_executor.post([handle] { handle.resume(); });
+}
+
+void HTTPExecutor::ScheduleAwaiter::await_resume() const noexcept
+{
+
+}
+
+HTTPExecutor::SleepAwaiter::SleepAwaiter(HTTPExecutor& executor, Clock::time_point deadline) :
+    m_executor(executor),
+    m_deadline(deadline)
+{
+
+}
+
+bool HTTPExecutor::SleepAwaiter::await_ready() const noexcept
+{
+    return m_deadline <= Clock::now();
+}
+
+void HTTPExecutor::SleepAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    m_executor.addTimer(m_deadline, handle);
+}
+
+void HTTPExecutor::SleepAwaiter::await_resume() const noexcept
+{
+
+}
+
+HTTPExecutor::HTTPExecutor() :
+    m_postDescriptor(-1),
+    m_timerDescriptor(-1),
+    m_postedMutex(),
+    m_posted(),
+    m_running(),
+    m_timers()
+{
+
+}
+
+HTTPExecutor::~HTTPExecutor()
+{
+    if (currentExecutor == this)
+    {
+        currentExecutor = nullptr;
+    }
+
+    if (m_postDescriptor != -1)
+    {
+        close(m_postDescriptor);
+    }
+
+    if (m_timerDescriptor != -1)
+    {
+        close(m_timerDescriptor);
+    }
+}
+
+HTTPExecutor* HTTPExecutor::current()
+{
+    return currentExecutor;
+}
+
+bool HTTPExecutor::initialize()
+{
+    m_postDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_postDescriptor == -1)
+    {
+        return false;
+    }
+
+    // steady_clock is CLOCK_MONOTONIC
+    m_timerDescriptor = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    return m_timerDescriptor != -1;
+}
+
+void HTTPExecutor::attach()
+{
+    currentExecutor = this;
+}
+
+int HTTPExecutor::postDescriptor() const
+{
+    return m_postDescriptor;
+}
+
+int HTTPExecutor::timerDescriptor() const
+{
+    return m_timerDescriptor;
+}
+
+void HTTPExecutor::post(std::function<void()> function)
+{
+    bool wakeup;
+
+    {
+        std::lock_guard<std::mutex> lock(m_postedMutex);
+
+        // Executor is woken only once for
+        // all functions, posted before proceed
+        wakeup = m_posted.empty();
+
+        m_posted.push_back(std::move(function));
+    }
+
+    if (wakeup)
+    {
+        uint64_t value = 1;
+
+        while (write(m_postDescriptor, &value, sizeof(value)) == -1 && errno == EINTR)
+        {
+
+        }
+    }
+}
+
+HTTPExecutor::ScheduleAwaiter HTTPExecutor::schedule()
+{
+    return ScheduleAwaiter(*this);
+}
+
+HTTPExecutor::SleepAwaiter HTTPExecutor::sleep(Clock::duration duration)
+{
+    return SleepAwaiter(*this, Clock::now() + duration);
+}
+
+void HTTPExecutor::proceed()
+{
+    uint64_t value;
+
+    // Descriptors are drained, so level triggered
+    // readiness is reset
+    while (read(m_postDescriptor, &value, sizeof(value)) == -1 && errno == EINTR)
+    {
+
+    }
+
+    while (read(m_timerDescriptor, &value, sizeof(value)) == -1 && errno == EINTR)
+    {
+
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_postedMutex);
+
+        m_running.swap(m_posted);
+    }
+
+    // Functions, posted while running, are
+    // run at next call
+    for (auto&& function : m_running)
+    {
+        function();
+    }
+
+    m_running.clear();
+
+    auto now = Clock::now();
+    bool expired = false;
+
+    while (!m_timers.empty() && m_timers.top().deadline <= now)
+    {
+        auto handle = m_timers.top().handle;
+
+        m_timers.pop();
+
+        expired = true;
+
+        handle.resume();
+    }
+
+    if (expired)
+    {
+        armTimer();
+    }
+}
+
+void HTTPExecutor::addTimer(Clock::time_point deadline, std::coroutine_handle<> handle)
+{
+    bool nearest = m_timers.empty() || deadline < m_timers.top().deadline;
+
+    m_timers.push(Timer{deadline, handle});
+
+    if (nearest)
+    {
+        armTimer();
+    }
+}
+
+void HTTPExecutor::armTimer()
+{
+    itimerspec spec{};
+
+    if (!m_timers.empty())
+    {
+        auto since = m_timers.top().deadline.time_since_epoch();
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since);
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(since - seconds);
+
+        spec.it_value.tv_sec = seconds.count();
+        spec.it_value.tv_nsec = nanoseconds.count();
+
+        // Zero value disarms timer
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+        {
+            spec.it_value.tv_nsec = 1;
+        }
+    }
+
+    timerfd_settime(m_timerDescriptor, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
@@ -1,11 +1,268 @@
 #include <map>
-#include <CurrentLogger.hpp>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <Tools/ScanTools.hpp>
 #include "HTTPHeader.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of malformed headers.
+ */
+static const HTTPLog::Site NewlineSite{HTTPLog::Level::Warning, "Can't find newline after header line.", 1, 10};
+static const HTTPLog::Site SplitterSite{HTTPLog::Level::Warning, "Can't find header splitter.", 1, 10};
+
+/**
+ * @brief Canonical names of tokens. Order
+ * matches `HTTPHeader::Token`.
+ */
+static constexpr std::string_view TokenNames[] = {
+    "",
+    "Accept",
+    "Accept-Charset",
+    "Accept-Encoding",
+    "Accept-Language",
+    "Accept-Ranges",
+    "Age",
+    "Allow",
+    "Authorization",
+    "Cache-Control",
+    "Connection",
+    "Content-Disposition",
+    "Content-Encoding",
+    "Content-Language",
+    "Content-Length",
+    "Content-Location",
+    "Content-Range",
+    "Content-Type",
+    "Cookie",
+    "Date",
+    "DNT",
+    "ETag",
+    "Expect",
+    "Expires",
+    "Forwarded",
+    "From",
+    "Host",
+    "If-Match",
+    "If-Modified-Since",
+    "If-None-Match",
+    "If-Range",
+    "If-Unmodified-Since",
+    "Keep-Alive",
+    "Last-Modified",
+    "Location",
+    "Origin",
+    "Pragma",
+    "Range",
+    "Referer",
+    "Retry-After",
+    "Sec-Fetch-Dest",
+    "Sec-Fetch-Mode",
+    "Sec-Fetch-Site",
+    "Sec-Fetch-User",
+    "Server",
+    "Set-Cookie",
+    "TE",
+    "Trailer",
+    "Transfer-Encoding",
+    "Upgrade",
+    "Upgrade-Insecure-Requests",
+    "User-Agent",
+    "Vary",
+    "Via",
+    "WWW-Authenticate",
+    "X-Forwarded-For",
+    "X-Requested-With"
+};
+
+static_assert(
+    std::size(TokenNames) == static_cast<std::size_t>(HTTPHeader::Token::XRequestedWith) + 1,
+    "Every token has to have name."
+);
+
+static constexpr std::size_t TokenTableSize = 256;
+
+/**
+ * @brief Multiplicative hash of field name.
+ * Only length and 4 characters are used, case
+ * of letters is ignored. Collisions between
+ * well-known names are excluded by seed.
+ * @param name Not empty field name.
+ * @param seed Seed.
+ * @return Slot index in token table.
+ */
+static constexpr std::size_t hashName(std::string_view name, uint32_t seed)
+{
+    auto lower = [](char c)
+    {
+        return static_cast<uint64_t>(static_cast<uint8_t>(c) | 0x20u);
+    };
+
+    auto key = static_cast<uint64_t>(name.size() & 0xFF) |
+               (lower(name.front()) << 8) |
+               (lower(name[name.size() / 2]) << 16) |
+               (lower(name[name.size() - (name.size() > 1 ? 2 : 1)]) << 24) |
+               (lower(name.back()) << 32);
+
+    auto multiplier = (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull) | 1;
+
+    static_assert(TokenTableSize == 256, "Hash returns 8 bits.");
+
+    return static_cast<std::size_t>((key * multiplier) >> 56);
+}
+
+/**
+ * @brief Lowercase name of token, packed to
+ * 8-byte words, and mask with 0x20 at letter
+ * positions. Name of any case matches, if
+ * `(word | mask) == lower` for every word.
+ */
+struct TokenPattern
+{
+    uint64_t lower[4];
+    uint64_t mask[4];
+};
+
+/**
+ * @brief Perfect hash table of well-known names.
+ */
+struct TokenTable
+{
+    uint32_t seed;
+    HTTPHeader::Token slots[TokenTableSize];
+    TokenPattern patterns[std::size(TokenNames)];
+};
+
+/**
+ * @brief Function for building pattern of name.
+ * @param name Well-known name.
+ * @return Pattern.
+ */
+static constexpr TokenPattern buildTokenPattern(std::string_view name)
+{
+    TokenPattern pattern{};
+
+    for (std::size_t i = 0; i < name.size(); ++i)
+    {
+        auto shift = (std::endian::native == std::endian::little) ?
+                     (i % 8) * 8 :
+                     (7 - i % 8) * 8;
+
+        auto c = static_cast<uint8_t>(name[i]);
+        auto isLetter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+
+        pattern.lower[i / 8] |= static_cast<uint64_t>(isLetter ? (c | 0x20u) : c) << shift;
+        pattern.mask[i / 8] |= static_cast<uint64_t>(isLetter ? 0x20u : 0u) << shift;
+    }
+
+    return pattern;
+}
+
+/**
+ * @brief Function for searching seed, that
+ * places every well-known name to own slot.
+ * @return Table or table with `UINT32_MAX`
+ * seed, if there is no such seed.
+ */
+static constexpr TokenTable buildTokenTable()
+{
+    for (uint32_t seed = 1; seed < 65536; ++seed)
+    {
+        TokenTable table{seed, {}, {}};
+
+        bool collision = false;
+
+        for (std::size_t i = 1; i < std::size(TokenNames) && !collision; ++i)
+        {
+            auto& slot = table.slots[hashName(TokenNames[i], seed)];
+
+            collision = slot != HTTPHeader::Token::Unknown;
+
+            slot = static_cast<HTTPHeader::Token>(i);
+        }
+
+        if (!collision)
+        {
+            for (std::size_t i = 1; i < std::size(TokenNames); ++i)
+            {
+                table.patterns[i] = buildTokenPattern(TokenNames[i]);
+            }
+
+            return table;
+        }
+    }
+
+    return TokenTable{UINT32_MAX, {}, {}};
+}
 
-HTTPHeader::HTTPHeader() :
-    m_headers()
+static constexpr TokenTable Tokens = buildTokenTable();
+
+static_assert(Tokens.seed != UINT32_MAX, "Can't build perfect hash of well-known names.");
+
+static_assert(
+    std::all_of(
+        std::begin(TokenNames),
+        std::end(TokenNames),
+        [](std::string_view name) { return name.size() <= sizeof(TokenPattern::lower); }
+    ),
+    "Well-known name is too long for pattern."
+);
+
+/**
+ * @brief Function for matching name with
+ * pattern of token.
+ * @param name Field name.
+ * @param token Token with same length of name.
+ * @return Does name match.
+ */
+static bool matchToken(std::string_view name, HTTPHeader::Token token)
 {
+    auto& pattern = Tokens.patterns[static_cast<std::size_t>(token)];
+
+    std::size_t offset = 0;
+
+    for (; offset + 8 <= name.size(); offset += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, name.data() + offset, sizeof(word));
+
+        if ((word | pattern.mask[offset / 8]) != pattern.lower[offset / 8])
+        {
+            return false;
+        }
+    }
+
+    if (offset == name.size())
+    {
+        return true;
+    }
+
+    // Last bytes are placed as in memory
+    uint8_t tail[8] = {};
+
+    for (std::size_t i = offset; i < name.size(); ++i)
+    {
+        tail[i - offset] = static_cast<uint8_t>(name[i]);
+    }
+
+    uint64_t word;
+    std::memcpy(&word, tail, sizeof(word));
 
+    return (word | pattern.mask[offset / 8]) == pattern.lower[offset / 8];
+}
+
+HTTPHeader::HTTPHeader(std::pmr::memory_resource* resource) :
+    m_headers(resource),
+    m_tokens(resource)
+{
+
+}
+
+std::pmr::memory_resource* HTTPHeader::memoryResource() const
+{
+    return m_headers.get_allocator().resource();
 }
 
 unsigned long HTTPHeader::numberOfHeaders() const
@@ -23,77 +280,186 @@ HTTPHeader::HeaderType& HTTPHeader::header(HeadersContainer::size_type index)
     return m_headers[index];
 }
 
+HTTPHeader::Token HTTPHeader::token(HeadersContainer::size_type index) const
+{
+    return m_tokens[index];
+}
+
+const HTTPHeader::HeaderType* HTTPHeader::find(std::string_view name) const
+{
+    auto token = tokenize(name);
+
+    if (token != Token::Unknown)
+    {
+        return find(token);
+    }
+
+    // Unknown names are compared as strings
+    for (HeadersContainer::size_type i = 0; i < m_headers.size(); ++i)
+    {
+        if (m_tokens[i] == Token::Unknown &&
+            equalsIgnoreCase(m_headers[i].first, name))
+        {
+            return &m_headers[i];
+        }
+    }
+
+    return nullptr;
+}
+
+const HTTPHeader::HeaderType* HTTPHeader::find(HTTPHeader::Token token) const
+{
+    if (token == Token::Unknown)
+    {
+        return nullptr;
+    }
+
+    for (HeadersContainer::size_type i = 0; i < m_tokens.size(); ++i)
+    {
+        if (m_tokens[i] == token)
+        {
+            return &m_headers[i];
+        }
+    }
+
+    return nullptr;
+}
+
+std::string_view HTTPHeader::get(std::string_view name, std::string_view defaultValue) const
+{
+    auto* header = find(name);
+
+    return header ? header->second : defaultValue;
+}
+
+std::string_view HTTPHeader::get(HTTPHeader::Token token, std::string_view defaultValue) const
+{
+    auto* header = find(token);
+
+    return header ? header->second : defaultValue;
+}
+
 void HTTPHeader::addHeader(HTTPHeader::HeaderType header)
 {
+    m_tokens.push_back(tokenize(header.first));
     m_headers.push_back(std::move(header));
 }
 
 void HTTPHeader::insertHeader(HTTPHeader::HeaderType header, HeadersContainer::size_type index)
 {
+    m_tokens.insert(m_tokens.begin() + index, tokenize(header.first));
     m_headers.insert(m_headers.begin() + index, std::move(header));
 }
 
 void HTTPHeader::removeHeader(HeadersContainer::size_type index)
 {
+    m_tokens.erase(m_tokens.begin() + index);
     m_headers.erase(m_headers.begin() + index);
 }
 
 void HTTPHeader::clear()
 {
+    m_tokens.clear();
     m_headers.clear();
 }
 
+void HTTPHeader::reserve(HeadersContainer::size_type count)
+{
+    m_tokens.reserve(count);
+    m_headers.reserve(count);
+}
+
+HTTPHeader::Token HTTPHeader::tokenize(std::string_view name)
+{
+    if (name.empty())
+    {
+        return Token::Unknown;
+    }
+
+    auto token = Tokens.slots[hashName(name, Tokens.seed)];
+
+    // Slot may be taken by other name with same hash
+    if (token == Token::Unknown ||
+        TokenNames[static_cast<std::size_t>(token)].size() != name.size() ||
+        !matchToken(name, token))
+    {
+        return Token::Unknown;
+    }
+
+    return token;
+}
+
+std::string_view HTTPHeader::tokenName(HTTPHeader::Token token)
+{
+    return TokenNames[static_cast<std::size_t>(token)];
+}
+
+bool HTTPHeader::equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    auto lower = [](char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    };
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        if (lower(a[i]) != lower(b[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool HTTPHeader::parse(std::byte* bytes, std::size_t size, std::size_t* finish)
 {
-    // Searching for method end
-    std::size_t prevIterator = 0;
     std::size_t iterator = 0;
 
     // Parsing headers
     while (iterator < size)
     {
-//        std::cout << "I: " << iterator << ", S: " << size << std::endl;
-        // Searching for ": "
-        for (;
-             iterator < size - 1 &&
-               (bytes[iterator    ] != static_cast<std::byte>(':') ||
-                bytes[iterator + 1] != static_cast<std::byte>(' '));
-               ++iterator);
+        const std::byte* colon;
+
+        // Searching for newline and ":" with single pass
+        auto* lineFeed = ScanTools::FindLineFeed(bytes + iterator, bytes + size, &colon);
 
-        if (iterator >= size)
+        if (lineFeed == nullptr ||
+            lineFeed == bytes + iterator ||
+            *(lineFeed - 1) != static_cast<std::byte>(0x0D))
         {
-            Warning() << "Can't find header splitter.";
+            HTTPLog::write(NewlineSite);
             return false;
         }
 
-        // Receiving name
-        std::string_view parsedName(reinterpret_cast<const char*>(bytes + prevIterator), iterator - prevIterator);
+        std::string_view line(
+            reinterpret_cast<const char*>(bytes + iterator),
+            static_cast<std::size_t>(lineFeed - 1 - (bytes + iterator))
+        );
 
-        // Ok, name parsed
-        iterator += 2; // ": "
-        prevIterator = iterator;
+        // Searching for ": "
+        auto splitter = std::string_view::npos;
 
-        // Searching for newline
-        for (; iterator < size - 1 &&
-               (bytes[iterator    ] != static_cast<std::byte>(0x0D) ||
-                bytes[iterator + 1] != static_cast<std::byte>(0x0A));
-               ++iterator);
+        if (colon != nullptr)
+        {
+            splitter = line.find(": ", static_cast<std::size_t>(colon - (bytes + iterator)));
+        }
 
-        if (iterator >= size)
+        if (splitter == std::string_view::npos)
         {
-            Warning() << "Can't find newline after header line.";
+            HTTPLog::write(SplitterSite);
             return false;
         }
 
-        // Receiving version
-        std::string_view parsedValue(reinterpret_cast<const char*>(bytes + prevIterator), iterator - prevIterator);
-
-        // Ok, version confirmed there
-        iterator += 2;
-        prevIterator = iterator;
-
         // Committing data
-        m_headers.emplace_back(parsedName, parsedValue);
+        addHeader({line.substr(0, splitter), line.substr(splitter + 2)});
+
+        iterator = static_cast<std::size_t>(lineFeed + 1 - bytes);
 
         // Is it headers finish?
         if (iterator + 2 <= size &&
@@ -154,7 +520,7 @@ std::size_t HTTPHeader::calculateSerializedSize() const
     return result;
 }
 
-void HTTPHeader::serialize(std::byte* buffer)
+std::byte* HTTPHeader::serialize(std::byte* buffer) const
 {
     for (auto&& header : m_headers)
     {
@@ -183,5 +549,7 @@ void HTTPHeader::serialize(std::byte* buffer)
 
     // CRLF
     *(buffer++) = static_cast<std::byte>('\r');
-     *buffer    = static_cast<std::byte>('\n');
+    *(buffer++) = static_cast<std::byte>('\n');
+
+    return buffer;
 }
@@ -0,0 +1,382 @@
+#include <arpa/inet.h>
+#include <CurrentLogger.hpp>
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Interval of background thread,
+ * while there are no records.
+ */
+static constexpr auto DrainInterval = std::chrono::milliseconds(10);
+
+/**
+ * @brief Size of argument header: type
+ * and size of bytes.
+ */
+static constexpr std::size_t ArgumentHeaderSize = 1 + sizeof(uint16_t);
+
+std::atomic<std::size_t> HTTPLog::s_sitesCount{0};
+
+/**
+ * @brief Function for writing record into current logger.
+ * @param level Record level.
+ * @param text Formatted record.
+ */
+static void defaultSink(HTTPLog::Level level, std::string_view text)
+{
+    switch (level)
+    {
+    case HTTPLog::Level::Info:
+        Info() << text;
+        break;
+
+    case HTTPLog::Level::Warning:
+        Warning() << text;
+        break;
+
+    case HTTPLog::Level::Error:
+        Error() << text;
+        break;
+    }
+}
+
+HTTPLog::Site::Site(HTTPLog::Level level, const char* format, uint32_t sampling, uint32_t rateLimit) :
+    level(level),
+    format(format),
+    sampling(sampling == 0 ? 1 : sampling),
+    rateLimit(rateLimit),
+    index(s_sitesCount.fetch_add(1, std::memory_order_relaxed))
+{
+
+}
+
+HTTPLog::RingHolder::~RingHolder()
+{
+    if (ring)
+    {
+        ring->closed.store(true, std::memory_order_release);
+    }
+}
+
+HTTPLog::HTTPLog() :
+    m_mutex(),
+    m_condition(),
+    m_rings(),
+    m_sink(&defaultSink),
+    m_drainMutex(),
+    m_dropped(0),
+    m_reportedDropped(0),
+    m_stopping(false),
+    m_thread()
+{
+    m_thread = std::thread(&HTTPLog::run, this);
+}
+
+HTTPLog::~HTTPLog()
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_condition.notify_one();
+    m_thread.join();
+
+    // Records of finished threads are
+    // written before exit
+    drain();
+}
+
+HTTPLog& HTTPLog::instance()
+{
+    static HTTPLog log;
+
+    return log;
+}
+
+void HTTPLog::setSink(HTTPLog::SinkFunction sink)
+{
+    auto& log = instance();
+
+    std::scoped_lock lock(log.m_drainMutex);
+
+    log.m_sink = sink ? std::move(sink) : SinkFunction(&defaultSink);
+}
+
+void HTTPLog::flush()
+{
+    instance().drain();
+}
+
+uint64_t HTTPLog::droppedCount()
+{
+    return instance().m_dropped.load(std::memory_order_relaxed);
+}
+
+HTTPLog::Record* HTTPLog::beginRecord(const HTTPLog::Site& site)
+{
+    auto& ring = threadRing();
+
+    if (site.index >= ring.sites.size())
+    {
+        ring.sites.resize(site.index + 1);
+    }
+
+    auto& state = ring.sites[site.index];
+
+    // Sampling and rate limit are counted by
+    // thread, so sites are not shared
+    if (state.count++ % site.sampling != 0)
+    {
+        ++state.skipped;
+        return nullptr;
+    }
+
+    if (site.rateLimit > 0)
+    {
+        auto now = std::chrono::steady_clock::now();
+
+        if (now - state.windowStart >= std::chrono::seconds(1))
+        {
+            state.windowStart = now;
+            state.windowCount = 0;
+        }
+
+        if (state.windowCount >= site.rateLimit)
+        {
+            ++state.skipped;
+            return nullptr;
+        }
+
+        ++state.windowCount;
+    }
+
+    auto head = ring.head.load(std::memory_order_relaxed);
+
+    if (head - ring.tail.load(std::memory_order_acquire) >= RingCapacity)
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto& record = ring.records[head % RingCapacity];
+
+    record.site = &site;
+    record.skipped = state.skipped;
+    record.size = 0;
+
+    state.skipped = 0;
+
+    return &record;
+}
+
+void HTTPLog::commitRecord()
+{
+    auto& ring = threadRing();
+
+    ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+HTTPLog::Ring& HTTPLog::threadRing()
+{
+    thread_local RingHolder holder;
+
+    if (!holder.ring)
+    {
+        holder.ring = std::make_shared<Ring>();
+
+        std::scoped_lock lock(m_mutex);
+        m_rings.push_back(holder.ring);
+    }
+
+    return *holder.ring;
+}
+
+void HTTPLog::run()
+{
+    std::unique_lock lock(m_mutex);
+
+    while (!m_stopping)
+    {
+        lock.unlock();
+
+        auto count = drain();
+
+        lock.lock();
+
+        // Writers never notify, so they don't make
+        // system calls. Rings are polled instead.
+        if (count == 0 && !m_stopping)
+        {
+            m_condition.wait_for(lock, DrainInterval);
+        }
+    }
+}
+
+std::size_t HTTPLog::drain()
+{
+    std::scoped_lock drainLock(m_drainMutex);
+
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    {
+        std::scoped_lock lock(m_mutex);
+        rings = m_rings;
+    }
+
+    std::size_t count = 0;
+    std::string text;
+
+    for (auto&& ring : rings)
+    {
+        // Closed flag is read before head, so records
+        // of finished thread are not missed
+        bool closed = ring->closed.load(std::memory_order_acquire);
+
+        auto tail = ring->tail.load(std::memory_order_relaxed);
+        auto head = ring->head.load(std::memory_order_acquire);
+
+        for (; tail != head; ++tail)
+        {
+            auto& record = ring->records[tail % RingCapacity];
+
+            text.clear();
+            format(record, text);
+
+            m_sink(record.site->level, text);
+
+            // Record may be reused by writer now
+            ring->tail.store(tail + 1, std::memory_order_release);
+
+            ++count;
+        }
+
+        if (closed)
+        {
+            std::scoped_lock lock(m_mutex);
+            std::erase(m_rings, ring);
+        }
+    }
+
+    auto dropped = m_dropped.load(std::memory_order_relaxed);
+
+    if (dropped != m_reportedDropped)
+    {
+        m_sink(
+            Level::Warning,
+            std::to_string(dropped - m_reportedDropped) + " log records were dropped, ring buffer is full."
+        );
+
+        m_reportedDropped = dropped;
+    }
+
+    return count;
+}
+
+void HTTPLog::format(const HTTPLog::Record& record, std::string& output)
+{
+    std::string_view format(record.site->format);
+    std::size_t position = 0;
+
+    while (true)
+    {
+        auto placeholder = format.find("{}");
+
+        output.append(format.substr(0, placeholder));
+
+        if (placeholder == std::string_view::npos)
+        {
+            break;
+        }
+
+        format.remove_prefix(placeholder + 2);
+
+        // Missing arguments are formatted as empty
+        if (position + ArgumentHeaderSize > record.size)
+        {
+            continue;
+        }
+
+        auto type = static_cast<ArgumentType>(record.data[position]);
+
+        uint16_t size;
+        std::memcpy(&size, record.data.data() + position + 1, sizeof(size));
+
+        const auto* data = record.data.data() + position + ArgumentHeaderSize;
+
+        position += ArgumentHeaderSize + size;
+
+        switch (type)
+        {
+        case ArgumentType::Signed:
+        {
+            int64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            output.append(std::to_string(value));
+            break;
+        }
+
+        case ArgumentType::Unsigned:
+        {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            output.append(std::to_string(value));
+            break;
+        }
+
+        case ArgumentType::String:
+            output.append(data, size);
+            break;
+
+        case ArgumentType::Address:
+        {
+            sockaddr_in address;
+            std::memcpy(&address, data, sizeof(address));
+
+            char buffer[INET_ADDRSTRLEN] = {0};
+            inet_ntop(AF_INET, &address.sin_addr, buffer, sizeof(buffer));
+
+            output.append(buffer).append(":").append(std::to_string(ntohs(address.sin_port)));
+            break;
+        }
+        }
+    }
+
+    if (record.skipped > 0)
+    {
+        output.append(" (")
+              .append(std::to_string(record.skipped))
+              .append(" similar records skipped)");
+    }
+}
+
+void HTTPLog::appendBytes(HTTPLog::Record& record, HTTPLog::ArgumentType type, const void* data, std::size_t size)
+{
+    auto available = record.data.size() - record.size;
+
+    if (available < ArgumentHeaderSize)
+    {
+        return;
+    }
+
+    available -= ArgumentHeaderSize;
+
+    // Only strings may be truncated
+    if (size > available)
+    {
+        if (type != ArgumentType::String)
+        {
+            return;
+        }
+
+        size = available;
+    }
+
+    auto length = static_cast<uint16_t>(size);
+    auto* output = record.data.data() + record.size;
+
+    output[0] = static_cast<char>(type);
+    std::memcpy(output + 1, &length, sizeof(length));
+    std::memcpy(output + ArgumentHeaderSize, data, size);
+
+    record.size += static_cast<uint32_t>(ArgumentHeaderSize + size);
+}
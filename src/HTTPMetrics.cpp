@@ -0,0 +1,361 @@
+#include <bit>
+#include <cstdio>
+#include <algorithm>
+#include "HTTPMetrics.hpp"
+
+/**
+ * @brief Route of request, handled by thread.
+ */
+static thread_local std::size_t CurrentRoute = 0;
+
+/**
+ * @brief Function for appending label value with
+ * escaped backslash, quote and line feed.
+ * @param output Output text.
+ * @param value Label value.
+ */
+static void appendLabel(std::string& output, std::string_view value)
+{
+    for (auto c : value)
+    {
+        switch (c)
+        {
+        case '\\':
+            output += "\\\\";
+            break;
+
+        case '"':
+            output += "\\\"";
+            break;
+
+        case '\n':
+            output += "\\n";
+            break;
+
+        default:
+            output += c;
+        }
+    }
+}
+
+/**
+ * @brief Function for appending nanoseconds
+ * as seconds.
+ * @param output Output text.
+ * @param value Value in nanoseconds.
+ */
+static void appendSeconds(std::string& output, uint64_t value)
+{
+    char buffer[32];
+
+    auto size = std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(value) / 1e9);
+
+    output.append(buffer, static_cast<std::size_t>(size));
+}
+
+/**
+ * @brief Function for appending metric description.
+ * @param output Output text.
+ * @param name Metric name.
+ * @param type Metric type.
+ * @param help Metric description.
+ */
+static void appendHeader(std::string& output,
+                         std::string_view name,
+                         std::string_view type,
+                         std::string_view help)
+{
+    output.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    output.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void HTTPMetrics::Histogram::record(uint64_t value)
+{
+    add(buckets[index(value)]);
+    add(sum, value);
+}
+
+std::size_t HTTPMetrics::Histogram::index(uint64_t value)
+{
+    if (value < (uint64_t(1) << MinMagnitude))
+    {
+        return 0;
+    }
+
+    auto magnitude = static_cast<unsigned>(std::bit_width(value)) - 1;
+
+    if (magnitude >= MaxMagnitude)
+    {
+        return BucketsCount - 1;
+    }
+
+    // Bits after highest one select sub bucket
+    auto subBucket = (value >> (magnitude - SubBucketBits)) & ((1u << SubBucketBits) - 1);
+
+    return 1 + (magnitude - MinMagnitude) * (1u << SubBucketBits) + subBucket;
+}
+
+uint64_t HTTPMetrics::Histogram::upperBound(std::size_t index)
+{
+    if (index == 0)
+    {
+        return uint64_t(1) << MinMagnitude;
+    }
+
+    auto magnitude = MinMagnitude + static_cast<unsigned>((index - 1) >> SubBucketBits);
+    auto subBucket = (index - 1) & ((1u << SubBucketBits) - 1);
+
+    return ((uint64_t(1) << SubBucketBits) + subBucket + 1) << (magnitude - SubBucketBits);
+}
+
+HTTPMetrics::Shard::Shard(std::size_t routesCount) :
+    routesCount(routesCount),
+    requests(std::make_unique<std::atomic<uint64_t>[]>(routesCount * MethodsCount)),
+    durations(std::make_unique<Histogram[]>(routesCount))
+{
+
+}
+
+void HTTPMetrics::Shard::recordRequest(HTTPRequest::Method method,
+                                       std::size_t route,
+                                       std::chrono::nanoseconds duration,
+                                       HTTPResponse::StatusCode code)
+{
+    // Route may be added after worker was started
+    if (route >= routesCount)
+    {
+        route = 0;
+    }
+
+    add(requests[route * MethodsCount + static_cast<std::size_t>(method)]);
+
+    durations[route].record(static_cast<uint64_t>(std::max(duration.count(), int64_t(0))));
+
+    recordStatus(code);
+}
+
+void HTTPMetrics::Shard::recordStatus(HTTPResponse::StatusCode code)
+{
+    auto index = static_cast<std::size_t>(code);
+
+    add(statusCodes[index < StatusCodesCount ? index : 0]);
+}
+
+void HTTPMetrics::Shard::recordTraffic(uint64_t received, uint64_t sent)
+{
+    if (received > 0)
+    {
+        add(bytesReceived, received);
+    }
+
+    if (sent > 0)
+    {
+        add(bytesSent, sent);
+    }
+}
+
+HTTPMetrics::HTTPMetrics() :
+    m_mutex(),
+    m_routes({""}),
+    m_shards()
+{
+
+}
+
+std::size_t HTTPMetrics::addRoute(std::string_view name)
+{
+    std::scoped_lock lock(m_mutex);
+
+    for (std::size_t i = 0; i < m_routes.size(); ++i)
+    {
+        if (m_routes[i] == name)
+        {
+            return i;
+        }
+    }
+
+    m_routes.emplace_back(name);
+
+    return m_routes.size() - 1;
+}
+
+HTTPMetrics::Shard& HTTPMetrics::createShard()
+{
+    std::scoped_lock lock(m_mutex);
+
+    m_shards.push_back(std::make_unique<Shard>(m_routes.size()));
+
+    return *m_shards.back();
+}
+
+std::string HTTPMetrics::serialize() const
+{
+    std::scoped_lock lock(m_mutex);
+
+    auto sum = [this](auto getter)
+    {
+        uint64_t result = 0;
+
+        for (auto&& shard : m_shards)
+        {
+            result += getter(*shard).load(std::memory_order_relaxed);
+        }
+
+        return result;
+    };
+
+    // Counter of route is summed only from shards,
+    // that were created after route was added
+    auto sumRoute = [this](std::size_t route, auto getter)
+    {
+        uint64_t result = 0;
+
+        for (auto&& shard : m_shards)
+        {
+            if (route < shard->routesCount)
+            {
+                result += getter(*shard).load(std::memory_order_relaxed);
+            }
+        }
+
+        return result;
+    };
+
+    std::string output;
+
+    appendHeader(output, "http_connections_accepted_total", "counter", "Accepted connections.");
+    output.append("http_connections_accepted_total ")
+          .append(std::to_string(sum([](const Shard& shard) -> auto& { return shard.connections; })))
+          .append("\n");
+
+    appendHeader(output, "http_received_bytes_total", "counter", "Bytes received from clients.");
+    output.append("http_received_bytes_total ")
+          .append(std::to_string(sum([](const Shard& shard) -> auto& { return shard.bytesReceived; })))
+          .append("\n");
+
+    appendHeader(output, "http_sent_bytes_total", "counter", "Bytes sent to clients.");
+    output.append("http_sent_bytes_total ")
+          .append(std::to_string(sum([](const Shard& shard) -> auto& { return shard.bytesSent; })))
+          .append("\n");
+
+    appendHeader(output, "http_requests_total", "counter", "Handled requests by method and route.");
+
+    for (std::size_t route = 0; route < m_routes.size(); ++route)
+    {
+        for (std::size_t method = 0; method < MethodsCount; ++method)
+        {
+            auto value = sumRoute(
+                route,
+                [index = route * MethodsCount + method](const Shard& shard) -> auto&
+                {
+                    return shard.requests[index];
+                }
+            );
+
+            if (value == 0)
+            {
+                continue;
+            }
+
+            output.append("http_requests_total{method=\"")
+                  .append(HTTPRequest::methodToString(static_cast<HTTPRequest::Method>(method)))
+                  .append("\",route=\"");
+
+            appendLabel(output, m_routes[route]);
+
+            output.append("\"} ").append(std::to_string(value)).append("\n");
+        }
+    }
+
+    appendHeader(output, "http_responses_total", "counter", "Sent responses by status code.");
+
+    for (std::size_t code = 0; code < StatusCodesCount; ++code)
+    {
+        auto value = sum([code](const Shard& shard) -> auto& { return shard.statusCodes[code]; });
+
+        if (value == 0)
+        {
+            continue;
+        }
+
+        output.append("http_responses_total{code=\"")
+              .append(std::to_string(code))
+              .append("\"} ")
+              .append(std::to_string(value))
+              .append("\n");
+    }
+
+    appendHeader(
+        output,
+        "http_handler_duration_seconds",
+        "histogram",
+        "Time of request handler by route."
+    );
+
+    for (std::size_t route = 0; route < m_routes.size(); ++route)
+    {
+        std::string labels = "route=\"";
+        appendLabel(labels, m_routes[route]);
+        labels += "\"";
+
+        uint64_t count = 0;
+
+        for (std::size_t i = 0; i < Histogram::BucketsCount; ++i)
+        {
+            count += sumRoute(
+                route,
+                [i, route](const Shard& shard) -> auto&
+                {
+                    return shard.durations[route].buckets[i];
+                }
+            );
+
+            output.append("http_handler_duration_seconds_bucket{").append(labels).append(",le=\"");
+
+            if (i + 1 == Histogram::BucketsCount)
+            {
+                output.append("+Inf");
+            }
+            else
+            {
+                appendSeconds(output, Histogram::upperBound(i));
+            }
+
+            output.append("\"} ").append(std::to_string(count)).append("\n");
+        }
+
+        auto total = sumRoute(
+            route,
+            [route](const Shard& shard) -> auto&
+            {
+                return shard.durations[route].sum;
+            }
+        );
+
+        output.append("http_handler_duration_seconds_sum{").append(labels).append("} ");
+        appendSeconds(output, total);
+        output.append("\n");
+
+        output.append("http_handler_duration_seconds_count{")
+              .append(labels)
+              .append("} ")
+              .append(std::to_string(count))
+              .append("\n");
+    }
+
+    return output;
+}
+
+void HTTPMetrics::setRoute(std::size_t route)
+{
+    CurrentRoute = route;
+}
+
+std::size_t HTTPMetrics::takeRoute()
+{
+    auto route = CurrentRoute;
+
+    CurrentRoute = 0;
+
+    return route;
+}
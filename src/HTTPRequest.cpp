@@ -1,60 +1,236 @@
-#include <map>
-#include <CurrentLogger.hpp>
+#include <bit>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <Tools/ScanTools.hpp>
 #include "HTTPRequest.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of malformed requests.
+ */
+static const HTTPLog::Site MethodSpaceSite{HTTPLog::Level::Warning, "Can't find space for method.", 1, 10};
+static const HTTPLog::Site UnknownMethodSite{HTTPLog::Level::Warning, "Unknown method \"{}\".", 1, 10};
+static const HTTPLog::Site EmptyUriSite{HTTPLog::Level::Warning, "Empty request uri.", 1, 10};
+static const HTTPLog::Site SplitterSite{HTTPLog::Level::Warning, "Can't find header splitter.", 1, 10};
+static const HTTPLog::Site HeaderNameSite{HTTPLog::Level::Warning, "Wrong header name \"{}\".", 1, 10};
+
+/**
+ * @brief Names of methods. Order matches
+ * `HTTPRequest::Method`.
+ */
+static constexpr std::string_view MethodNames[] = {
+    "None",
+    "OPTIONS",
+    "GET",
+    "HEAD",
+    "POST",
+    "PUT",
+    "PATCH",
+    "DELETE",
+    "TRACE",
+    "CONNECT"
+};
+
+static_assert(
+    std::size(MethodNames) == static_cast<std::size_t>(HTTPRequest::Method::CONNECT) + 1,
+    "Every method has to have name."
+);
+
+/**
+ * @brief Characters, allowed in token
+ * (RFC 7230 3.2.6).
+ */
+static constexpr std::array<bool, 256> TokenChars = []
+{
+    std::array<bool, 256> result{};
+
+    for (int c = '0'; c <= '9'; ++c)
+    {
+        result[c] = true;
+    }
+
+    for (int c = 'a'; c <= 'z'; ++c)
+    {
+        result[c] = true;
+        result[c - 'a' + 'A'] = true;
+    }
+
+    for (char c : std::string_view("!#$%&'*+-.^_`|~"))
+    {
+        result[static_cast<unsigned char>(c)] = true;
+    }
+
+    return result;
+}();
+
+/**
+ * @brief Function for packing string of up to
+ * 8 bytes to word. Bytes are placed as they lay
+ * in memory, so packed name equals to word,
+ * loaded by `loadWord`.
+ * @param name Name.
+ * @return Word.
+ */
+static constexpr uint64_t packWord(std::string_view name)
+{
+    uint64_t result = 0;
+
+    for (std::size_t i = 0; i < name.size() && i < 8; ++i)
+    {
+        auto shift = (std::endian::native == std::endian::little) ?
+                     i * 8 :
+                     (7 - i) * 8;
 
-static const std::map<std::string_view, HTTPRequest::Method> methods = {
-    {"OPTIONS", HTTPRequest::Method::OPTIONS},
-    {"GET",     HTTPRequest::Method::GET},
-    {"HEAD",    HTTPRequest::Method::HEAD},
-    {"POST",    HTTPRequest::Method::POST},
-    {"PUT",     HTTPRequest::Method::PUT},
-    {"PATCH",   HTTPRequest::Method::PATCH},
-    {"DELETE",  HTTPRequest::Method::DELETE},
-    {"TRACE",   HTTPRequest::Method::TRACE},
-    {"CONNECT", HTTPRequest::Method::CONNECT}
+        result |= static_cast<uint64_t>(static_cast<uint8_t>(name[i])) << shift;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for loading `Size` bytes
+ * to word. Compiles to fixed size loads.
+ * @param data Pointer to bytes.
+ * @return Word.
+ */
+template<std::size_t Size>
+static uint64_t loadWord(const char* data)
+{
+    static_assert(Size <= 8, "Word is 8 bytes.");
+
+    uint64_t result = 0;
+    std::memcpy(&result, data, Size);
+
+    return result;
+}
+
+/**
+ * @brief Packed method name.
+ */
+struct MethodWord
+{
+    std::size_t size;
+    uint64_t word;
+    HTTPRequest::Method method;
 };
 
-HTTPRequest::Method HTTPRequest::stringToMethod(const std::string_view& s)
+/**
+ * @brief Function for packing all method names.
+ * @return Packed names.
+ */
+static constexpr auto buildMethodWords()
 {
-    auto result = methods.find(s);
+    std::array<MethodWord, std::size(MethodNames) - 1> result{};
 
-    if (result == methods.end())
+    for (std::size_t i = 1; i < std::size(MethodNames); ++i)
     {
-        return HTTPRequest::Method::None;
+        result[i - 1] = MethodWord{
+            MethodNames[i].size(),
+            packWord(MethodNames[i]),
+            static_cast<HTTPRequest::Method>(i)
+        };
     }
 
-    return result->second;
+    return result;
+}
+
+static constexpr auto MethodWords = buildMethodWords();
+
+/**
+ * @brief Function for matching word with
+ * methods of length `Size`. Compares are
+ * unfolded to compares with constants,
+ * names of other lengths are skipped at
+ * compile time.
+ * @param word Loaded name.
+ * @return Method or `Method::None`.
+ */
+template<std::size_t Size, std::size_t... Indices>
+static HTTPRequest::Method matchMethod(uint64_t word, std::index_sequence<Indices...>)
+{
+    auto result = HTTPRequest::Method::None;
+
+    ((MethodWords[Indices].size == Size &&
+      MethodWords[Indices].word == word &&
+      (result = MethodWords[Indices].method, true)) || ...);
+
+    return result;
+}
+
+/**
+ * @brief Function for matching method of
+ * known length.
+ * @param data Pointer to method name.
+ * @return Method or `Method::None`.
+ */
+template<std::size_t Size>
+static HTTPRequest::Method matchMethod(const char* data)
+{
+    return matchMethod<Size>(
+        loadWord<Size>(data),
+        std::make_index_sequence<MethodWords.size()>()
+    );
+}
+
+HTTPRequest::Method HTTPRequest::stringToMethod(const std::string_view& s)
+{
+    // Method names are 3-7 bytes long, other
+    // lengths are unknown methods
+    switch (s.size())
+    {
+    case 3: return matchMethod<3>(s.data());
+    case 4: return matchMethod<4>(s.data());
+    case 5: return matchMethod<5>(s.data());
+    case 6: return matchMethod<6>(s.data());
+    case 7: return matchMethod<7>(s.data());
+    default:
+        return Method::None;
+    }
 }
 
 std::string_view HTTPRequest::methodToString(HTTPRequest::Method m)
 {
-    switch (m)
+    auto index = static_cast<std::size_t>(m);
+
+    if (index >= std::size(MethodNames))
     {
-    case Method::None:      return "None";
-    case Method::OPTIONS:   return "OPTIONS";
-    case Method::GET:       return "GET";
-    case Method::HEAD:      return "HEAD";
-    case Method::POST:      return "POST";
-    case Method::PUT:       return "PUT";
-    case Method::PATCH:     return "PATCH";
-    case Method::DELETE:    return "DELETE";
-    case Method::TRACE:     return "TRACE";
-    case Method::CONNECT:   return "CONNECT";
+        return MethodNames[0];
     }
+
+    return MethodNames[index];
 }
 
-HTTPRequest::HTTPRequest() :
+HTTPRequest::HTTPRequest(std::pmr::memory_resource* resource) :
     m_method(Method::None),
     m_uri(),
     m_version(),
-    m_header(),
+    m_header(resource),
     m_data(nullptr),
-    m_dataSize()
+    m_dataSize(),
+    m_parseState(ParseState::RequestLine),
+    m_lineStart(0),
+    m_scanPosition(0),
+    m_headerSize(0),
+    m_parsedMethod(Method::None),
+    m_uriRange(),
+    m_versionRange(),
+    m_headerRanges(resource),
+    m_committedBytes(nullptr),
+    m_committedSize(0)
 {
 
 }
 
-HTTPHeader HTTPRequest::header() const
+std::pmr::memory_resource* HTTPRequest::memoryResource() const
+{
+    return m_header.memoryResource();
+}
+
+const HTTPHeader& HTTPRequest::header() const
 {
     return m_header;
 }
@@ -119,6 +295,12 @@ std::size_t HTTPRequest::dataSize() const
     return m_dataSize;
 }
 
+void HTTPRequest::setData(std::byte* data, std::size_t size)
+{
+    m_data = data;
+    m_dataSize = size;
+}
+
 std::size_t HTTPRequest::calculateSerializedSize() const
 {
     std::size_t result = methodToString(m_method).size();
@@ -153,96 +335,256 @@ std::size_t HTTPRequest::calculateSerializedSize() const
 
 bool HTTPRequest::parse(std::byte* bytes, std::size_t size)
 {
-    m_header.clear();
-    // Searching for method end
-    std::size_t prevIterator = 0;
-    std::size_t iterator;
+    resetParser();
+
+    return parsePartial(bytes, size) == ParseStatus::Complete;
+}
+
+HTTPRequest::ParseStatus HTTPRequest::parsePartial(std::byte* bytes, std::size_t size)
+{
+    if (m_parseState == ParseState::Finished)
+    {
+        // Buffer may be reallocated after parsing
+        commitParsed(bytes, size);
+        return ParseStatus::Complete;
+    }
+
+    while (m_scanPosition < size)
+    {
+        const std::byte* colon;
+
+        // Searching for line end and header
+        // splitter with single pass
+        auto* lineFeed = ScanTools::FindLineFeed(
+            bytes + m_scanPosition,
+            bytes + size,
+            &colon
+        );
+
+        if (lineFeed == nullptr)
+        {
+            // Line is not received yet
+            m_scanPosition = size;
+            return ParseStatus::Incomplete;
+        }
+
+        auto lineEnd = static_cast<std::size_t>(lineFeed - bytes);
+
+        // Line start was scanned by previous call
+        if (m_scanPosition != m_lineStart)
+        {
+            colon = static_cast<const std::byte*>(std::memchr(
+                bytes + m_lineStart,
+                ':',
+                lineEnd - m_lineStart
+            ));
+        }
+
+        Range line{m_lineStart, lineEnd - m_lineStart};
+
+        // Line break is CRLF, but single LF is tolerated
+        if (line.size > 0 &&
+            bytes[lineEnd - 1] == static_cast<std::byte>('\r'))
+        {
+            --line.size;
+        }
+
+        m_lineStart = lineEnd + 1;
+        m_scanPosition = m_lineStart;
+
+        if (m_parseState == ParseState::RequestLine)
+        {
+            // Empty lines before request line are ignored
+            if (line.size == 0)
+            {
+                continue;
+            }
 
-    // Skipping initial spaces
-    for (iterator = 0;
-         iterator < size && bytes[iterator] != static_cast<std::byte>(' ');
-         ++iterator);
+            if (!parseRequestLine(bytes, line))
+            {
+                return ParseStatus::Error;
+            }
+
+            m_parseState = ParseState::Headers;
+
+            // Browser requests have 10-20 headers
+            m_headerRanges.reserve(ExpectedHeadersCount);
+        }
+        else if (line.size == 0)
+        {
+            // Empty line finishes headers
+            m_headerSize = m_lineStart;
+            m_parseState = ParseState::Finished;
+
+            commitParsed(bytes, size);
+
+            return ParseStatus::Complete;
+        }
+        else if (!parseHeaderLine(bytes, line, colon))
+        {
+            return ParseStatus::Error;
+        }
+    }
+
+    return ParseStatus::Incomplete;
+}
+
+void HTTPRequest::resetParser()
+{
+    m_parseState = ParseState::RequestLine;
+    m_lineStart = 0;
+    m_scanPosition = 0;
+    m_headerSize = 0;
+    m_parsedMethod = Method::None;
+    m_uriRange = Range();
+    m_versionRange = Range();
+    m_headerRanges.clear();
+    m_committedBytes = nullptr;
+    m_committedSize = 0;
+}
+
+std::size_t HTTPRequest::headerSize() const
+{
+    return m_headerSize;
+}
+
+bool HTTPRequest::parseRequestLine(std::byte* bytes, HTTPRequest::Range line)
+{
+    auto* begin = reinterpret_cast<const char*>(bytes + line.offset);
+
+    std::string_view view(begin, line.size);
+
+    // Searching for method end
+    auto methodEnd = view.find(' ');
 
     // Can't find method end
-    if (iterator >= size)
+    if (methodEnd == std::string_view::npos)
     {
-        Warning() << "Can't find space for method.";
+        HTTPLog::write(MethodSpaceSite);
         return false;
     }
 
-    std::string_view method(reinterpret_cast<const char*>(bytes + prevIterator), iterator - prevIterator);
+    auto method = view.substr(0, methodEnd);
 
     // Trying to parse method to enum
-    auto parsedMethod = stringToMethod(method);
+    m_parsedMethod = stringToMethod(method);
 
     // If parsing was unsuccessful
-    if (parsedMethod == Method::None)
+    if (m_parsedMethod == Method::None)
     {
-        Warning() << "Unknown method \"" << method << "\".";
+        HTTPLog::write(UnknownMethodSite, method);
         return false;
     }
 
-    // Ok, parsedMethod is confirmed.
-    iterator += 1;
-    prevIterator = iterator;
+    // Searching for uri end. Version is optional.
+    auto uriEnd = view.find(' ', methodEnd + 1);
+
+    if (uriEnd == std::string_view::npos)
+    {
+        uriEnd = view.size();
+    }
+
+    m_uriRange = Range{line.offset + methodEnd + 1, uriEnd - methodEnd - 1};
 
-    // Searching for next space
-    for (; iterator < size &&
-           bytes[iterator] != static_cast<std::byte>(' ') &&
-           (bytes[iterator    ] != static_cast<std::byte>(0x0D) ||
-            bytes[iterator + 1] != static_cast<std::byte>(0x0A));
-           ++iterator);
+    if (m_uriRange.size == 0)
+    {
+        HTTPLog::write(EmptyUriSite);
+        return false;
+    }
 
-    bool hasVersion = (bytes[iterator    ] != static_cast<std::byte>(0x0D) ||
-                       bytes[iterator + 1] != static_cast<std::byte>(0x0A));
+    if (uriEnd < view.size())
+    {
+        m_versionRange = Range{line.offset + uriEnd + 1, view.size() - uriEnd - 1};
+    }
 
-    // Receiving uri
-    std::string_view parsedURI(reinterpret_cast<const char*>(bytes + prevIterator), iterator - prevIterator);
+    return true;
+}
 
-    std::string_view parsedVersion;
+bool HTTPRequest::parseHeaderLine(std::byte* bytes, HTTPRequest::Range line, const std::byte* colon)
+{
+    auto* begin = reinterpret_cast<const char*>(bytes + line.offset);
 
-    if (hasVersion)
+    if (colon == nullptr || colon == bytes + line.offset)
     {
-        // Ok, URI is confirmed there
-        iterator += 1;
-        prevIterator = iterator;
+        HTTPLog::write(SplitterSite);
+        return false;
+    }
 
-        // Searching for newline
-        for (; iterator < size - 1 &&
-               (bytes[iterator    ] != static_cast<std::byte>(0x0D) ||
-                bytes[iterator + 1] != static_cast<std::byte>(0x0A));
-               ++iterator);
+    auto splitter = static_cast<std::size_t>(colon - (bytes + line.offset));
+
+    // Whitespace before colon or line folding can make
+    // proxies and server see different fields, so
+    // such requests are rejected
+    std::string_view name(begin, splitter);
+
+    if (!std::all_of(
+            name.begin(),
+            name.end(),
+            [](char c)
+            {
+                return TokenChars[static_cast<unsigned char>(c)];
+            }
+        ))
+    {
+        HTTPLog::write(HeaderNameSite, name);
+        return false;
+    }
 
-        if (iterator >= size)
-        {
-            Warning() << "Can't find newline after first line.";
-            return false;
-        }
+    // Whitespaces around value are not part of it
+    auto valueBegin = splitter + 1;
+    auto valueEnd = line.size;
 
-        // Receiving version
-        parsedVersion = std::string_view(reinterpret_cast<const char*>(bytes + prevIterator), iterator - prevIterator);
+    while (valueBegin < valueEnd &&
+           (begin[valueBegin] == ' ' || begin[valueBegin] == '\t'))
+    {
+        ++valueBegin;
     }
 
-    // Ok, version confirmed there
-    iterator += 2;
-    prevIterator = iterator;
+    while (valueEnd > valueBegin &&
+           (begin[valueEnd - 1] == ' ' || begin[valueEnd - 1] == '\t'))
+    {
+        --valueEnd;
+    }
 
-    // Committing values and starting parsing headers
-    m_method = parsedMethod;
-    m_uri = parsedURI;
-    m_version = parsedVersion;
+    m_headerRanges.emplace_back(
+        Range{line.offset, splitter},
+        Range{line.offset + valueBegin, valueEnd - valueBegin}
+    );
 
-    std::size_t resultIterator;
+    return true;
+}
 
-    if (!m_header.parse(bytes + iterator, size - iterator, &resultIterator))
+void HTTPRequest::commitParsed(std::byte* bytes, std::size_t size)
+{
+    // Fields are already pointing into these bytes
+    if (bytes == m_committedBytes && size == m_committedSize)
     {
-        return false;
+        return;
     }
 
-    resultIterator += iterator;
+    m_committedBytes = bytes;
+    m_committedSize = size;
 
-    m_data = bytes + resultIterator;
-    m_dataSize = size - resultIterator;
+    auto toView = [bytes](Range range)
+    {
+        return std::string_view(
+            reinterpret_cast<const char*>(bytes + range.offset),
+            range.size
+        );
+    };
 
-    return true;
+    m_method = m_parsedMethod;
+    m_uri = toView(m_uriRange);
+    m_version = toView(m_versionRange);
+
+    m_header.clear();
+    m_header.reserve(m_headerRanges.size());
+
+    for (auto&& [name, value] : m_headerRanges)
+    {
+        m_header.addHeader({toView(name), toView(value)});
+    }
+
+    m_data = bytes + m_headerSize;
+    m_dataSize = size - m_headerSize;
 }
@@ -1,150 +1,39 @@
+#include <charconv>
+#include <stdexcept>
+#ifdef OS_LINUX
+#include <unistd.h>
+#endif
 #include "HTTPResponse.hpp"
+#include "ResponseWriter.hpp"
 
 std::string_view HTTPResponse::statusToString(HTTPResponse::StatusCode code)
 {
-    switch (code)
-    {
-    case Continue:
-        return "Continue";
-    case SwitchingProtocols:
-        return "SwitchingProtocols";
-    case Processing:
-        return "Processing";
-    case EarlyHints:
-        return "EarlyHints";
-    case Ok:
-        return "OK";
-    case Created:
-        return "Created";
-    case Accepted:
-        return "Accepted";
-    case NonAuthoritativeInformation:
-        return "NonAuthoritativeInformation";
-    case NoContent:
-        return "NoContent";
-    case ResetContent:
-        return "ResetContent";
-    case PartialContent:
-        return "PartialContent";
-    case MultiStatus:
-        return "MultiStatus";
-    case AlreadyReported:
-        return "AlreadyReported";
-    case IMUsed:
-        return "IMUsed";
-    case MultipleChoices:
-        return "MultipleChoices";
-    case MovedPermanently:
-        return "MovedPermanently";
-    case Found:
-        return "Found";
-    case SeeOther:
-        return "SeeOther";
-    case NotModified:
-        return "NotModified";
-    case UseProxy:
-        return "UseProxy";
-    case SwitchProxy:
-        return "SwitchProxy";
-    case TemporaryRedirect:
-        return "TemporaryRedirect";
-    case PermanentRedirect:
-        return "PermanentRedirect";
-    case BadRequest:
-        return "BadRequest";
-    case Unauthorized:
-        return "Unauthorized";
-    case PaymentRequired:
-        return "PaymentRequired";
-    case Forbidden:
-        return "Forbidden";
-    case NotFound:
-        return "NotFound";
-    case MethodNotAllowed:
-        return "MethodNotAllowed";
-    case NotAcceptable:
-        return "NotAcceptable";
-    case ProxyAuthenticationRequired:
-        return "ProxyAuthenticationRequired";
-    case RequestTimeout:
-        return "RequestTimeout";
-    case Conflict:
-        return "Conflict";
-    case Gone:
-        return "Gone";
-    case LengthRequired:
-        return "LengthRequired";
-    case PreconditionFailed:
-        return "PreconditionFailed";
-    case PayloadTooLarge:
-        return "PayloadTooLarge";
-    case URITooLong:
-        return "URITooLong";
-    case UnsupportedMediaType:
-        return "UnsupportedMediaType";
-    case RangeNotSatisfiable:
-        return "RangeNotSatisfiable";
-    case ExpectationFailed:
-        return "ExpectationFailed";
-    case ImTeapot:
-        return "ImTeapot";
-    case MisdirectedRequest:
-        return "MisdirectedRequest";
-    case UnprocessableEntity:
-        return "UnprocessableEntity";
-    case Locked:
-        return "Locked";
-    case FailedDependency:
-        return "FailedDependency";
-    case UpgradeRequired:
-        return "UpgradeRequired";
-    case PreconditionRequired:
-        return "PreconditionRequired";
-    case TooManyRequests:
-        return "TooManyRequests";
-    case RequestHeaderFieldsTooLarge:
-        return "RequestHeaderFieldsTooLarge";
-    case UnavailableForLegalReasons:
-        return "UnavailableForLegalReasons";
-    case InternalServerError:
-        return "InternalServerError";
-    case NotImplemented:
-        return "NotImplemented";
-    case BadGateway:
-        return "BadGateway";
-    case ServiceUnavailable:
-        return "ServiceUnavailable";
-    case GatewayTimeout:
-        return "GatewayTimeout";
-    case HTTPVersionNotSupported:
-        return "HTTPVersionNotSupported";
-    case VariantAlsoNegotiates:
-        return "VariantAlsoNegotiates";
-    case InsufficientStorage:
-        return "InsufficientStorage";
-    case LoopDetected:
-        return "LoopDetected";
-    case NotExtended:
-        return "NotExtended";
-    case NetworkAuthenticationRequired:
-        return "NetworkAuthenticationRequired";
-    case Unknown:break;
-    }
-
-    return "Unknown";
+    return ResponseWriter::reasonPhrase(code);
 }
 
-HTTPResponse::HTTPResponse() :
+HTTPResponse::HTTPResponse(std::pmr::memory_resource* resource) :
     m_statusCode(Unknown),
     m_stringStatus(),
     m_version(),
-    m_header(),
+    m_header(resource),
     m_data(),
-    m_dataSize()
+    m_dataSize(),
+    m_dataStorage(DataStorage::Pointer),
+    m_ownedData(),
+    m_resourceData(resource),
+    m_file(),
+    m_fileOffset(0),
+    m_fileSize(0),
+    m_stream()
 {
 
 }
 
+std::pmr::memory_resource* HTTPResponse::memoryResource() const
+{
+    return m_header.memoryResource();
+}
+
 HTTPResponse::StatusCode& HTTPResponse::statusCode()
 {
     return m_statusCode;
@@ -165,7 +54,7 @@ std::string_view& HTTPResponse::version()
     return m_version;
 }
 
-HTTPHeader HTTPResponse::header() const
+const HTTPHeader& HTTPResponse::header() const
 {
     return m_header;
 }
@@ -177,6 +66,20 @@ HTTPHeader& HTTPResponse::header()
 
 std::byte* HTTPResponse::data() const
 {
+    // Pointer to owned data is not stored,
+    // because it's invalidated on response moving
+    switch (m_dataStorage)
+    {
+    case DataStorage::String:
+        return reinterpret_cast<std::byte*>(const_cast<char*>(m_ownedData.data()));
+
+    case DataStorage::ResourceString:
+        return reinterpret_cast<std::byte*>(const_cast<char*>(m_resourceData.data()));
+
+    case DataStorage::Pointer:
+        break;
+    }
+
     return m_data;
 }
 
@@ -189,9 +92,107 @@ void HTTPResponse::setData(std::byte* data, std::size_t size)
 {
     m_data = data;
     m_dataSize = size;
+    m_dataStorage = DataStorage::Pointer;
+    m_ownedData.clear();
+    m_resourceData.clear();
+    m_file.reset();
+    m_fileOffset = 0;
+    m_fileSize = 0;
+    m_stream.reset();
 }
 
-std::size_t HTTPResponse::calculateSerializedSize() const
+void HTTPResponse::setData(std::string data)
+{
+    m_ownedData = std::move(data);
+    m_dataStorage = DataStorage::String;
+    m_data = nullptr;
+    m_dataSize = m_ownedData.size();
+    m_resourceData.clear();
+    m_file.reset();
+    m_fileOffset = 0;
+    m_fileSize = 0;
+    m_stream.reset();
+}
+
+void HTTPResponse::setData(std::pmr::string data)
+{
+    // Data of other resource is copied
+    m_resourceData = std::move(data);
+    m_dataStorage = DataStorage::ResourceString;
+    m_data = nullptr;
+    m_dataSize = m_resourceData.size();
+    m_ownedData.clear();
+    m_file.reset();
+    m_fileOffset = 0;
+    m_fileSize = 0;
+    m_stream.reset();
+}
+
+void HTTPResponse::setData(const char* data)
+{
+    setData(std::pmr::string(data, memoryResource()));
+}
+
+void HTTPResponse::setFile(int descriptor, std::size_t offset, std::size_t size)
+{
+    setData(nullptr, 0);
+
+    // Descriptor is shared between response copies
+    m_file = std::allocate_shared<const File>(
+        std::pmr::polymorphic_allocator<File>(memoryResource()),
+        descriptor
+    );
+
+    m_fileOffset = offset;
+    m_fileSize = size;
+}
+
+HTTPResponse::File::File(int descriptor) :
+    descriptor(descriptor)
+{
+
+}
+
+HTTPResponse::File::~File()
+{
+#ifdef OS_LINUX
+    ::close(descriptor);
+#endif
+}
+
+int HTTPResponse::fileDescriptor() const
+{
+    return m_file ? m_file->descriptor : -1;
+}
+
+std::size_t HTTPResponse::fileOffset() const
+{
+    return m_fileOffset;
+}
+
+std::size_t HTTPResponse::fileSize() const
+{
+    return m_fileSize;
+}
+
+void HTTPResponse::setStream(std::shared_ptr<HTTPBodyStream> stream)
+{
+    setData(nullptr, 0);
+
+    m_stream = std::move(stream);
+}
+
+HTTPBodyStream* HTTPResponse::stream() const
+{
+    return m_stream.get();
+}
+
+std::size_t HTTPResponse::contentLength() const
+{
+    return m_file ? m_fileSize : m_dataSize;
+}
+
+std::size_t HTTPResponse::calculateHeadSize() const
 {
     std::size_t result = 0;
 
@@ -237,12 +238,22 @@ std::size_t HTTPResponse::calculateSerializedSize() const
     // Header and final CRLF
     result += m_header.calculateSerializedSize();
 
-    result += m_dataSize;
-
     return result;
 }
 
-void HTTPResponse::serialize(std::byte* buffer)
+std::size_t HTTPResponse::calculateSerializedSize() const
+{
+    auto result = calculateHeadSize();
+
+    if (result + m_dataSize < result)
+    {
+        throw std::runtime_error("Size is out of range at adding data.");
+    }
+
+    return result + m_dataSize;
+}
+
+std::byte* HTTPResponse::serializeHead(std::byte* buffer)
 {
     buffer = std::copy(
         (const std::byte*) m_version.begin(),
@@ -252,7 +263,13 @@ void HTTPResponse::serialize(std::byte* buffer)
 
     *(buffer++) = static_cast<std::byte>(' ');
 
-    buffer += sprintf((char*) buffer, "%d", m_statusCode);
+    auto digits = std::to_chars(
+        reinterpret_cast<char*>(buffer),
+        reinterpret_cast<char*>(buffer) + numDigits(m_statusCode),
+        static_cast<int>(m_statusCode)
+    );
+
+    buffer = reinterpret_cast<std::byte*>(digits.ptr);
 
     *(buffer++) = static_cast<std::byte>(' ');
 
@@ -269,15 +286,17 @@ void HTTPResponse::serialize(std::byte* buffer)
     *(buffer++) = static_cast<std::byte>('\n');
 
     // Copying header
-    m_header.serialize(buffer);
+    return m_header.serialize(buffer);
+}
 
-    // Moving
-    buffer += m_header.calculateSerializedSize();
+void HTTPResponse::serialize(std::byte* buffer)
+{
+    buffer = serializeHead(buffer);
 
     // Copying data
     std::copy(
-        m_data,
-        m_data + m_dataSize,
+        data(),
+        data() + m_dataSize,
         buffer
     );
 }
@@ -1,205 +1,207 @@
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
 #include <CurrentLogger.hpp>
-#include <Tools/SocketTools.hpp>
+#include "HTTPEpollWorker.hpp"
+#ifdef SIMPLEHTTP_IO_URING
+#include "HTTPUringWorker.hpp"
+#endif
 #include "HTTPServer.hpp"
 
 HTTPServer::HTTPServer() :
-    m_recvSocket(0),
-    m_requestBuffer()
+    m_workersCount(1),
+    m_keepAliveTimeout(std::chrono::seconds(5)),
+    m_headerTimeout(std::chrono::seconds(10)),
+    m_bodyTimeout(std::chrono::seconds(30)),
+    m_writeTimeout(std::chrono::seconds(30)),
+    m_maxKeepAliveRequests(1000),
+    m_maxBodySize(1024 * 1024),
+    m_maxConnections(0),
+    m_maxInflightRequests(0),
+    m_retryAfter(std::chrono::seconds(1)),
+    m_unavailableResponse(),
+    m_metricsPath(),
+    m_metrics()
 {
+    prepareUnavailableResponse();
+
     Info() << "HTTP Server created.";
 }
 
-HTTPServer::~HTTPServer()
+HTTPServer::~HTTPServer() = default;
+
+void HTTPServer::setWorkersCount(std::size_t count)
 {
-    if (m_recvSocket)
-    {
-        SocketTools::Close(m_recvSocket);
-    }
+    m_workersCount = count;
 }
 
-bool HTTPServer::initializeSocket(uint32_t address, uint16_t port)
+std::size_t HTTPServer::workersCount() const
 {
-    m_recvSocket = socket(AF_INET, SOCK_STREAM, 0);
-
-    if (m_recvSocket == INVALID_SOCKET)
-    {
-        Error() << "Can't initialize socket. Error: " << strerror(errno);
-        return false;
-    }
-
-    sockaddr_in addr{0};
-
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    addr.sin_addr.s_addr = htonl(address);
+    return m_workersCount;
+}
 
-    if (bind(m_recvSocket, (const sockaddr*) &addr, sizeof(sockaddr_in)) == -1)
-    {
-        Error() << "Can't bind socket. Error: " << strerror(errno);
-        SocketTools::Close(m_recvSocket);
-        return false;
-    }
+void HTTPServer::setKeepAliveTimeout(std::chrono::milliseconds timeout)
+{
+    m_keepAliveTimeout = timeout;
+}
 
-    if (listen(m_recvSocket, 32) == -1)
-    {
-        Error() << "Can't set socket listen. Error: " << strerror(errno);
-        SocketTools::Close(m_recvSocket);
-        return false;
-    }
+void HTTPServer::setHeaderTimeout(std::chrono::milliseconds timeout)
+{
+    m_headerTimeout = timeout;
+}
 
-    return true;
+void HTTPServer::setBodyTimeout(std::chrono::milliseconds timeout)
+{
+    m_bodyTimeout = timeout;
 }
 
-void HTTPServer::exec(uint32_t address, uint16_t port)
+void HTTPServer::setWriteTimeout(std::chrono::milliseconds timeout)
 {
-    Info() << "Initializing socket at port " << port << "...";
+    m_writeTimeout = timeout;
+}
 
-    if (!initializeSocket(address, port))
-    {
-        Error() << "Initialization failed.";
-        return;
-    }
+void HTTPServer::setMaxKeepAliveRequests(std::size_t count)
+{
+    m_maxKeepAliveRequests = count;
+}
 
-    Info() << "Initialization succeed.";
+void HTTPServer::setMaxBodySize(std::size_t size)
+{
+    m_maxBodySize = size;
+}
 
-    socket_t clientSocket = 0;
-    sockaddr_in client{0};
-    HTTPRequest request;
+void HTTPServer::setMaxConnections(std::size_t count)
+{
+    m_maxConnections = count;
+}
 
-    while (true) // Endless loop
-    {
-        socklen_t len = sizeof(client);
+void HTTPServer::setMaxInflightRequests(std::size_t count)
+{
+    m_maxInflightRequests = count;
+}
 
-        // Awaiting client
-        clientSocket = accept(m_recvSocket, (sockaddr*) &client, &len);
+void HTTPServer::setRetryAfter(std::chrono::seconds delay)
+{
+    m_retryAfter = delay;
 
-        if (clientSocket == -1)
-        {
-            Error() << "Can't accept new connection. Error: " << strerror(errno);
-            SocketTools::Close(m_recvSocket);
-            return;
-        }
+    prepareUnavailableResponse();
+}
 
-        auto o1 = static_cast<std::byte>((client.sin_addr.s_addr & 0xFF000000U) >> (3 * 8));
-        auto o2 = static_cast<std::byte>((client.sin_addr.s_addr & 0x00FF0000U) >> (2 * 8));
-        auto o3 = static_cast<std::byte>((client.sin_addr.s_addr & 0x0000FF00U) >> (1 * 8));
-        auto o4 = static_cast<std::byte>((client.sin_addr.s_addr & 0x000000FFU) >> (0 * 8));
+void HTTPServer::setMetricsPath(std::string path)
+{
+    m_metricsPath = std::move(path);
+}
 
-        Info() << "Received connection from "
-            << (int) o4 << '.' << (int) o3 << '.' << (int) o2 << '.' << (int) o1;
+const std::string& HTTPServer::metricsPath() const
+{
+    return m_metricsPath;
+}
 
-        // Reading request
-        if (!readRequest(clientSocket, request))
-        {
-            Warning() << "Wrong request received from "
-                         << (int) o4 << '.' << (int) o3 << '.' << (int) o2 << '.' << (int) o1;
-            SocketTools::Close(clientSocket);
+HTTPMetrics& HTTPServer::metrics()
+{
+    return m_metrics;
+}
 
-            continue;
-        }
+void HTTPServer::exec(uint32_t address, uint16_t port, const HTTPServerOptions& options)
+{
+    auto count = m_workersCount;
 
-        HTTPResponse response = proceedRequest(std::move(request));
+    if (count == 0)
+    {
+        count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
 
-        m_requestBuffer.resize(response.calculateSerializedSize(), std::byte(0));
-        response.serialize(m_requestBuffer.data());
+    Info() << "Initializing " << count << " worker(s) at port " << port << "...";
 
-        SocketTools::Send(
-            clientSocket,
-            reinterpret_cast<const uint8_t*>(m_requestBuffer.data()),
-            static_cast<int>(response.calculateSerializedSize()),
-            0
-        );
+#ifdef SIMPLEHTTP_IO_URING
+    bool useIOURing = HTTPUringWorker::isSupported();
 
-        SocketTools::Close(clientSocket);
+    if (useIOURing)
+    {
+        Info() << "Using io_uring backend.";
     }
-}
-
-bool HTTPServer::readRequest(socket_t client, HTTPRequest& request)
-{
-    m_requestBuffer.clear();
-    if (m_requestBuffer.size() < 1024)
+    else
     {
-        m_requestBuffer.resize(1024, std::byte(0));
+        Warning() << "io_uring is not supported by kernel. Falling back to epoll.";
     }
+#endif
 
-    std::size_t received = 0;
+    // Limits are divided between workers, so
+    // workers don't share counters
+    auto divide = [count](std::size_t limit) -> std::size_t
+    {
+        return limit == 0 ? 0 : (limit + count - 1) / count;
+    };
 
-    std::size_t crlf = 0;
+    // Every worker owns listening socket, bound to the
+    // same port. Kernel distributes connections between them.
+    auto listenerOptions = options;
+    listenerOptions.reusePort = options.reusePort || count > 1;
 
-    bool finish = false;
+    std::vector<std::unique_ptr<HTTPWorker>> workers;
+    workers.reserve(count);
 
-    while (!finish)
+    for (std::size_t i = 0; i < count; ++i)
     {
-        ssize_t currentlyReceived = SocketTools::Receive(
-            client,
-            (uint8_t*) m_requestBuffer.data() + received,
-            1,
-            0
-        );
-
-        if (currentlyReceived == -1)
+        std::unique_ptr<HTTPWorker> worker;
+
+#ifdef SIMPLEHTTP_IO_URING
+        if (useIOURing)
         {
-            Error() << "Received error: " << strerror(errno);
-            return false;
+            worker = std::make_unique<HTTPUringWorker>(*this);
         }
-
-        received += currentlyReceived;
-
-        if (received >= m_requestBuffer.size())
+        else
+#endif
         {
-            Info() << "Resizing..." << std::endl;
-            m_requestBuffer.resize(
-                m_requestBuffer.size() + 1024,
-                std::byte(0)
-            );
+            worker = std::make_unique<HTTPEpollWorker>(*this);
         }
 
-        switch (crlf)
+        worker->setLimits(divide(m_maxConnections), divide(m_maxInflightRequests));
+
+        if (!worker->initialize(address, port, listenerOptions))
         {
-        case 0:
-            if (m_requestBuffer[received - 1] == std::byte('\r'))
-            {
-                crlf = 1;
-            }
-            break;
-        case 1:
-            if (m_requestBuffer[received - 1] == std::byte('\n'))
-            {
-                crlf = 2;
-            }
-            else
-            {
-                crlf = 0;
-            }
-            break;
-        case 2:
-            if (m_requestBuffer[received - 1] == std::byte('\r'))
-            {
-                crlf = 3;
-            }
-            else
-            {
-                crlf = 0;
-            }
-            break;
-        case 3:
-            if (m_requestBuffer[received - 1] == std::byte('\n'))
-            {
-                finish = true;
-            }
-            else
-            {
-                crlf = 0;
-            }
-            break;
-
-        default:
-
-            break;
+            Error() << "Initialization failed.";
+            return;
         }
+
+        workers.push_back(std::move(worker));
+    }
+
+    Info() << "Initialization succeed.";
+
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        threads.emplace_back(&HTTPWorker::exec, workers[i].get());
     }
 
-    return request.parse(m_requestBuffer.data(), received);
+    // First worker is executed at calling thread
+    workers.front()->exec();
+
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void HTTPServer::prepareUnavailableResponse()
+{
+    HTTPResponse response;
+
+    response.version() = "HTTP/1.1";
+    response.statusCode() = HTTPResponse::StatusCode::ServiceUnavailable;
+
+    auto retryAfter = std::to_string(m_retryAfter.count());
+
+    response.header().addHeader({"Retry-After", retryAfter});
+    response.header().addHeader({"Content-Length", "0"});
+    response.header().addHeader({"Connection", "close"});
+
+    m_unavailableResponse.resize(response.calculateHeadSize());
+    response.serializeHead(m_unavailableResponse.data());
 }
 
 HTTPResponse HTTPServer::proceedRequest(HTTPRequest request)
@@ -216,10 +218,21 @@ HTTPResponse HTTPServer::proceedRequest(HTTPRequest request)
                   << " Value: " << request.header().header(i).second << std::endl;
     }
 
-    HTTPResponse response;
+    HTTPResponse response(request.memoryResource());
 
     response.statusCode() = HTTPResponse::StatusCode::Ok;
     response.version() = "HTTP/1.1";
 
     return std::move(response);
-}
\ No newline at end of file
+}
+
+Task<HTTPResponse> HTTPServer::proceedRequestAsync(HTTPRequest& request)
+{
+    // Synchronous handler doesn't need coroutine frame
+    return Task<HTTPResponse>::ready(proceedRequest(std::move(request)));
+}
+
+std::unique_ptr<HTTPBodyHandler> HTTPServer::createBodyHandler(const HTTPRequest& /*request*/)
+{
+    return nullptr;
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include "HTTPTimerWheel.hpp"
+
+HTTPTimerWheel::Timer::Timer() :
+    data(0),
+    m_next(nullptr),
+    m_link(nullptr),
+    m_expiration(0)
+{
+
+}
+
+HTTPTimerWheel::Timer::~Timer()
+{
+    cancel();
+}
+
+bool HTTPTimerWheel::Timer::isArmed() const
+{
+    return m_link != nullptr;
+}
+
+void HTTPTimerWheel::Timer::cancel()
+{
+    if (m_link == nullptr)
+    {
+        return;
+    }
+
+    *m_link = m_next;
+
+    if (m_next != nullptr)
+    {
+        m_next->m_link = m_link;
+    }
+
+    m_next = nullptr;
+    m_link = nullptr;
+}
+
+HTTPTimerWheel::HTTPTimerWheel(Clock::time_point now) :
+    m_start(now),
+    m_current(0),
+    m_slots()
+{
+
+}
+
+HTTPTimerWheel::~HTTPTimerWheel()
+{
+    for (auto&& level : m_slots)
+    {
+        for (auto&& slot : level)
+        {
+            while (slot != nullptr)
+            {
+                slot->cancel();
+            }
+        }
+    }
+}
+
+void HTTPTimerWheel::arm(Timer& timer, std::chrono::milliseconds timeout)
+{
+    timer.cancel();
+
+    auto ticks = static_cast<uint64_t>(
+        (std::max(timeout, std::chrono::milliseconds(0)) + TickDuration - std::chrono::milliseconds(1)) /
+        TickDuration
+    );
+
+    // Timer never expires at current tick, because
+    // it's slot may be already processed
+    ticks = std::clamp(ticks, uint64_t(1), MaxTicks);
+
+    timer.m_expiration = m_current + ticks;
+
+    link(timer);
+}
+
+void HTTPTimerWheel::link(Timer& timer)
+{
+    auto delta = timer.m_expiration - m_current;
+
+    std::size_t level = 0;
+
+    while (level + 1 < LevelsCount && delta >= (uint64_t(1) << (SlotBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    auto& slot = m_slots[level][(timer.m_expiration >> (SlotBits * level)) & (SlotsCount - 1)];
+
+    timer.m_next = slot;
+    timer.m_link = &slot;
+
+    if (slot != nullptr)
+    {
+        slot->m_link = &timer.m_next;
+    }
+
+    slot = &timer;
+}
+
+void HTTPTimerWheel::cascade()
+{
+    for (std::size_t level = 1; level < LevelsCount; ++level)
+    {
+        // Upper slot is reached, when all lower
+        // levels are wrapped
+        if ((m_current & ((uint64_t(1) << (SlotBits * level)) - 1)) != 0)
+        {
+            return;
+        }
+
+        auto& slot = m_slots[level][(m_current >> (SlotBits * level)) & (SlotsCount - 1)];
+
+        auto* timer = slot;
+
+        slot = nullptr;
+
+        while (timer != nullptr)
+        {
+            auto* next = timer->m_next;
+
+            link(*timer);
+
+            timer = next;
+        }
+    }
+}
@@ -0,0 +1,697 @@
+#include <poll.h>
+#include <vector>
+#include <CurrentLogger.hpp>
+#include <Tools/SocketTools.hpp>
+#include "HTTPUringWorker.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of connections.
+ */
+static const HTTPLog::Site ConnectionSite{HTTPLog::Level::Info, "Received connection from {}", 1, 100};
+static const HTTPLog::Site WrongRequestSite{HTTPLog::Level::Warning, "Wrong request received from {}", 1, 10};
+static const HTTPLog::Site AcceptErrorSite{HTTPLog::Level::Warning, "Can't accept new connection. Error: {}", 1, 10};
+
+/**
+ * @brief Group of receive buffers.
+ */
+static constexpr uint16_t BufferGroup = 0;
+
+/**
+ * @brief Index of listening socket in
+ * registered files.
+ */
+static constexpr int ListenerIndex = 0;
+
+HTTPUringWorker::HTTPUringWorker(HTTPServer& server) :
+    HTTPWorker(server),
+    m_recvSocket(INVALID_SOCKET),
+    m_acceptArmed(false),
+    m_nextId(0),
+    m_tickInterval{0, std::chrono::nanoseconds(HTTPTimerWheel::TickDuration).count()},
+    m_connections(),
+    m_ring()
+{
+
+}
+
+HTTPUringWorker::~HTTPUringWorker()
+{
+    m_connections.clear();
+
+    if (m_recvSocket != INVALID_SOCKET)
+    {
+        SocketTools::Close(m_recvSocket);
+    }
+}
+
+bool HTTPUringWorker::isSupported()
+{
+    return IOURing::isSupported();
+}
+
+bool HTTPUringWorker::initialize(uint32_t address, uint16_t port, const HTTPServerOptions& options)
+{
+    m_recvSocket = createListener(address, port, options);
+
+    if (m_recvSocket == INVALID_SOCKET)
+    {
+        return false;
+    }
+
+    if (!m_ring.initialize(QueueSize))
+    {
+        Error() << "Can't create io_uring instance. Error: " << strerror(errno);
+        return false;
+    }
+
+    if (!m_ring.registerFiles(&m_recvSocket, 1))
+    {
+        Error() << "Can't register listening socket. Error: " << strerror(errno);
+        return false;
+    }
+
+    if (!m_ring.registerBuffers(BuffersCount, BufferSize, BufferGroup))
+    {
+        Error() << "Can't register receive buffers. Error: " << strerror(errno);
+        return false;
+    }
+
+    if (!m_executor.initialize())
+    {
+        Error() << "Can't create executor descriptors. Error: " << strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
+void HTTPUringWorker::exec()
+{
+    blockPipeSignal();
+
+    m_executor.attach();
+
+    // Ring is used only by thread, that enabled it
+    if (!m_ring.enable())
+    {
+        Error() << "Can't enable io_uring instance. Error: " << strerror(errno);
+        return;
+    }
+
+    if (!submitAccept() || !submitTimeout() ||
+        !submitExecutorPoll(m_executor.postDescriptor()) ||
+        !submitExecutorPoll(m_executor.timerDescriptor()))
+    {
+        Error() << "Can't submit initial operations.";
+        return;
+    }
+
+    while (true) // Endless loop
+    {
+        auto result = m_ring.submit(1);
+
+        if (result < 0 && result != -EBUSY && result != -EAGAIN)
+        {
+            Error() << "Can't wait for completions. Error: " << strerror(-result);
+            return;
+        }
+
+        while (auto* cqe = m_ring.peekCQE())
+        {
+            // Completion is copied, so queue slot is
+            // released before new operations are submitted
+            auto completion = *cqe;
+
+            m_ring.seenCQE();
+
+            proceedCompletion(completion);
+        }
+    }
+}
+
+bool HTTPUringWorker::submitAccept()
+{
+    auto* sqe = m_ring.getSQE();
+
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->fd = ListenerIndex;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = userData(0, Operation::Accept);
+
+    m_acceptArmed = true;
+
+    return true;
+}
+
+bool HTTPUringWorker::submitTimeout()
+{
+    auto* sqe = m_ring.getSQE();
+
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_TIMEOUT;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(&m_tickInterval);
+    sqe->len = 1;
+    sqe->user_data = userData(0, Operation::Timeout);
+
+    return true;
+}
+
+bool HTTPUringWorker::submitExecutorPoll(int descriptor)
+{
+    auto* sqe = m_ring.getSQE();
+
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = descriptor;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = userData(static_cast<uint64_t>(descriptor), Operation::Executor);
+
+    return true;
+}
+
+bool HTTPUringWorker::submitCancel(uint64_t id, Operation operation)
+{
+    auto* sqe = m_ring.getSQE();
+
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = userData(id, operation);
+    sqe->user_data = userData(id, Operation::Cancel);
+
+    return true;
+}
+
+bool HTTPUringWorker::submitReceive(uint64_t id, Slot& slot)
+{
+    auto* sqe = m_ring.getSQE();
+
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    // Buffer is selected by kernel, when data
+    // arrives, so idle connections don't hold it
+    sqe->opcode = IORING_OP_RECV;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->fd = slot.connection->socket();
+    sqe->buf_group = BufferGroup;
+    sqe->user_data = userData(id, Operation::Receive);
+
+    slot.receiving = true;
+    ++slot.pending;
+
+    return true;
+}
+
+bool HTTPUringWorker::submitSend(uint64_t id, Slot& slot)
+{
+    auto& connection = *slot.connection;
+
+    slot.message = msghdr{};
+    slot.message.msg_iov = slot.buffers;
+    slot.message.msg_iovlen = static_cast<std::size_t>(connection.pendingOutput(slot.buffers));
+
+    // Body stream failed
+    if (slot.message.msg_iovlen == 0)
+    {
+        return false;
+    }
+
+    auto* sqe = m_ring.getSQE();
+
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    // Partial sends are retried by kernel
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = connection.socket();
+    sqe->addr = reinterpret_cast<uint64_t>(&slot.message);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+    sqe->user_data = userData(id, Operation::Send);
+
+    slot.sending = true;
+    ++slot.pending;
+
+    // Socket is closed after last part of output
+    if (connection.isKeepAlive() || !connection.isLastOutputPending())
+    {
+        return true;
+    }
+
+    auto* closeSqe = m_ring.getSQE();
+
+    if (closeSqe == nullptr)
+    {
+        // Socket is closed with connection
+        return true;
+    }
+
+    // Close is cancelled by kernel, if send fails
+    auto socket = connection.releaseSocket();
+
+    sqe->flags |= IOSQE_IO_LINK;
+
+    closeSqe->opcode = IORING_OP_CLOSE;
+    closeSqe->fd = socket;
+    closeSqe->user_data = userData(static_cast<uint64_t>(socket), Operation::Close);
+
+    return true;
+}
+
+bool HTTPUringWorker::submitPoll(uint64_t id, Slot& slot)
+{
+    auto* sqe = m_ring.getSQE();
+
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = slot.connection->socket();
+    sqe->poll32_events = POLLOUT;
+    sqe->user_data = userData(id, Operation::Poll);
+
+    slot.sending = true;
+    ++slot.pending;
+
+    return true;
+}
+
+void HTTPUringWorker::proceedCompletion(const io_uring_cqe& cqe)
+{
+    auto operation = static_cast<Operation>(cqe.user_data & 0xFF);
+    auto id = cqe.user_data >> 8;
+
+    switch (operation)
+    {
+    case Operation::Accept:
+        if (cqe.res >= 0)
+        {
+            acceptConnection(cqe.res);
+        }
+        else
+        {
+            HTTPLog::write(AcceptErrorSite, strerror(-cqe.res));
+        }
+
+        // Multishot accept is stopped by kernel on error.
+        // It's resubmitted by timeout, so descriptors
+        // exhaustion doesn't cause busy loop.
+        if (!(cqe.flags & IORING_CQE_F_MORE))
+        {
+            m_acceptArmed = false;
+
+            if (cqe.res >= 0)
+            {
+                submitAccept();
+            }
+        }
+        return;
+
+    case Operation::Timeout:
+        proceedTimeouts(std::chrono::steady_clock::now());
+
+        if (!m_acceptArmed)
+        {
+            submitAccept();
+        }
+
+        submitTimeout();
+        return;
+
+    case Operation::Executor:
+        m_executor.proceed();
+
+        if (!(cqe.flags & IORING_CQE_F_MORE))
+        {
+            submitExecutorPoll(static_cast<int>(id));
+        }
+        return;
+
+    case Operation::Close:
+        // Send, linked with close, failed
+        if (cqe.res == -ECANCELED)
+        {
+            SocketTools::Close(static_cast<socket_t>(id));
+        }
+        return;
+
+    case Operation::Cancel:
+        return;
+
+    default:
+        break;
+    }
+
+    auto iterator = m_connections.find(id);
+
+    if (iterator == m_connections.end())
+    {
+        if (cqe.flags & IORING_CQE_F_BUFFER)
+        {
+            m_ring.recycleBuffer(static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT));
+        }
+
+        return;
+    }
+
+    auto& slot = iterator->second;
+    auto& connection = *slot.connection;
+
+    --slot.pending;
+
+    bool failed = false;
+
+    switch (operation)
+    {
+    case Operation::Receive:
+        slot.receiving = false;
+
+        if (cqe.flags & IORING_CQE_F_BUFFER)
+        {
+            auto buffer = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+            if (cqe.res > 0 && !slot.closing)
+            {
+                connection.appendInput(m_ring.buffer(buffer), static_cast<std::size_t>(cqe.res));
+            }
+
+            m_ring.recycleBuffer(buffer);
+        }
+
+        if (cqe.res == 0)
+        {
+            // Already received request still can be answered
+            connection.setPeerClosed();
+        }
+        else if (cqe.res < 0 && cqe.res != -ENOBUFS)
+        {
+            // Receiving is resubmitted, if there
+            // were no free buffers
+            failed = true;
+        }
+        break;
+
+    case Operation::Send:
+        slot.sending = false;
+
+        if (cqe.res < 0)
+        {
+            failed = true;
+        }
+        else
+        {
+            connection.outputSent(static_cast<std::size_t>(cqe.res));
+        }
+        break;
+
+    case Operation::Poll:
+        slot.sending = false;
+        break;
+
+    default:
+        break;
+    }
+
+    if (slot.closing)
+    {
+        if (slot.pending == 0)
+        {
+            m_connections.erase(iterator);
+        }
+
+        return;
+    }
+
+    if (failed)
+    {
+        closeConnection(id, slot);
+        return;
+    }
+
+    proceedConnection(id, slot);
+}
+
+void HTTPUringWorker::acceptConnection(socket_t socket)
+{
+    sockaddr_in client{0};
+    socklen_t len = sizeof(client);
+
+    // Connection may be reset before it's accepted
+    if (getpeername(socket, (sockaddr*) &client, &len) == -1)
+    {
+        HTTPLog::write(AcceptErrorSite, strerror(errno));
+        SocketTools::Close(socket);
+        return;
+    }
+
+    if (!admitConnection(socket, client, m_connections.size()))
+    {
+        return;
+    }
+
+    auto id = m_nextId++;
+
+    auto& slot = m_connections[id];
+
+    slot.connection = std::make_unique<HTTPConnection>(socket, client);
+    slot.connection->timer().data = id;
+    slot.pending = 0;
+    slot.receiving = false;
+    slot.sending = false;
+    slot.closing = false;
+
+    HTTPLog::write(ConnectionSite, client);
+
+    recordAccepted();
+
+    proceedConnection(id, slot);
+}
+
+void HTTPUringWorker::proceedConnection(uint64_t id, Slot& slot)
+{
+    auto& connection = *slot.connection;
+
+    while (true)
+    {
+        switch (connection.state())
+        {
+        case HTTPConnection::State::Reading:
+            if (connection.isRequestMalformed())
+            {
+                HTTPLog::write(WrongRequestSite, connection.address());
+                proceedError(connection, connection.requestError());
+                break;
+            }
+
+            if (connection.isHeaderReceived())
+            {
+                proceedBody(connection);
+                break;
+            }
+
+            if (connection.isRequestReceived())
+            {
+                proceedHandling(connection, [this, id]
+                {
+                    resumeConnection(id);
+                });
+
+                // Suspended handler holds connection
+                // like submitted operation
+                if (connection.state() == HTTPConnection::State::Handling)
+                {
+                    ++slot.pending;
+                }
+                break;
+            }
+
+            if (connection.isPeerClosed())
+            {
+                closeConnection(id, slot);
+                return;
+            }
+
+            if (!slot.receiving && !submitReceive(id, slot))
+            {
+                closeConnection(id, slot);
+                return;
+            }
+
+            // Waiting for more data
+            updateTimeout(connection);
+            return;
+
+        case HTTPConnection::State::Writing:
+            if (slot.sending)
+            {
+                return;
+            }
+
+            if (connection.isOutputFinished())
+            {
+                if (!connection.isKeepAlive())
+                {
+                    closeConnection(id, slot);
+                    return;
+                }
+
+                finishRequest(connection);
+
+                // Next request may be already received
+                connection.reset();
+                break;
+            }
+
+            if (connection.hasFileOutput())
+            {
+                // File data is sent with sendfile, until
+                // socket buffer is full
+                if (!connection.writePending())
+                {
+                    closeConnection(id, slot);
+                    return;
+                }
+
+                if (!connection.isOutputFinished() && !submitPoll(id, slot))
+                {
+                    closeConnection(id, slot);
+                    return;
+                }
+
+                updateTimeout(connection);
+                break;
+            }
+
+            if (!submitSend(id, slot))
+            {
+                closeConnection(id, slot);
+                return;
+            }
+
+            updateTimeout(connection);
+            return;
+
+        case HTTPConnection::State::Handling:
+            updateTimeout(connection);
+            return;
+        }
+    }
+}
+
+void HTTPUringWorker::resumeConnection(uint64_t id)
+{
+    auto& slot = m_connections.at(id);
+
+    --slot.pending;
+
+    if (slot.closing)
+    {
+        if (slot.pending == 0)
+        {
+            m_connections.erase(id);
+        }
+
+        return;
+    }
+
+    proceedConnection(id, slot);
+}
+
+void HTTPUringWorker::closeConnection(uint64_t id, Slot& slot)
+{
+    if (slot.closing)
+    {
+        return;
+    }
+
+    slot.closing = true;
+
+    releaseConnection(*slot.connection);
+
+    auto socket = slot.connection->socket();
+
+    // Submitted operations are completed by
+    // shutdown, so connection can be destroyed.
+    // Socket is closed already, if it was released
+    // for linked close.
+    if (socket != INVALID_SOCKET && slot.pending > 0)
+    {
+        shutdown(socket, SHUT_RDWR);
+    }
+    else if (socket == INVALID_SOCKET && slot.sending)
+    {
+        // Stalled send keeps socket open, until
+        // it's cancelled with linked close
+        submitCancel(id, Operation::Send);
+    }
+
+    if (slot.pending == 0)
+    {
+        m_connections.erase(id);
+    }
+}
+
+void HTTPUringWorker::proceedTimeouts(std::chrono::steady_clock::time_point now)
+{
+    m_timers.advance(now, [this](HTTPTimerWheel::Timer& timer)
+    {
+        auto iterator = m_connections.find(timer.data);
+
+        if (iterator == m_connections.end())
+        {
+            return;
+        }
+
+        auto id = iterator->first;
+        auto& slot = iterator->second;
+
+        if (!proceedTimeout(*slot.connection))
+        {
+            closeConnection(id, slot);
+            return;
+        }
+
+        // Submitted receive is completed, so it
+        // doesn't hold socket after response
+        if (slot.receiving)
+        {
+            shutdown(slot.connection->socket(), SHUT_RD);
+        }
+
+        proceedConnection(id, slot);
+    });
+}
+
+uint64_t HTTPUringWorker::userData(uint64_t id, HTTPUringWorker::Operation operation)
+{
+    return (id << 8) | static_cast<uint64_t>(operation);
+}
@@ -0,0 +1,616 @@
+#include <csignal>
+#include <exception>
+#include <coroutine>
+#include <pthread.h>
+#include <netinet/tcp.h>
+#include <CurrentLogger.hpp>
+#include <Tools/SocketTools.hpp>
+#include "HTTPWorker.hpp"
+#include "HTTPServer.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log site of failed handlers.
+ */
+static const HTTPLog::Site HandlerFailedSite{HTTPLog::Level::Error, "Request handler failed. Error: {}", 1, 10};
+
+/**
+ * @brief Function for setting integer socket option.
+ * @param socket Socket.
+ * @param level Option level.
+ * @param option Option name.
+ * @param value Option value.
+ * @return Setting success.
+ */
+static bool setSocketOption(socket_t socket, int level, int option, int value)
+{
+    return setsockopt(socket, level, option, &value, sizeof(value)) == 0;
+}
+
+/**
+ * @brief Log sites of load shedding.
+ */
+static const HTTPLog::Site ConnectionRejectedSite{
+    HTTPLog::Level::Warning,
+    "Connections limit is reached. Connection from {} is rejected.",
+    1,
+    10
+};
+static const HTTPLog::Site RequestRejectedSite{
+    HTTPLog::Level::Warning,
+    "In-flight requests limit is reached. Request from {} is rejected.",
+    1,
+    10
+};
+
+/**
+ * @brief Log site of request, that
+ * was not received in time.
+ */
+static const HTTPLog::Site RequestTimeoutSite{HTTPLog::Level::Warning, "Request timeout for {}", 1, 10};
+
+namespace
+{
+    /**
+     * @brief Coroutine, that is started eagerly
+     * and destroys itself when finished.
+     */
+    struct DetachedTask
+    {
+        struct promise_type
+        {
+            DetachedTask get_return_object() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept
+            {
+
+            }
+
+            void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+}
+
+/**
+ * @brief Coroutine, that awaits handler task
+ * and passes it's response to finishing function.
+ * Exceptions of handler are answered with
+ * `InternalServerError`, as there is no caller
+ * to propagate them to.
+ * @param task Handler task.
+ * @param finish Finishing function.
+ */
+static DetachedTask driveHandling(Task<HTTPResponse> task,
+                                  std::function<void(HTTPResponse)> finish)
+{
+    HTTPResponse response;
+
+    try
+    {
+        response = co_await task;
+    }
+    catch (const std::exception& exception)
+    {
+        HTTPLog::write(HandlerFailedSite, exception.what());
+
+        response = HTTPResponse();
+        response.version() = "HTTP/1.1";
+        response.statusCode() = HTTPResponse::StatusCode::InternalServerError;
+    }
+
+    finish(std::move(response));
+}
+
+HTTPWorker::HTTPWorker(HTTPServer& server) :
+    m_server(server),
+    m_executor(),
+    m_timers(),
+    m_metrics(server.m_metricsPath.empty() ? nullptr : &server.m_metrics.createShard()),
+    m_handling(nullptr),
+    m_maxConnections(0),
+    m_maxInflightRequests(0),
+    m_inflightRequests(0)
+{
+
+}
+
+void HTTPWorker::setLimits(std::size_t maxConnections, std::size_t maxInflightRequests)
+{
+    m_maxConnections = maxConnections;
+    m_maxInflightRequests = maxInflightRequests;
+}
+
+socket_t HTTPWorker::createListener(uint32_t address, uint16_t port, const HTTPServerOptions& options)
+{
+    socket_t listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (listener == INVALID_SOCKET)
+    {
+        Error() << "Can't initialize socket. Error: " << strerror(errno);
+        return INVALID_SOCKET;
+    }
+
+    if (options.reuseAddress && !setSocketOption(listener, SOL_SOCKET, SO_REUSEADDR, 1))
+    {
+        Error() << "Can't set SO_REUSEADDR. Error: " << strerror(errno);
+        SocketTools::Close(listener);
+        return INVALID_SOCKET;
+    }
+
+    if (options.reusePort && !setSocketOption(listener, SOL_SOCKET, SO_REUSEPORT, 1))
+    {
+        Error() << "Can't set SO_REUSEPORT. Error: " << strerror(errno);
+        SocketTools::Close(listener);
+        return INVALID_SOCKET;
+    }
+
+    // Options are inherited by accepted sockets. Buffer
+    // sizes are set before listen, so window scale of
+    // connections is negotiated by them.
+    if (options.receiveBufferSize > 0 &&
+        !setSocketOption(listener, SOL_SOCKET, SO_RCVBUF, options.receiveBufferSize))
+    {
+        Warning() << "Can't set SO_RCVBUF. Error: " << strerror(errno);
+    }
+
+    if (options.sendBufferSize > 0 &&
+        !setSocketOption(listener, SOL_SOCKET, SO_SNDBUF, options.sendBufferSize))
+    {
+        Warning() << "Can't set SO_SNDBUF. Error: " << strerror(errno);
+    }
+
+    if (options.noDelay && !setSocketOption(listener, IPPROTO_TCP, TCP_NODELAY, 1))
+    {
+        Warning() << "Can't set TCP_NODELAY. Error: " << strerror(errno);
+    }
+
+    sockaddr_in addr{0};
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(address);
+
+    if (bind(listener, (const sockaddr*) &addr, sizeof(sockaddr_in)) == -1)
+    {
+        Error() << "Can't bind socket. Error: " << strerror(errno);
+        SocketTools::Close(listener);
+        return INVALID_SOCKET;
+    }
+
+    if (listen(listener, options.backlog) == -1)
+    {
+        Error() << "Can't set socket listen. Error: " << strerror(errno);
+        SocketTools::Close(listener);
+        return INVALID_SOCKET;
+    }
+
+    // Kernel may not support these options,
+    // server works without them
+    if (options.deferAccept.count() > 0 &&
+        !setSocketOption(listener, IPPROTO_TCP, TCP_DEFER_ACCEPT, static_cast<int>(options.deferAccept.count())))
+    {
+        Warning() << "Can't set TCP_DEFER_ACCEPT. Error: " << strerror(errno);
+    }
+
+    if (options.fastOpenQueue > 0 &&
+        !setSocketOption(listener, IPPROTO_TCP, TCP_FASTOPEN, options.fastOpenQueue))
+    {
+        Warning() << "Can't set TCP_FASTOPEN. Error: " << strerror(errno);
+    }
+
+    return listener;
+}
+
+void HTTPWorker::blockPipeSignal()
+{
+    // sendfile can't receive MSG_NOSIGNAL, so SIGPIPE
+    // is blocked for worker thread instead
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+}
+
+void HTTPWorker::proceedBody(HTTPConnection& connection)
+{
+    if (!admitRequest(connection))
+    {
+        // Response is sent as is, request
+        // body is never read
+        HTTPLog::write(RequestRejectedSite, connection.address());
+
+        connection.setRawResponse(
+            m_server.m_unavailableResponse.data(),
+            m_server.m_unavailableResponse.size()
+        );
+        connection.setState(HTTPConnection::State::Writing);
+
+        if (m_metrics)
+        {
+            m_metrics->recordStatus(HTTPResponse::StatusCode::ServiceUnavailable);
+        }
+
+        return;
+    }
+
+    if (!connection.prepareBody(m_server.m_maxBodySize))
+    {
+        // Request has no body or it's malformed
+        return;
+    }
+
+    connection.beginBody(m_server.createBodyHandler(connection.request()));
+}
+
+void HTTPWorker::proceedHandling(HTTPConnection& connection, std::function<void()> resume)
+{
+    connection.setState(HTTPConnection::State::Handling);
+
+    auto& request = connection.request();
+
+    bool keepAlive = isKeepAliveRequested(request) &&
+                     !connection.isPeerClosed() &&
+                     !connection.isBodyAborted() &&
+                     connection.requestsCount() + 1 < m_server.m_maxKeepAliveRequests;
+
+    bool headOnly = request.method() == HTTPRequest::Method::HEAD;
+
+    // Request is moved to handler, so it's
+    // labels are taken before
+    auto method = request.method();
+    auto started = m_metrics ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    if (m_metrics && isMetricsRequest(request))
+    {
+        auto response = metricsResponse(request);
+
+        recordHandling(method, 0, started, response);
+        finishHandling(connection, std::move(response), keepAlive, headOnly);
+        return;
+    }
+
+    HTTPMetrics::setRoute(0);
+
+    if (connection.bodyHandler())
+    {
+        auto response = connection.bodyHandler()->finish(std::move(request));
+
+        recordHandling(method, HTTPMetrics::takeRoute(), started, response);
+        finishHandling(connection, std::move(response), keepAlive, headOnly);
+        return;
+    }
+
+    auto task = m_server.proceedRequestAsync(request);
+
+    // Route is set by handler before it's suspended
+    auto route = HTTPMetrics::takeRoute();
+
+    if (task.isReady())
+    {
+        auto response = task.result();
+
+        recordHandling(method, route, started, response);
+        finishHandling(connection, std::move(response), keepAlive, headOnly);
+        return;
+    }
+
+    // Handler may finish without suspending, then
+    // caller continues with connection by itself
+    m_handling = &connection;
+
+    driveHandling(
+        std::move(task),
+        [this, &connection, keepAlive, headOnly, method, route, started, resume = std::move(resume)]
+        (HTTPResponse response)
+        {
+            recordHandling(method, route, started, response);
+            finishHandling(connection, std::move(response), keepAlive, headOnly);
+
+            if (m_handling != &connection)
+            {
+                resume();
+            }
+        }
+    );
+
+    m_handling = nullptr;
+}
+
+void HTTPWorker::finishHandling(HTTPConnection& connection,
+                                HTTPResponse response,
+                                bool keepAlive,
+                                bool headOnly)
+{
+    connection.setResponse(std::move(response), keepAlive, headOnly);
+    connection.setState(HTTPConnection::State::Writing);
+}
+
+void HTTPWorker::proceedError(HTTPConnection& connection, HTTPResponse::StatusCode code)
+{
+    HTTPResponse response;
+
+    response.version() = "HTTP/1.1";
+    response.statusCode() = code;
+
+    if (m_metrics)
+    {
+        m_metrics->recordStatus(code);
+    }
+
+    connection.setResponse(std::move(response), false, false);
+    connection.setState(HTTPConnection::State::Writing);
+}
+
+bool HTTPWorker::admitConnection(socket_t socket, const sockaddr_in& address, std::size_t connectionsCount)
+{
+    if (m_maxConnections == 0 || connectionsCount < m_maxConnections)
+    {
+        return true;
+    }
+
+    HTTPLog::write(ConnectionRejectedSite, address);
+
+    // Response is small, so it fits into socket
+    // buffer of new connection
+    ::send(
+        socket,
+        m_server.m_unavailableResponse.data(),
+        m_server.m_unavailableResponse.size(),
+        MSG_NOSIGNAL | MSG_DONTWAIT
+    );
+
+    SocketTools::Close(socket);
+
+    if (m_metrics)
+    {
+        m_metrics->recordStatus(HTTPResponse::StatusCode::ServiceUnavailable);
+    }
+
+    return false;
+}
+
+void HTTPWorker::recordAccepted()
+{
+    if (m_metrics)
+    {
+        HTTPMetrics::add(m_metrics->connections);
+    }
+}
+
+void HTTPWorker::finishRequest(HTTPConnection& connection)
+{
+    if (connection.isAdmitted())
+    {
+        connection.setAdmitted(false);
+        --m_inflightRequests;
+    }
+
+    if (m_metrics == nullptr)
+    {
+        return;
+    }
+
+    uint64_t received;
+    uint64_t sent;
+
+    connection.takeTraffic(received, sent);
+
+    m_metrics->recordTraffic(received, sent);
+}
+
+void HTTPWorker::releaseConnection(HTTPConnection& connection)
+{
+    // Connection may be destroyed later, if
+    // it has submitted operations
+    connection.timer().cancel();
+
+    finishRequest(connection);
+}
+
+bool HTTPWorker::admitRequest(HTTPConnection& connection)
+{
+    if (m_maxInflightRequests > 0 && m_inflightRequests >= m_maxInflightRequests)
+    {
+        return false;
+    }
+
+    connection.setAdmitted(true);
+    ++m_inflightRequests;
+
+    return true;
+}
+
+void HTTPWorker::recordHandling(HTTPRequest::Method method,
+                                std::size_t route,
+                                std::chrono::steady_clock::time_point started,
+                                const HTTPResponse& response)
+{
+    if (m_metrics == nullptr)
+    {
+        return;
+    }
+
+    m_metrics->recordRequest(
+        method,
+        route,
+        std::chrono::steady_clock::now() - started,
+        response.statusCode()
+    );
+}
+
+bool HTTPWorker::isMetricsRequest(const HTTPRequest& request) const
+{
+    if (request.method() != HTTPRequest::Method::GET &&
+        request.method() != HTTPRequest::Method::HEAD)
+    {
+        return false;
+    }
+
+    auto uri = request.uri();
+
+    return uri.substr(0, uri.find('?')) == m_server.m_metricsPath;
+}
+
+HTTPResponse HTTPWorker::metricsResponse(const HTTPRequest& request) const
+{
+    HTTPResponse response(request.memoryResource());
+
+    response.version() = "HTTP/1.1";
+    response.statusCode() = HTTPResponse::StatusCode::Ok;
+    response.header().addHeader({"Content-Type", "text/plain; version=0.0.4"});
+    response.setData(m_server.m_metrics.serialize());
+
+    return response;
+}
+
+void HTTPWorker::updateTimeout(HTTPConnection& connection)
+{
+    auto timeout = HTTPConnection::Timeout::None;
+
+    switch (connection.state())
+    {
+    case HTTPConnection::State::Reading:
+        if (connection.isBodyExpected())
+        {
+            timeout = HTTPConnection::Timeout::Body;
+        }
+        else if (connection.isRequestStarted())
+        {
+            timeout = HTTPConnection::Timeout::Header;
+        }
+        else
+        {
+            timeout = HTTPConnection::Timeout::KeepAlive;
+        }
+        break;
+
+    case HTTPConnection::State::Writing:
+        timeout = HTTPConnection::Timeout::Write;
+        break;
+
+    case HTTPConnection::State::Handling:
+        // Handler isn't limited by server
+        break;
+    }
+
+    // Waiting for request is limited from it's
+    // start, transfer is limited between events
+    if (timeout == connection.timeout() &&
+        (timeout == HTTPConnection::Timeout::KeepAlive ||
+         timeout == HTTPConnection::Timeout::Header))
+    {
+        return;
+    }
+
+    connection.setTimeout(timeout);
+
+    switch (timeout)
+    {
+    case HTTPConnection::Timeout::None:
+        connection.timer().cancel();
+        break;
+
+    case HTTPConnection::Timeout::KeepAlive:
+        m_timers.arm(connection.timer(), m_server.m_keepAliveTimeout);
+        break;
+
+    case HTTPConnection::Timeout::Header:
+        m_timers.arm(connection.timer(), m_server.m_headerTimeout);
+        break;
+
+    case HTTPConnection::Timeout::Body:
+        m_timers.arm(connection.timer(), m_server.m_bodyTimeout);
+        break;
+
+    case HTTPConnection::Timeout::Write:
+        m_timers.arm(connection.timer(), m_server.m_writeTimeout);
+        break;
+    }
+}
+
+bool HTTPWorker::proceedTimeout(HTTPConnection& connection)
+{
+    auto timeout = connection.timeout();
+
+    connection.setTimeout(HTTPConnection::Timeout::None);
+
+    if (timeout != HTTPConnection::Timeout::Header &&
+        timeout != HTTPConnection::Timeout::Body)
+    {
+        return false;
+    }
+
+    HTTPLog::write(RequestTimeoutSite, connection.address());
+
+    proceedError(connection, HTTPResponse::StatusCode::RequestTimeout);
+
+    return true;
+}
+
+bool HTTPWorker::isKeepAliveRequested(const HTTPRequest& request)
+{
+    // HTTP/1.1 connections are persistent by default,
+    // HTTP/1.0 ones have to request it explicitly.
+    bool keepAlive = request.version() == "HTTP/1.1";
+
+    for (HTTPHeader::HeadersContainer::size_type i = 0;
+         i < request.header().numberOfHeaders();
+         ++i)
+    {
+        if (request.header().token(i) != HTTPHeader::Token::Connection)
+        {
+            continue;
+        }
+
+        auto value = request.header().header(i).second;
+
+        // Field value is comma separated list of
+        // tokens, like "Keep-Alive, TE"
+        while (!value.empty())
+        {
+            auto separator = value.find(',');
+            auto option = value.substr(0, separator);
+
+            value.remove_prefix(separator == std::string_view::npos ? value.size() : separator + 1);
+
+            auto begin = option.find_first_not_of(" \t");
+
+            if (begin == std::string_view::npos)
+            {
+                continue;
+            }
+
+            option = option.substr(begin, option.find_last_not_of(" \t") - begin + 1);
+
+            // Close wins over any other token
+            if (HTTPHeader::equalsIgnoreCase(option, "close"))
+            {
+                return false;
+            }
+
+            if (HTTPHeader::equalsIgnoreCase(option, "keep-alive") &&
+                request.version() == "HTTP/1.0")
+            {
+                keepAlive = true;
+            }
+        }
+    }
+
+    return keepAlive;
+}
@@ -0,0 +1,158 @@
+#include "JSONBodyStream.hpp"
+
+// Public API of nlohmann/json serializes only into new
+// strings, so scalars are written by it's serializer
+// through output adapter. These are library internals,
+// they are used only by this writer and are checked
+// with nlohmann/json 3.11.
+static_assert(
+    NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 11,
+    "JSONBodyStream::Writer uses internals of nlohmann/json 3.11."
+);
+
+class JSONBodyStream::Writer
+{
+public:
+
+    Writer() :
+        m_adapter(),
+        m_serializer(std::shared_ptr<Adapter>(std::shared_ptr<Adapter>(), &m_adapter), ' '),
+        m_key(nlohmann::json::value_t::string)
+    {
+
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    void setBuffer(std::vector<std::byte>* buffer)
+    {
+        m_adapter.buffer = buffer;
+    }
+
+    void writeCharacter(char c)
+    {
+        m_adapter.write_character(c);
+    }
+
+    void writeScalar(const nlohmann::json& value)
+    {
+        m_serializer.dump(value, false, false, 0);
+    }
+
+    void writeKey(const std::string& key)
+    {
+        // Key is escaped by serializer through
+        // string, that keeps capacity
+        m_key.get_ref<std::string&>() = key;
+
+        m_serializer.dump(m_key, false, false, 0);
+    }
+
+private:
+
+    /**
+     * @brief Output adapter, that appends
+     * characters to current buffer.
+     */
+    class Adapter : public nlohmann::detail::output_adapter_protocol<char>
+    {
+    public:
+
+        void write_character(char c) override
+        {
+            buffer->push_back(static_cast<std::byte>(c));
+        }
+
+        void write_characters(const char* s, std::size_t length) override
+        {
+            auto* data = reinterpret_cast<const std::byte*>(s);
+
+            buffer->insert(buffer->end(), data, data + length);
+        }
+
+        std::vector<std::byte>* buffer = nullptr;
+    };
+
+    // Serializer doesn't own adapter, that
+    // lives as long as writer
+    Adapter m_adapter;
+    nlohmann::detail::serializer<nlohmann::json> m_serializer;
+    nlohmann::json m_key;
+};
+
+JSONBodyStream::JSONBodyStream(nlohmann::json value, std::pmr::memory_resource* resource) :
+    m_value(std::move(value)),
+    m_writer(std::allocate_shared<Writer>(
+        std::pmr::polymorphic_allocator<Writer>(resource)
+    )),
+    m_stack(resource),
+    m_started(false)
+{
+
+}
+
+bool JSONBodyStream::write(std::vector<std::byte>& buffer, std::size_t size)
+{
+    m_writer->setBuffer(&buffer);
+
+    if (!m_started)
+    {
+        m_started = true;
+
+        writeValue(m_value);
+    }
+
+    auto limit = buffer.size() + size;
+
+    while (!m_stack.empty() && buffer.size() < limit)
+    {
+        step();
+    }
+
+    m_writer->setBuffer(nullptr);
+
+    return !m_stack.empty();
+}
+
+void JSONBodyStream::step()
+{
+    auto& frame = m_stack.back();
+    bool isObject = frame.container->is_object();
+
+    if (frame.position == frame.container->cend())
+    {
+        m_writer->writeCharacter(isObject ? '}' : ']');
+        m_stack.pop_back();
+        return;
+    }
+
+    if (frame.position != frame.container->cbegin())
+    {
+        m_writer->writeCharacter(',');
+    }
+
+    // Iterator is advanced before value is written,
+    // because frame is invalidated by push
+    auto position = frame.position++;
+
+    if (isObject)
+    {
+        m_writer->writeKey(position.key());
+        m_writer->writeCharacter(':');
+    }
+
+    writeValue(*position);
+}
+
+void JSONBodyStream::writeValue(const nlohmann::json& value)
+{
+    if (value.is_structured() && !value.empty())
+    {
+        m_writer->writeCharacter(value.is_object() ? '{' : '[');
+        m_stack.push_back(Frame{&value, value.cbegin()});
+        return;
+    }
+
+    m_writer->writeScalar(value);
+}
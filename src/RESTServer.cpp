@@ -1,32 +1,68 @@
-#include <CurrentLogger.hpp>
+#include <cstdint>
+#include <charconv>
 #include "RESTServer.hpp"
+#include "JSONBodyStream.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of command processing.
+ */
+static const HTTPLog::Site SplitUriSite{HTTPLog::Level::Error, "Can't split uri to args.", 1, 10};
+static const HTTPLog::Site UnknownCommandSite{HTTPLog::Level::Error, "Unknown command \"{}\".", 1, 10};
+static const HTTPLog::Site UnknownMethodSite{HTTPLog::Level::Error, "Unknown method \"{}\" for command \"{}\".", 1, 10};
+static const HTTPLog::Site CommandSite{HTTPLog::Level::Info, "Requested command \"{}\".", 1, 100};
+static const HTTPLog::Site DecodeBodySite{HTTPLog::Level::Error, "Can't decode request body. What: {}", 1, 10};
+static const HTTPLog::Site ExceptionSite{HTTPLog::Level::Error, "Received exception. What: {}", 1, 10};
 
 RESTServer::RESTServer() :
-    m_processors(),
-    m_errorProcessor(&RESTServer::defaultErrorProcessor),
-    m_dataBuffer()
+    m_router(),
+    m_errorProcessor(&RESTServer::defaultErrorProcessor)
 {
 
 }
 
 HTTPResponse RESTServer::proceedRequest(HTTPRequest request)
 {
-    std::string_view mainUri;
-    Arguments args;
+    auto* resource = request.memoryResource();
 
-    nlohmann::json result = proceedREST(std::move(request));
+    auto encoding = acceptedEncoding(request.header().get(HTTPHeader::Token::Accept));
 
-    m_dataBuffer = result.dump();
+    nlohmann::json result = proceedREST(std::move(request));
 
-    HTTPResponse response;
+    HTTPResponse response(resource);
     response.version() = "HTTP/1.1";
     response.statusCode() = HTTPResponse::StatusCode::Ok;
-    response.setData(
-        (std::byte*) m_dataBuffer.c_str(),
-        m_dataBuffer.length()
-    );
 
-    response.header().addHeader({"Content-Type", "application/json"});
+    if (encoding == Encoding::JSON)
+    {
+        // Result is serialized in parts, while
+        // response is sent
+        response.setStream(std::allocate_shared<JSONBodyStream>(
+            std::pmr::polymorphic_allocator<JSONBodyStream>(resource),
+            std::move(result),
+            resource
+        ));
+    }
+    else
+    {
+        // Binary encodings are compact, so
+        // they are written whole
+        std::string data;
+
+        if (encoding == Encoding::CBOR)
+        {
+            nlohmann::json::to_cbor(result, data);
+        }
+        else
+        {
+            nlohmann::json::to_msgpack(result, data);
+        }
+
+        response.setData(std::move(data));
+    }
+
+    response.header().addHeader({"Content-Type", encodingMediaType(encoding)});
+    response.header().addHeader({"Vary", "Accept"});
 
     return response;
 }
@@ -35,20 +71,20 @@ nlohmann::json RESTServer::proceedREST(HTTPRequest request)
 {
 
     std::string_view mainUri;
-    Arguments args;
+    Arguments args(request.memoryResource());
 
     if (!splitUri(request.uri(), mainUri, args))
     {
-        Error() << "Can't split uri to args.";
+        HTTPLog::write(SplitUriSite);
         return m_errorProcessor(ErrorCode::InvalidArguments, "Can't parse URI.");
     }
 
-    // Searching for command key
-    auto commandKey = m_processors.find(std::string(mainUri));
+    // Searching for command route
+    auto route = m_router.find(request.method(), mainUri);
 
-    if (commandKey == m_processors.end())
+    if (!route.pathFound)
     {
-        Error() << "Unknown command \"" << mainUri << "\".";
+        HTTPLog::write(UnknownCommandSite, mainUri);
         return m_errorProcessor(
             ErrorCode::UnknownCommand,
             std::string("Unknown command \"") + std::string(mainUri)+ "\"."
@@ -56,16 +92,9 @@ nlohmann::json RESTServer::proceedREST(HTTPRequest request)
     }
 
     // Searching for method in command
-    auto methodKey = commandKey->second.find(request.method());
-
-    if (methodKey == commandKey->second.end())
+    if (route.value == nullptr)
     {
-        Error()
-            << "Unknown method \""
-            << HTTPRequest::methodToString(request.method())
-            << "\" for command \""
-            << mainUri
-            << "\".";
+        HTTPLog::write(UnknownMethodSite, HTTPRequest::methodToString(request.method()), mainUri);
 
         return m_errorProcessor(
             ErrorCode::InvalidMethod,
@@ -77,15 +106,63 @@ nlohmann::json RESTServer::proceedREST(HTTPRequest request)
             );
     }
 
-    Info() << "Requested command \"" << mainUri << "\".";
+    HTTPMetrics::setRoute(route.value->route);
+
+    for (std::size_t i = 0; i < route.parametersCount; ++i)
+    {
+        args.setParameter(route.parameters[i].name, route.parameters[i].value);
+    }
+
+    HTTPLog::write(CommandSite, mainUri);
+
+    auto bodyEncoding = mediaTypeEncoding(request.header().get(HTTPHeader::Token::ContentType));
+
+    auto* data = request.data();
+    auto dataSize = request.dataSize();
+
+    // Body is decoded once, raw processor receives
+    // JSON text of binary encodings
+    nlohmann::json body;
+    std::string bodyText;
+
+    bool isBinary = dataSize > 0 && bodyEncoding && *bodyEncoding != Encoding::JSON;
+
+    if (route.value->jsonFunction || isBinary)
+    {
+        try
+        {
+            body = decodeBody(request, bodyEncoding.value_or(Encoding::JSON));
+        }
+        catch (nlohmann::json::exception& exception)
+        {
+            HTTPLog::write(DecodeBodySite, exception.what());
+            return m_errorProcessor(
+                ErrorCode::InvalidArguments,
+                std::string("Can't decode request body: ") + exception.what()
+            );
+        }
+    }
+
+    if (!route.value->jsonFunction && isBinary)
+    {
+        bodyText = body.dump();
+
+        data = reinterpret_cast<std::byte*>(bodyText.data());
+        dataSize = bodyText.size();
+    }
 
     try
     {
-        return methodKey->second(args, request.data(), request.dataSize());
+        if (route.value->jsonFunction)
+        {
+            return route.value->jsonFunction(std::move(args), body);
+        }
+
+        return route.value->function(std::move(args), data, dataSize);
     }
     catch (std::exception& exception)
     {
-        Error() << "Received exception. What: " << exception.what();
+        HTTPLog::write(ExceptionSite, exception.what());
         return m_errorProcessor(
             ErrorCode::ExceptionCaught,
             exception.what()
@@ -95,20 +172,16 @@ nlohmann::json RESTServer::proceedREST(HTTPRequest request)
 
 void RESTServer::addProcessor(HTTPRequest::Method method, std::string key, RESTServer::ProcessorFunction function)
 {
-    auto processor = m_processors.find(key);
+    auto route = metrics().addRoute(key);
 
-    if (processor == m_processors.end())
-    {
-        processor = m_processors.insert_or_assign(
-            key,
-            std::map<
-                HTTPRequest::Method,
-                ProcessorFunction
-            >()
-        ).first;
-    }
+    m_router.add(method, key, Command{std::move(function), nullptr, route});
+}
+
+void RESTServer::addProcessor(HTTPRequest::Method method, std::string key, RESTServer::JSONProcessorFunction function)
+{
+    auto route = metrics().addRoute(key);
 
-    processor->second[method] = std::move(function);
+    m_router.add(method, key, Command{nullptr, std::move(function), route});
 }
 
 void RESTServer::setErrorProcessor(RESTServer::ErrorProcessorFunction function)
@@ -116,79 +189,168 @@ void RESTServer::setErrorProcessor(RESTServer::ErrorProcessorFunction function)
     m_errorProcessor = std::move(function);
 }
 
-nlohmann::json RESTServer::defaultErrorProcessor(RESTServer::ErrorCode error, std::string info)
+RESTServer::Encoding RESTServer::acceptedEncoding(std::string_view accept)
 {
-    nlohmann::json result;
-    result["error_code"] = (int) error;
-    result["error_string"] = info;
+    auto result = Encoding::JSON;
+    double bestQuality = 0;
+
+    while (!accept.empty())
+    {
+        auto end = accept.find(',');
+        auto range = accept.substr(0, end);
+
+        accept = end == std::string_view::npos ? std::string_view() : accept.substr(end + 1);
+
+        double quality = 1;
+
+        auto parameters = range.find(';');
+
+        if (parameters != std::string_view::npos)
+        {
+            auto position = range.find("q=", parameters);
+
+            if (position != std::string_view::npos)
+            {
+                std::from_chars(range.data() + position + 2, range.data() + range.size(), quality);
+            }
+
+            range = range.substr(0, parameters);
+        }
+
+        while (!range.empty() && range.front() == ' ')
+        {
+            range.remove_prefix(1);
+        }
+
+        while (!range.empty() && range.back() == ' ')
+        {
+            range.remove_suffix(1);
+        }
+
+        auto encoding = mediaTypeEncoding(range);
+
+        // Any type is served with JSON
+        if (range == "*/*" || HTTPHeader::equalsIgnoreCase(range, "application/*"))
+        {
+            encoding = Encoding::JSON;
+        }
+
+        // First type wins on same quality
+        if (encoding && quality > bestQuality)
+        {
+            result = *encoding;
+            bestQuality = quality;
+        }
+    }
 
     return result;
 }
 
-bool RESTServer::splitUri(const std::string_view& uri, std::string_view& outPath, RESTServer::Arguments& arguments)
+std::optional<RESTServer::Encoding> RESTServer::mediaTypeEncoding(std::string_view mediaType)
 {
-    auto target = uri.find('?');
+    mediaType = mediaType.substr(0, mediaType.find(';'));
 
-    if (target == std::string_view::npos)
+    while (!mediaType.empty() && mediaType.front() == ' ')
     {
-        outPath = uri;
-        return true;
+        mediaType.remove_prefix(1);
     }
 
-    auto start = uri.find('/');
-    if (start != 1)
+    while (!mediaType.empty() && mediaType.back() == ' ')
     {
-        start = 0;
+        mediaType.remove_suffix(1);
     }
 
-    outPath = uri.substr(start, target - start);
-
-    auto separator = uri.find('=', target);
+    if (HTTPHeader::equalsIgnoreCase(mediaType, "application/json"))
+    {
+        return Encoding::JSON;
+    }
 
-    if (separator == std::string_view::npos)
+    if (HTTPHeader::equalsIgnoreCase(mediaType, "application/cbor"))
     {
-        // Search finished. There is no value for argument
-        return true;
+        return Encoding::CBOR;
     }
 
-    auto nextTarget = uri.find('&', separator + 1);
+    if (HTTPHeader::equalsIgnoreCase(mediaType, "application/msgpack") ||
+        HTTPHeader::equalsIgnoreCase(mediaType, "application/x-msgpack") ||
+        HTTPHeader::equalsIgnoreCase(mediaType, "application/vnd.msgpack"))
+    {
+        return Encoding::MessagePack;
+    }
 
-    auto finish = nextTarget;
+    return std::nullopt;
+}
 
-    if (finish == std::string_view::npos)
+std::string_view RESTServer::encodingMediaType(RESTServer::Encoding encoding)
+{
+    switch (encoding)
     {
-        finish = uri.size();
+    case Encoding::CBOR:
+        return "application/cbor";
+
+    case Encoding::MessagePack:
+        return "application/msgpack";
+
+    case Encoding::JSON:
+        break;
     }
 
-    arguments[uri.substr(target + 1, separator - target - 1)] =
-        uri.substr(separator + 1, finish - separator - 1);
+    return "application/json";
+}
+
+nlohmann::json RESTServer::decodeBody(const HTTPRequest& request, RESTServer::Encoding encoding)
+{
+    if (request.dataSize() == 0)
+    {
+        return nullptr;
+    }
 
-    target = uri.find('&', target);
+    auto* begin = reinterpret_cast<const std::uint8_t*>(request.data());
+    auto* end = begin + request.dataSize();
 
-    while (target != std::string_view::npos)
+    switch (encoding)
     {
-        auto separator = uri.find('=', target);
+    case Encoding::CBOR:
+        return nlohmann::json::from_cbor(begin, end);
 
-        if (separator == std::string_view::npos)
-        {
-            // Search finished. There is no value for argument
-            return true;
-        }
+    case Encoding::MessagePack:
+        return nlohmann::json::from_msgpack(begin, end);
 
-        auto nextTarget = uri.find('&', separator + 1);
+    case Encoding::JSON:
+        break;
+    }
 
-        finish = nextTarget;
+    return nlohmann::json::parse(begin, end);
+}
 
-        if (finish == std::string_view::npos)
-        {
-            finish = uri.size();
-        }
+nlohmann::json RESTServer::defaultErrorProcessor(RESTServer::ErrorCode error, std::string info)
+{
+    nlohmann::json result;
+    result["error_code"] = (int) error;
+    result["error_string"] = info;
 
-        arguments[uri.substr(target + 1, separator - target - 1)] =
-            uri.substr(separator + 1, finish - separator - 1);
+    return result;
+}
 
-        target = nextTarget;
+bool RESTServer::splitUri(const std::string_view& uri, std::string_view& outPath, RESTServer::Arguments& arguments)
+{
+    auto target = uri.find('?');
+
+    if (target == std::string_view::npos)
+    {
+        outPath = uri;
+        return true;
     }
 
+    auto start = uri.find('/');
+    if (start != 1)
+    {
+        start = 0;
+    }
+
+    outPath = uri.substr(start, target - start);
+
+    // Query is parsed only if processor reads arguments
+    arguments.setQuery(uri.substr(target + 1));
+
     return true;
 }
@@ -0,0 +1,259 @@
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include "ResponseWriter.hpp"
+
+/**
+ * @brief Reason phrase of status code.
+ */
+struct StatusReason
+{
+    HTTPResponse::StatusCode code;
+    std::string_view reason;
+};
+
+static constexpr StatusReason StatusReasons[] = {
+    {HTTPResponse::StatusCode::Continue,                      "Continue"},
+    {HTTPResponse::StatusCode::SwitchingProtocols,            "SwitchingProtocols"},
+    {HTTPResponse::StatusCode::Processing,                    "Processing"},
+    {HTTPResponse::StatusCode::EarlyHints,                    "EarlyHints"},
+    {HTTPResponse::StatusCode::Ok,                            "OK"},
+    {HTTPResponse::StatusCode::Created,                       "Created"},
+    {HTTPResponse::StatusCode::Accepted,                      "Accepted"},
+    {HTTPResponse::StatusCode::NonAuthoritativeInformation,   "NonAuthoritativeInformation"},
+    {HTTPResponse::StatusCode::NoContent,                     "NoContent"},
+    {HTTPResponse::StatusCode::ResetContent,                  "ResetContent"},
+    {HTTPResponse::StatusCode::PartialContent,                "PartialContent"},
+    {HTTPResponse::StatusCode::MultiStatus,                   "MultiStatus"},
+    {HTTPResponse::StatusCode::AlreadyReported,               "AlreadyReported"},
+    {HTTPResponse::StatusCode::IMUsed,                        "IMUsed"},
+    {HTTPResponse::StatusCode::MultipleChoices,               "MultipleChoices"},
+    {HTTPResponse::StatusCode::MovedPermanently,              "MovedPermanently"},
+    {HTTPResponse::StatusCode::Found,                         "Found"},
+    {HTTPResponse::StatusCode::SeeOther,                      "SeeOther"},
+    {HTTPResponse::StatusCode::NotModified,                   "NotModified"},
+    {HTTPResponse::StatusCode::UseProxy,                      "UseProxy"},
+    {HTTPResponse::StatusCode::SwitchProxy,                   "SwitchProxy"},
+    {HTTPResponse::StatusCode::TemporaryRedirect,             "TemporaryRedirect"},
+    {HTTPResponse::StatusCode::PermanentRedirect,             "PermanentRedirect"},
+    {HTTPResponse::StatusCode::BadRequest,                    "BadRequest"},
+    {HTTPResponse::StatusCode::Unauthorized,                  "Unauthorized"},
+    {HTTPResponse::StatusCode::PaymentRequired,               "PaymentRequired"},
+    {HTTPResponse::StatusCode::Forbidden,                     "Forbidden"},
+    {HTTPResponse::StatusCode::NotFound,                      "NotFound"},
+    {HTTPResponse::StatusCode::MethodNotAllowed,              "MethodNotAllowed"},
+    {HTTPResponse::StatusCode::NotAcceptable,                 "NotAcceptable"},
+    {HTTPResponse::StatusCode::ProxyAuthenticationRequired,   "ProxyAuthenticationRequired"},
+    {HTTPResponse::StatusCode::RequestTimeout,                "RequestTimeout"},
+    {HTTPResponse::StatusCode::Conflict,                      "Conflict"},
+    {HTTPResponse::StatusCode::Gone,                          "Gone"},
+    {HTTPResponse::StatusCode::LengthRequired,                "LengthRequired"},
+    {HTTPResponse::StatusCode::PreconditionFailed,            "PreconditionFailed"},
+    {HTTPResponse::StatusCode::PayloadTooLarge,               "PayloadTooLarge"},
+    {HTTPResponse::StatusCode::URITooLong,                    "URITooLong"},
+    {HTTPResponse::StatusCode::UnsupportedMediaType,          "UnsupportedMediaType"},
+    {HTTPResponse::StatusCode::RangeNotSatisfiable,           "RangeNotSatisfiable"},
+    {HTTPResponse::StatusCode::ExpectationFailed,             "ExpectationFailed"},
+    {HTTPResponse::StatusCode::ImTeapot,                      "ImTeapot"},
+    {HTTPResponse::StatusCode::MisdirectedRequest,            "MisdirectedRequest"},
+    {HTTPResponse::StatusCode::UnprocessableEntity,           "UnprocessableEntity"},
+    {HTTPResponse::StatusCode::Locked,                        "Locked"},
+    {HTTPResponse::StatusCode::FailedDependency,              "FailedDependency"},
+    {HTTPResponse::StatusCode::UpgradeRequired,               "UpgradeRequired"},
+    {HTTPResponse::StatusCode::PreconditionRequired,          "PreconditionRequired"},
+    {HTTPResponse::StatusCode::TooManyRequests,               "TooManyRequests"},
+    {HTTPResponse::StatusCode::RequestHeaderFieldsTooLarge,   "RequestHeaderFieldsTooLarge"},
+    {HTTPResponse::StatusCode::UnavailableForLegalReasons,    "UnavailableForLegalReasons"},
+    {HTTPResponse::StatusCode::InternalServerError,           "InternalServerError"},
+    {HTTPResponse::StatusCode::NotImplemented,                "NotImplemented"},
+    {HTTPResponse::StatusCode::BadGateway,                    "BadGateway"},
+    {HTTPResponse::StatusCode::ServiceUnavailable,            "ServiceUnavailable"},
+    {HTTPResponse::StatusCode::GatewayTimeout,                "GatewayTimeout"},
+    {HTTPResponse::StatusCode::HTTPVersionNotSupported,       "HTTPVersionNotSupported"},
+    {HTTPResponse::StatusCode::VariantAlsoNegotiates,         "VariantAlsoNegotiates"},
+    {HTTPResponse::StatusCode::InsufficientStorage,           "InsufficientStorage"},
+    {HTTPResponse::StatusCode::LoopDetected,                  "LoopDetected"},
+    {HTTPResponse::StatusCode::NotExtended,                   "NotExtended"},
+    {HTTPResponse::StatusCode::NetworkAuthenticationRequired, "NetworkAuthenticationRequired"}
+};
+
+static constexpr std::string_view StatusLineVersion = "HTTP/1.1";
+
+/**
+ * @brief Status codes are 3 digit numbers.
+ */
+static constexpr std::size_t MaxStatusCode = 599;
+
+/**
+ * @brief Function for calculating size of
+ * all status lines.
+ * @return Size in bytes.
+ */
+static constexpr std::size_t statusLinesSize()
+{
+    std::size_t result = 0;
+
+    for (auto&& status : StatusReasons)
+    {
+        // "HTTP/1.1 200 OK\r\n"
+        result += StatusLineVersion.size() + 5 + status.reason.size() + 2;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Pre-rendered status lines. Line
+ * of code is `text[offsets[code], sizes[code]]`.
+ */
+struct StatusLineTable
+{
+    char text[statusLinesSize()];
+    uint16_t offsets[MaxStatusCode + 1];
+    uint8_t sizes[MaxStatusCode + 1];
+};
+
+/**
+ * @brief Function for rendering status lines.
+ * @return Table of status lines.
+ */
+static constexpr StatusLineTable buildStatusLines()
+{
+    StatusLineTable table{};
+
+    std::size_t offset = 0;
+
+    auto append = [&table, &offset](std::string_view data)
+    {
+        for (auto c : data)
+        {
+            table.text[offset++] = c;
+        }
+    };
+
+    for (auto&& status : StatusReasons)
+    {
+        auto code = static_cast<std::size_t>(status.code);
+
+        table.offsets[code] = static_cast<uint16_t>(offset);
+
+        append(StatusLineVersion);
+        append(" ");
+
+        table.text[offset++] = static_cast<char>('0' + code / 100);
+        table.text[offset++] = static_cast<char>('0' + code / 10 % 10);
+        table.text[offset++] = static_cast<char>('0' + code % 10);
+
+        append(" ");
+        append(status.reason);
+        append("\r\n");
+
+        table.sizes[code] = static_cast<uint8_t>(offset - table.offsets[code]);
+    }
+
+    return table;
+}
+
+static constexpr StatusLineTable StatusLines = buildStatusLines();
+
+ResponseWriter::ResponseWriter(std::vector<std::byte>& buffer) :
+    m_buffer(buffer)
+{
+
+}
+
+void ResponseWriter::writeStatusLine(std::string_view version, HTTPResponse::StatusCode code)
+{
+    if (version == StatusLineVersion)
+    {
+        auto line = statusLine(code);
+
+        if (!line.empty())
+        {
+            append(line);
+            return;
+        }
+    }
+
+    // Other versions and codes are rendered
+    char digits[16];
+
+    auto result = std::to_chars(std::begin(digits), std::end(digits), static_cast<int>(code));
+
+    append(version);
+    append(" ");
+    append(std::string_view(digits, result.ptr - digits));
+    append(" ");
+    append(reasonPhrase(code));
+    append("\r\n");
+}
+
+void ResponseWriter::writeField(std::string_view name, std::string_view value)
+{
+    append(name);
+    append(": ");
+    append(value);
+    append("\r\n");
+}
+
+void ResponseWriter::writeHeader(const HTTPHeader& header)
+{
+    for (HTTPHeader::HeadersContainer::size_type i = 0;
+         i < header.numberOfHeaders();
+         ++i)
+    {
+        auto field = header.header(i);
+
+        writeField(field.first, field.second);
+    }
+}
+
+void ResponseWriter::writeEnd()
+{
+    append("\r\n");
+}
+
+void ResponseWriter::writeHead(const HTTPResponse& response)
+{
+    writeStatusLine(response.version(), response.statusCode());
+    writeHeader(response.header());
+    writeEnd();
+}
+
+std::string_view ResponseWriter::statusLine(HTTPResponse::StatusCode code)
+{
+    auto index = static_cast<std::size_t>(code);
+
+    if (index > MaxStatusCode || StatusLines.sizes[index] == 0)
+    {
+        return {};
+    }
+
+    return std::string_view(
+        StatusLines.text + StatusLines.offsets[index],
+        StatusLines.sizes[index]
+    );
+}
+
+std::string_view ResponseWriter::reasonPhrase(HTTPResponse::StatusCode code)
+{
+    auto line = statusLine(code);
+
+    if (line.empty())
+    {
+        return "Unknown";
+    }
+
+    // Without "HTTP/1.1 200 " and CRLF
+    return line.substr(
+        StatusLineVersion.size() + 5,
+        line.size() - StatusLineVersion.size() - 5 - 2
+    );
+}
+
+void ResponseWriter::append(std::string_view data)
+{
+    auto* begin = reinterpret_cast<const std::byte*>(data.data());
+
+    m_buffer.insert(m_buffer.end(), begin, begin + data.size());
+}
@@ -0,0 +1,300 @@
+#include <array>
+#include <cerrno>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "StaticFileServer.hpp"
+#include "HTTPLog.hpp"
+
+/**
+ * @brief Log sites of file requests.
+ */
+static const HTTPLog::Site WrongPathSite{HTTPLog::Level::Warning, "Wrong file path requested \"{}\".", 1, 10};
+static const HTTPLog::Site OpenFileSite{HTTPLog::Level::Warning, "Can't open file \"{}\". Error: {}", 1, 10};
+static const HTTPLog::Site NotRegularSite{HTTPLog::Level::Warning, "Requested path \"{}\" is not a regular file.", 1, 10};
+static const HTTPLog::Site FileSite{HTTPLog::Level::Info, "Requested file \"{}\".", 1, 100};
+static const HTTPLog::Site NotMountedSite{HTTPLog::Level::Warning, "No directory is mounted for \"{}\".", 1, 10};
+
+/**
+ * @brief Content types of known file extensions.
+ */
+static constexpr std::array<std::pair<std::string_view, std::string_view>, 28> ContentTypes = {{
+    {"html",  "text/html; charset=utf-8"},
+    {"htm",   "text/html; charset=utf-8"},
+    {"css",   "text/css; charset=utf-8"},
+    {"js",    "text/javascript; charset=utf-8"},
+    {"mjs",   "text/javascript; charset=utf-8"},
+    {"json",  "application/json"},
+    {"map",   "application/json"},
+    {"txt",   "text/plain; charset=utf-8"},
+    {"csv",   "text/csv; charset=utf-8"},
+    {"xml",   "application/xml"},
+    {"svg",   "image/svg+xml"},
+    {"png",   "image/png"},
+    {"jpg",   "image/jpeg"},
+    {"jpeg",  "image/jpeg"},
+    {"gif",   "image/gif"},
+    {"webp",  "image/webp"},
+    {"ico",   "image/x-icon"},
+    {"pdf",   "application/pdf"},
+    {"wasm",  "application/wasm"},
+    {"woff",  "font/woff"},
+    {"woff2", "font/woff2"},
+    {"ttf",   "font/ttf"},
+    {"mp4",   "video/mp4"},
+    {"webm",  "video/webm"},
+    {"mp3",   "audio/mpeg"},
+    {"wav",   "audio/wav"},
+    {"zip",   "application/zip"},
+    {"gz",    "application/gzip"},
+}};
+
+static int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+StaticFileServer::StaticFileServer() :
+    m_directories()
+{
+
+}
+
+void StaticFileServer::addDirectory(std::string prefix, std::string directory)
+{
+    // Trailing slashes are not significant
+    while (!prefix.empty() && prefix.back() == '/')
+    {
+        prefix.pop_back();
+    }
+
+    while (directory.size() > 1 && directory.back() == '/')
+    {
+        directory.pop_back();
+    }
+
+    m_directories.emplace_back(std::move(prefix), std::move(directory));
+
+    // Longest prefixes are checked first
+    std::stable_sort(
+        m_directories.begin(),
+        m_directories.end(),
+        [](const auto& lhs, const auto& rhs)
+        {
+            return lhs.first.size() > rhs.first.size();
+        }
+    );
+}
+
+std::string_view StaticFileServer::contentType(std::string_view path)
+{
+    auto dot = path.rfind('.');
+
+    if (dot == std::string_view::npos ||
+        path.find('/', dot) != std::string_view::npos)
+    {
+        return "application/octet-stream";
+    }
+
+    auto extension = path.substr(dot + 1);
+
+    for (auto&& element : ContentTypes)
+    {
+        if (element.first.size() == extension.size() &&
+            std::equal(
+                extension.begin(),
+                extension.end(),
+                element.first.begin(),
+                [](char lhs, char rhs)
+                {
+                    return std::tolower(static_cast<unsigned char>(lhs)) == rhs;
+                }
+            ))
+        {
+            return element.second;
+        }
+    }
+
+    return "application/octet-stream";
+}
+
+HTTPResponse StaticFileServer::proceedRequest(HTTPRequest request)
+{
+    if (request.method() != HTTPRequest::Method::GET &&
+        request.method() != HTTPRequest::Method::HEAD)
+    {
+        auto response = errorResponse(
+            HTTPResponse::StatusCode::MethodNotAllowed,
+            request.memoryResource()
+        );
+
+        response.header().addHeader({"Allow", "GET, HEAD"});
+
+        return response;
+    }
+
+    auto uri = request.uri();
+    uri = uri.substr(0, uri.find_first_of("?#"));
+
+    for (auto&& [prefix, directory] : m_directories)
+    {
+        if (uri.substr(0, prefix.size()) != prefix ||
+            (uri.size() > prefix.size() && uri[prefix.size()] != '/'))
+        {
+            continue;
+        }
+
+        std::pmr::string path(request.memoryResource());
+
+        if (!decodePath(uri.substr(prefix.size()), path))
+        {
+            HTTPLog::write(WrongPathSite, uri);
+            return errorResponse(HTTPResponse::StatusCode::NotFound, request.memoryResource());
+        }
+
+        path.insert(0, directory);
+
+        auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat status{};
+
+        if (file != -1 && ::fstat(file, &status) == 0 && S_ISDIR(status.st_mode))
+        {
+            ::close(file);
+
+            path.append("/").append(IndexFile);
+
+            file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        }
+
+        if (file == -1)
+        {
+            auto code = (errno == EACCES) ?
+                        HTTPResponse::StatusCode::Forbidden :
+                        HTTPResponse::StatusCode::NotFound;
+
+            HTTPLog::write(OpenFileSite, path, strerror(errno));
+            return errorResponse(code, request.memoryResource());
+        }
+
+        if (::fstat(file, &status) != 0 || !S_ISREG(status.st_mode))
+        {
+            ::close(file);
+
+            HTTPLog::write(NotRegularSite, path);
+            return errorResponse(HTTPResponse::StatusCode::NotFound, request.memoryResource());
+        }
+
+        HTTPLog::write(FileSite, path);
+
+        HTTPResponse response(request.memoryResource());
+        response.version() = "HTTP/1.1";
+        response.statusCode() = HTTPResponse::StatusCode::Ok;
+        response.setFile(file, 0, static_cast<std::size_t>(status.st_size));
+
+        response.header().addHeader({"Content-Type", contentType(path)});
+
+        return response;
+    }
+
+    HTTPLog::write(NotMountedSite, uri);
+    return errorResponse(HTTPResponse::StatusCode::NotFound, request.memoryResource());
+}
+
+bool StaticFileServer::decodePath(std::string_view uri, std::pmr::string& path)
+{
+    path.clear();
+    path.reserve(uri.size() + 1);
+
+    for (std::size_t i = 0; i < uri.size(); ++i)
+    {
+        auto c = uri[i];
+
+        if (c == '%')
+        {
+            if (i + 2 >= uri.size())
+            {
+                return false;
+            }
+
+            auto high = hexValue(uri[i + 1]);
+            auto low = hexValue(uri[i + 2]);
+
+            if (high == -1 || low == -1)
+            {
+                return false;
+            }
+
+            c = static_cast<char>((high << 4) | low);
+            i += 2;
+        }
+
+        if (c == '\0')
+        {
+            return false;
+        }
+
+        // Repeated slashes are merged
+        if (c == '/' && !path.empty() && path.back() == '/')
+        {
+            continue;
+        }
+
+        if (c != '/' && path.empty())
+        {
+            path.push_back('/');
+        }
+
+        path.push_back(c);
+    }
+
+    // Checking every segment for escaping directory
+    std::size_t start = 0;
+
+    while (start < path.size())
+    {
+        auto end = path.find('/', start + 1);
+
+        if (end == std::string::npos)
+        {
+            end = path.size();
+        }
+
+        if (std::string_view(path).substr(start, end - start) == "/..")
+        {
+            return false;
+        }
+
+        start = end;
+    }
+
+    return true;
+}
+
+HTTPResponse StaticFileServer::errorResponse(HTTPResponse::StatusCode code,
+                                             std::pmr::memory_resource* resource)
+{
+    HTTPResponse response(resource);
+
+    response.version() = "HTTP/1.1";
+    response.statusCode() = code;
+
+    return response;
+}
@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "Tools/IOURing.hpp"
+
+static int setup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int enter(int ring, unsigned toSubmit, unsigned waitCount, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit, waitCount, flags, nullptr, 0));
+}
+
+static int registerResource(int ring, unsigned opcode, const void* argument, unsigned count)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, ring, opcode, argument, count));
+}
+
+IOURing::IOURing() :
+    m_ring(-1),
+    m_enterRing(-1),
+    m_enterFlags(0),
+    m_disabled(false),
+    m_ringMemory(nullptr),
+    m_ringSize(0),
+    m_sqes(nullptr),
+    m_sqesSize(0),
+    m_sqHead(nullptr),
+    m_sqTail(nullptr),
+    m_sqMask(0),
+    m_sqEntries(0),
+    m_sqLocalTail(0),
+    m_cqHead(nullptr),
+    m_cqTail(nullptr),
+    m_cqMask(0),
+    m_cqes(nullptr),
+    m_bufferRing(nullptr),
+    m_bufferRingSize(0),
+    m_bufferMask(0),
+    m_bufferSize(0),
+    m_bufferGroup(0),
+    m_buffers()
+{
+
+}
+
+IOURing::~IOURing()
+{
+    close();
+}
+
+bool IOURing::isSupported()
+{
+    static const bool supported = []
+    {
+        IOURing ring;
+
+        if (!ring.initialize(8))
+        {
+            return false;
+        }
+
+        // Проверка наличия используемых операций
+        std::vector<std::byte> memory(
+            sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op)
+        );
+
+        auto* probe = reinterpret_cast<io_uring_probe*>(memory.data());
+
+        if (registerResource(ring.m_ring, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) != 0)
+        {
+            return false;
+        }
+
+        for (auto operation : {IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SENDMSG,
+                               IORING_OP_CLOSE, IORING_OP_TIMEOUT, IORING_OP_POLL_ADD})
+        {
+            if (operation > probe->last_op ||
+                !(probe->ops[operation].flags & IO_URING_OP_SUPPORTED))
+            {
+                return false;
+            }
+        }
+
+        // Кольцо буферов и множественный accept
+        // появились в одной версии ядра
+        return ring.registerBuffers(2, 4096, 0);
+    }();
+
+    return supported;
+}
+
+bool IOURing::initialize(unsigned entries)
+{
+    io_uring_params params{};
+
+    params.flags = IORING_SETUP_CQSIZE |
+                   IORING_SETUP_SUBMIT_ALL |
+                   IORING_SETUP_R_DISABLED |
+                   IORING_SETUP_SINGLE_ISSUER |
+                   IORING_SETUP_DEFER_TASKRUN;
+    params.cq_entries = entries * 4;
+
+    m_ring = setup(entries, &params);
+
+    if (m_ring == -1 && errno == EINVAL)
+    {
+        // Ядро не поддерживает флаги оптимизации
+        params = io_uring_params{};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = entries * 4;
+
+        m_ring = setup(entries, &params);
+    }
+
+    if (m_ring == -1)
+    {
+        return false;
+    }
+
+    m_enterRing = m_ring;
+    m_disabled = (params.flags & IORING_SETUP_R_DISABLED) != 0;
+
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) ||
+        !(params.features & IORING_FEAT_NODROP))
+    {
+        close();
+        errno = ENOSYS;
+        return false;
+    }
+
+    m_ringSize = std::max(
+        params.sq_off.array + params.sq_entries * sizeof(unsigned),
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe)
+    );
+
+    m_ringMemory = mmap(
+        nullptr,
+        m_ringSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        m_ring,
+        IORING_OFF_SQ_RING
+    );
+
+    if (m_ringMemory == MAP_FAILED)
+    {
+        m_ringMemory = nullptr;
+        close();
+        return false;
+    }
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    auto* sqes = mmap(
+        nullptr,
+        m_sqesSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        m_ring,
+        IORING_OFF_SQES
+    );
+
+    if (sqes == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+
+    m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto* base = static_cast<std::byte*>(m_ringMemory);
+
+    m_sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_sqLocalTail = *m_sqTail;
+
+    // Элементы очереди используются по порядку
+    auto* array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+
+    for (unsigned i = 0; i < m_sqEntries; ++i)
+    {
+        array[i] = i;
+    }
+
+    m_cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+    return true;
+}
+
+bool IOURing::enable()
+{
+    if (m_disabled)
+    {
+        if (registerResource(m_ring, IORING_REGISTER_ENABLE_RINGS, nullptr, 0) != 0)
+        {
+            return false;
+        }
+
+        m_disabled = false;
+    }
+
+    // Зарегистрированный дескриптор кольца не требует
+    // поиска файла при каждом io_uring_enter.
+    // Не критично, если не поддерживается.
+    io_uring_rsrc_update update{};
+    update.offset = ~0U;
+    update.data = static_cast<uint64_t>(m_ring);
+
+    if (registerResource(m_ring, IORING_REGISTER_RING_FDS, &update, 1) == 1)
+    {
+        m_enterRing = static_cast<int>(update.offset);
+        m_enterFlags = IORING_ENTER_REGISTERED_RING;
+    }
+
+    return true;
+}
+
+bool IOURing::registerFiles(const int* files, unsigned count)
+{
+    return registerResource(m_ring, IORING_REGISTER_FILES, files, count) == 0;
+}
+
+bool IOURing::registerBuffers(unsigned count, std::size_t size, uint16_t group)
+{
+    // Кольцо должно быть выровнено по странице
+    m_bufferRingSize = count * sizeof(io_uring_buf);
+
+    auto* ring = mmap(
+        nullptr,
+        m_bufferRingSize,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0
+    );
+
+    if (ring == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // Страницы заполняются до регистрации, иначе
+    // ядро закрепит общую нулевую страницу
+    std::memset(ring, 0, m_bufferRingSize);
+
+    m_bufferRing = static_cast<io_uring_buf_ring*>(ring);
+
+    io_uring_buf_reg registration{};
+    registration.ring_addr = reinterpret_cast<uint64_t>(ring);
+    registration.ring_entries = count;
+    registration.bgid = group;
+
+    if (registerResource(m_ring, IORING_REGISTER_PBUF_RING, &registration, 1) != 0)
+    {
+        munmap(m_bufferRing, m_bufferRingSize);
+        m_bufferRing = nullptr;
+        return false;
+    }
+
+    m_bufferMask = count - 1;
+    m_bufferSize = size;
+    m_bufferGroup = group;
+    m_buffers.resize(count * size);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        recycleBuffer(static_cast<uint16_t>(i));
+    }
+
+    return true;
+}
+
+std::byte* IOURing::buffer(uint16_t id)
+{
+    return m_buffers.data() + id * m_bufferSize;
+}
+
+void IOURing::recycleBuffer(uint16_t id)
+{
+    auto tail = m_bufferRing->tail;
+
+    // Массив bufs в C++ смещен пустой структурой
+    // __DECLARE_FLEX_ARRAY, поэтому кольцо адресуется
+    // как обычный массив. Поле resv первого элемента
+    // занято хвостом кольца.
+    auto& element = reinterpret_cast<io_uring_buf*>(m_bufferRing)[tail & m_bufferMask];
+
+    element.addr = reinterpret_cast<uint64_t>(buffer(id));
+    element.len = static_cast<uint32_t>(m_bufferSize);
+    element.bid = id;
+
+    __atomic_store_n(&m_bufferRing->tail, static_cast<uint16_t>(tail + 1), __ATOMIC_RELEASE);
+}
+
+io_uring_sqe* IOURing::getSQE()
+{
+    if (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries)
+    {
+        // Очередь заполнена, отправка без ожидания
+        if (submit(0) < 0 ||
+            m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries)
+        {
+            return nullptr;
+        }
+    }
+
+    auto* sqe = &m_sqes[m_sqLocalTail & m_sqMask];
+
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+
+    ++m_sqLocalTail;
+
+    return sqe;
+}
+
+int IOURing::submit(unsigned waitCount)
+{
+    __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+
+    while (true)
+    {
+        auto toSubmit = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        auto flags = m_enterFlags;
+
+        if (waitCount > 0)
+        {
+            flags |= IORING_ENTER_GETEVENTS;
+        }
+
+        auto result = enter(m_enterRing, toSubmit, waitCount, flags);
+
+        if (result == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return -errno;
+        }
+
+        return result;
+    }
+}
+
+io_uring_cqe* IOURing::peekCQE()
+{
+    auto head = *m_cqHead;
+
+    if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+    {
+        return nullptr;
+    }
+
+    return &m_cqes[head & m_cqMask];
+}
+
+void IOURing::seenCQE()
+{
+    __atomic_store_n(m_cqHead, *m_cqHead + 1, __ATOMIC_RELEASE);
+}
+
+void IOURing::close()
+{
+    if (m_ring != -1)
+    {
+        ::close(m_ring);
+        m_ring = -1;
+    }
+
+    if (m_sqes != nullptr)
+    {
+        munmap(m_sqes, m_sqesSize);
+        m_sqes = nullptr;
+    }
+
+    if (m_ringMemory != nullptr)
+    {
+        munmap(m_ringMemory, m_ringSize);
+        m_ringMemory = nullptr;
+    }
+
+    // Буферы освобождаются после закрытия кольца
+    if (m_bufferRing != nullptr)
+    {
+        munmap(m_bufferRing, m_bufferRingSize);
+        m_bufferRing = nullptr;
+    }
+}
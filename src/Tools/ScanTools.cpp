@@ -0,0 +1,188 @@
+#include <cstdint>
+#include "Tools/ScanTools.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCANTOOLS_X86
+#endif
+
+using ScanFunction = const std::byte* (*)(const std::byte*, const std::byte*, const std::byte**);
+
+/**
+ * @brief Побайтовый поиск. Используется для
+ * остатка данных, меньшего размера вектора.
+ * Найденное ранее двоеточие сохраняется.
+ */
+static const std::byte* scanScalar(const std::byte* begin,
+                                   const std::byte* end,
+                                   const std::byte** colon)
+{
+    for (auto* position = begin; position < end; ++position)
+    {
+        if (*position == std::byte('\n'))
+        {
+            return position;
+        }
+
+        if (*position == std::byte(':') && *colon == nullptr)
+        {
+            *colon = position;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Функция обработки масок одного вектора.
+ * @param position Начало вектора.
+ * @param lineFeeds Маска переводов строки.
+ * @param colons Маска двоеточий.
+ * @param colon Указатель на первое двоеточие.
+ * @return Указатель на перевод строки или nullptr.
+ */
+static inline const std::byte* proceedMasks(const std::byte* position,
+                                            uint32_t lineFeeds,
+                                            uint32_t colons,
+                                            const std::byte** colon)
+{
+    if (colons != 0 && *colon == nullptr)
+    {
+        auto index = __builtin_ctz(colons);
+
+        // Двоеточие после перевода строки
+        // относится к следующей строке
+        if (lineFeeds == 0 || index < __builtin_ctz(lineFeeds))
+        {
+            *colon = position + index;
+        }
+    }
+
+    if (lineFeeds != 0)
+    {
+        return position + __builtin_ctz(lineFeeds);
+    }
+
+    return nullptr;
+}
+
+#ifdef SCANTOOLS_X86
+__attribute__((target("sse2")))
+static const std::byte* scanSSE2(const std::byte* begin,
+                                 const std::byte* end,
+                                 const std::byte** colon)
+{
+    const auto lineFeed = _mm_set1_epi8('\n');
+    const auto colonByte = _mm_set1_epi8(':');
+
+    auto* position = begin;
+
+    for (; end - position >= 16; position += 16)
+    {
+        auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+
+        auto lineFeeds = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, lineFeed)));
+        auto colons = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, colonByte)));
+
+        if (auto* found = proceedMasks(position, lineFeeds, colons, colon))
+        {
+            return found;
+        }
+    }
+
+    return scanScalar(position, end, colon);
+}
+
+__attribute__((target("avx2")))
+static const std::byte* scanAVX2(const std::byte* begin,
+                                 const std::byte* end,
+                                 const std::byte** colon)
+{
+    const auto lineFeed = _mm256_set1_epi8('\n');
+    const auto colonByte = _mm256_set1_epi8(':');
+
+    auto* position = begin;
+
+    for (; end - position >= 32; position += 32)
+    {
+        auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(position));
+
+        auto lineFeeds = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, lineFeed)));
+        auto colons = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, colonByte)));
+
+        if (auto* found = proceedMasks(position, lineFeeds, colons, colon))
+        {
+            return found;
+        }
+    }
+
+    // Остаток проверяется половиной вектора
+    return scanSSE2(position, end, colon);
+}
+#endif
+
+static ScanFunction function(ScanTools::Implementation implementation)
+{
+    switch (implementation)
+    {
+#ifdef SCANTOOLS_X86
+    case ScanTools::Implementation::AVX2:
+        return &scanAVX2;
+
+    case ScanTools::Implementation::SSE2:
+        return &scanSSE2;
+#endif
+
+    default:
+        return &scanScalar;
+    }
+}
+
+const std::byte* ScanTools::FindLineFeed(const std::byte* begin,
+                                         const std::byte* end,
+                                         const std::byte** colon)
+{
+    static const auto scan = function(CurrentImplementation());
+
+    *colon = nullptr;
+
+    return scan(begin, end, colon);
+}
+
+const std::byte* ScanTools::FindLineFeed(ScanTools::Implementation implementation,
+                                         const std::byte* begin,
+                                         const std::byte* end,
+                                         const std::byte** colon)
+{
+    *colon = nullptr;
+
+    return function(implementation)(begin, end, colon);
+}
+
+ScanTools::Implementation ScanTools::CurrentImplementation()
+{
+#ifdef SCANTOOLS_X86
+    static const auto implementation = []
+    {
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return Implementation::AVX2;
+        }
+
+        // SSE2 есть у любого x86-64 процессора
+#ifdef __x86_64__
+        return Implementation::SSE2;
+#else
+        return __builtin_cpu_supports("sse2") ?
+               Implementation::SSE2 :
+               Implementation::Scalar;
+#endif
+    }();
+
+    return implementation;
+#else
+    return Implementation::Scalar;
+#endif
+}
@@ -3,6 +3,9 @@
 #include <Tools/SocketTools.hpp>
 #include <CurrentLogger.hpp>
 #include <fcntl.h>
+#ifdef OS_LINUX
+#include <sys/sendfile.h>
+#endif
 
 bool ::SocketTools::makeSocketNonBlocking(socket_t socket)
 {
@@ -61,6 +64,27 @@ ssize_t SocketTools::Send(socket_t socket, const uint8_t* buffer, int len, int f
 #endif
 }
 
+ssize_t SocketTools::SendVector(socket_t socket, const iovec* buffers, int count, int flags)
+{
+#ifdef OS_LINUX
+    msghdr message{};
+
+    message.msg_iov = const_cast<iovec*>(buffers);
+    message.msg_iovlen = static_cast<size_t>(count);
+
+    // sendmsg is used instead of writev, because
+    // writev can't receive MSG_NOSIGNAL
+    return ::sendmsg(socket, &message, flags);
+#endif
+}
+
+ssize_t SocketTools::SendFile(socket_t socket, int file, off_t& offset, std::size_t len)
+{
+#ifdef OS_LINUX
+    return ::sendfile(socket, file, &offset, len);
+#endif
+}
+
 void SocketTools::Close(socket_t socket)
 {
 #ifdef OS_LINUX
@@ -0,0 +1,285 @@
+#include "URIArguments.hpp"
+
+/**
+ * @brief Function for converting hex digit.
+ * @param c Character.
+ * @return Digit value or -1.
+ */
+static int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Function for checking, if value
+ * has to be decoded.
+ * @param value Value.
+ * @return Is value escaped.
+ */
+static bool isEscaped(std::string_view value)
+{
+    return value.find_first_of("%+") != std::string_view::npos;
+}
+
+URIArguments::URIArguments(std::pmr::memory_resource* resource) :
+    m_resource(resource),
+    m_query(),
+    m_parsed(true),
+    m_size(0),
+    m_inline(),
+    m_overflow(resource),
+    m_decoded(resource)
+{
+
+}
+
+URIArguments::~URIArguments()
+{
+    for (auto&& [memory, size] : m_decoded)
+    {
+        m_resource->deallocate(memory, size, 1);
+    }
+}
+
+URIArguments::URIArguments(URIArguments&& other) noexcept :
+    m_resource(other.m_resource),
+    m_query(other.m_query),
+    m_parsed(other.m_parsed),
+    m_size(other.m_size),
+    m_inline(other.m_inline),
+    m_overflow(std::move(other.m_overflow)),
+    m_decoded(std::move(other.m_decoded))
+{
+    // Decoded memory is owned by this instance now
+    other.m_decoded.clear();
+    other.m_overflow.clear();
+    other.m_size = 0;
+    other.m_query = {};
+    other.m_parsed = true;
+}
+
+void URIArguments::setQuery(std::string_view query)
+{
+    m_query = query;
+    m_parsed = query.empty();
+}
+
+void URIArguments::setParameter(std::string_view name, std::string_view value)
+{
+    append(Argument{name, value, false, true});
+}
+
+std::size_t URIArguments::size() const
+{
+    parse();
+
+    return m_size;
+}
+
+std::pair<std::string_view, std::string_view> URIArguments::argument(std::size_t index) const
+{
+    parse();
+
+    auto& argument = at(index);
+
+    if (argument.escaped)
+    {
+        argument.value = decodeStored(argument.value);
+        argument.escaped = false;
+    }
+
+    return {argument.name, argument.value};
+}
+
+bool URIArguments::contains(std::string_view name) const
+{
+    return search(name) != nullptr;
+}
+
+std::optional<std::string_view> URIArguments::find(std::string_view name) const
+{
+    auto* argument = search(name);
+
+    if (argument == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    // Decoded value replaces escaped one
+    if (argument->escaped)
+    {
+        argument->value = decodeStored(argument->value);
+        argument->escaped = false;
+    }
+
+    return argument->value;
+}
+
+std::string_view URIArguments::value(std::string_view name, std::string_view defaultValue) const
+{
+    auto result = find(name);
+
+    return result ? *result : defaultValue;
+}
+
+std::string_view URIArguments::operator[](std::string_view name) const
+{
+    return value(name);
+}
+
+std::size_t URIArguments::decode(std::string_view value, char* output)
+{
+    std::size_t size = 0;
+
+    for (std::size_t i = 0; i < value.size(); ++i)
+    {
+        auto c = value[i];
+
+        if (c == '+')
+        {
+            c = ' ';
+        }
+        else if (c == '%' && i + 2 < value.size())
+        {
+            auto high = hexValue(value[i + 1]);
+            auto low = hexValue(value[i + 2]);
+
+            if (high >= 0 && low >= 0)
+            {
+                c = static_cast<char>(high * 16 + low);
+                i += 2;
+            }
+        }
+
+        output[size++] = c;
+    }
+
+    return size;
+}
+
+void URIArguments::parse() const
+{
+    if (m_parsed)
+    {
+        return;
+    }
+
+    m_parsed = true;
+
+    std::size_t position = 0;
+
+    while (position <= m_query.size())
+    {
+        auto end = m_query.find('&', position);
+
+        if (end == std::string_view::npos)
+        {
+            end = m_query.size();
+        }
+
+        auto pair = m_query.substr(position, end - position);
+
+        position = end + 1;
+
+        // Empty pairs like "a=1&&b=2" are skipped
+        if (pair.empty())
+        {
+            continue;
+        }
+
+        auto separator = pair.find('=');
+
+        auto name = pair.substr(0, separator);
+        auto value = (separator == std::string_view::npos) ?
+                     std::string_view() :
+                     pair.substr(separator + 1);
+
+        // Names are compared with decoded ones,
+        // so they are decoded right away
+        if (isEscaped(name))
+        {
+            name = decodeStored(name);
+        }
+
+        append(Argument{name, value, isEscaped(value), false});
+    }
+}
+
+void URIArguments::append(Argument argument) const
+{
+    if (m_size < InlineCount)
+    {
+        m_inline[m_size] = argument;
+    }
+    else
+    {
+        m_overflow.push_back(argument);
+    }
+
+    ++m_size;
+}
+
+URIArguments::Argument& URIArguments::at(std::size_t index) const
+{
+    if (index < InlineCount)
+    {
+        return m_inline[index];
+    }
+
+    return m_overflow[index - InlineCount];
+}
+
+URIArguments::Argument* URIArguments::search(std::string_view name) const
+{
+    parse();
+
+    Argument* result = nullptr;
+
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        auto& argument = at(i);
+
+        if (argument.name != name)
+        {
+            continue;
+        }
+
+        if (argument.parameter)
+        {
+            return &argument;
+        }
+
+        result = &argument;
+    }
+
+    return result;
+}
+
+std::string_view URIArguments::decodeStored(std::string_view value) const
+{
+    if (value.empty())
+    {
+        return value;
+    }
+
+    auto* memory = static_cast<char*>(m_resource->allocate(value.size(), 1));
+
+    m_decoded.emplace_back(memory, value.size());
+
+    return std::string_view(memory, decode(value, memory));
+}
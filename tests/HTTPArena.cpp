@@ -0,0 +1,112 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <HTTPArena.hpp>
+#include <HTTPRequest.hpp>
+#include <HTTPResponse.hpp>
+
+/**
+ * @brief Resource, that counts allocations,
+ * passed to default resource.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST(HTTPArena, Alignment)
+{
+    HTTPArena arena(64);
+
+    auto* byte = arena.allocate(1, 1);
+    auto* aligned = arena.allocate(8, 16);
+
+    ASSERT_NE(byte, aligned);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(aligned) % 16, 0);
+
+    // Allocation, bigger than block, gets own block
+    auto* big = arena.allocate(1000, 8);
+
+    ASSERT_NE(big, nullptr);
+    ASSERT_GE(arena.capacity(), 64 + 1000);
+}
+
+TEST(HTTPArena, BlocksAreKept)
+{
+    CountingResource upstream;
+
+    {
+        HTTPArena arena(256, &upstream);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            std::pmr::vector<int> values(&arena);
+
+            for (int j = 0; j < 100; ++j)
+            {
+                values.push_back(j);
+            }
+
+            arena.reset();
+        }
+
+        // Blocks of first iteration are reused
+        ASSERT_LE(upstream.allocations, 4);
+    }
+
+    ASSERT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+TEST(HTTPArena, Request)
+{
+    CountingResource upstream;
+    HTTPArena arena(4096, &upstream);
+
+    std::string data =
+        "GET /api/version HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Accept: */*\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n";
+
+    for (int i = 0; i < 10; ++i)
+    {
+        {
+            HTTPRequest request(&arena);
+
+            ASSERT_TRUE(request.parse(reinterpret_cast<std::byte*>(data.data()), data.size()));
+            ASSERT_EQ(request.header().numberOfHeaders(), 3);
+
+            HTTPResponse response(request.memoryResource());
+
+            response.header().addHeader({"Content-Type", "application/json"});
+            response.setData("{\"version\": \"testing\"}");
+
+            ASSERT_EQ(response.memoryResource(), &arena);
+        }
+
+        arena.reset();
+    }
+
+    // Request and response are placed in single block
+    ASSERT_EQ(upstream.allocations, 1);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <HTTPChunkedDecoder.hpp>
+
+TEST(HTTPChunkedDecoder, Decoding)
+{
+    std::string value =
+        "4\r\n"
+        "Wiki\r\n"
+        "6;name=value\r\n"
+        "pedia \r\n"
+        "E\r\n"
+        "in \r\n"
+        "\r\n"
+        "chunks.\r\n"
+        "0\r\n"
+        "Trailer: value\r\n"
+        "\r\n"
+        "NEXT";
+
+    HTTPChunkedDecoder decoder;
+
+    std::size_t consumed = 0;
+    std::size_t produced = 0;
+
+    // Decoding in place
+    auto status = decoder.decode(
+        (std::byte*) value.data(),
+        value.size(),
+        (std::byte*) value.data(),
+        consumed,
+        produced
+    );
+
+    ASSERT_EQ(status, HTTPChunkedDecoder::Status::Complete);
+    ASSERT_EQ(consumed, value.size() - 4);
+    ASSERT_EQ(value.substr(0, produced), "Wikipedia in \r\n\r\nchunks.");
+}
+
+TEST(HTTPChunkedDecoder, DecodingPartial)
+{
+    std::string value =
+        "4\r\n"
+        "Wiki\r\n"
+        "5\r\n"
+        "pedia\r\n"
+        "0\r\n"
+        "\r\n";
+
+    HTTPChunkedDecoder decoder;
+
+    std::string received;
+    std::string result;
+
+    auto status = HTTPChunkedDecoder::Status::Incomplete;
+
+    // Bytes are received one by one, not consumed
+    // bytes are kept for next call
+    for (auto c : value)
+    {
+        ASSERT_EQ(status, HTTPChunkedDecoder::Status::Incomplete);
+
+        received.push_back(c);
+
+        std::string output(received.size(), '\0');
+
+        std::size_t consumed = 0;
+        std::size_t produced = 0;
+
+        status = decoder.decode(
+            (std::byte*) received.data(),
+            received.size(),
+            (std::byte*) output.data(),
+            consumed,
+            produced
+        );
+
+        received.erase(0, consumed);
+        result += output.substr(0, produced);
+    }
+
+    ASSERT_EQ(status, HTTPChunkedDecoder::Status::Complete);
+    ASSERT_EQ(result, "Wikipedia");
+    ASSERT_TRUE(received.empty());
+}
+
+TEST(HTTPChunkedDecoder, Malformed)
+{
+    std::string wrongSize = "Z\r\nWiki\r\n";
+    std::string wrongDataEnd = "4\r\nWikipedia\r\n";
+
+    HTTPChunkedDecoder decoder;
+
+    std::size_t consumed = 0;
+    std::size_t produced = 0;
+    std::string output(32, '\0');
+
+    ASSERT_EQ(
+        decoder.decode(
+            (std::byte*) wrongSize.data(),
+            wrongSize.size(),
+            (std::byte*) output.data(),
+            consumed,
+            produced
+        ),
+        HTTPChunkedDecoder::Status::Error
+    );
+
+    decoder.reset();
+
+    ASSERT_EQ(
+        decoder.decode(
+            (std::byte*) wrongDataEnd.data(),
+            wrongDataEnd.size(),
+            (std::byte*) output.data(),
+            consumed,
+            produced
+        ),
+        HTTPChunkedDecoder::Status::Error
+    );
+}
@@ -0,0 +1,207 @@
+#include <string>
+#include <memory>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <gtest/gtest.h>
+#include <HTTPConnection.hpp>
+
+/**
+ * @brief Connection, that is driven through
+ * socket pair. Peer socket is blocking.
+ */
+class HTTPConnectionTest : public ::testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        int sockets[2];
+
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+        fcntl(sockets[0], F_SETFL, fcntl(sockets[0], F_GETFL) | O_NONBLOCK);
+
+        connection = std::make_unique<HTTPConnection>(sockets[0], sockaddr_in{});
+        peer = sockets[1];
+    }
+
+    void TearDown() override
+    {
+        connection.reset();
+        close(peer);
+    }
+
+    /**
+     * @brief Method for sending bytes from peer
+     * and reading them by connection.
+     */
+    void receive(std::string_view data)
+    {
+        ASSERT_EQ(send(peer, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+        ASSERT_TRUE(connection->readAvailable());
+    }
+
+    /**
+     * @brief Method for reading bytes, that
+     * were sent to peer.
+     */
+    std::string sent()
+    {
+        char buffer[256];
+
+        auto size = recv(peer, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+        return size > 0 ? std::string(buffer, static_cast<std::size_t>(size)) : std::string();
+    }
+
+    /**
+     * @brief Method for starting body of
+     * received header.
+     * @return Is body expected.
+     */
+    bool startBody(std::size_t maxBodySize)
+    {
+        EXPECT_TRUE(connection->isHeaderReceived());
+
+        if (!connection->prepareBody(maxBodySize))
+        {
+            return false;
+        }
+
+        connection->beginBody(nullptr);
+
+        return true;
+    }
+
+    std::string body()
+    {
+        auto& request = connection->request();
+
+        return std::string(reinterpret_cast<const char*>(request.data()), request.dataSize());
+    }
+
+    std::unique_ptr<HTTPConnection> connection;
+    int peer = -1;
+};
+
+TEST_F(HTTPConnectionTest, ConflictingContentLength)
+{
+    receive("POST / HTTP/1.1\r\nContent-Length: 3\r\nContent-Length: 4\r\n\r\nabc");
+
+    ASSERT_FALSE(startBody(1024));
+    ASSERT_TRUE(connection->isRequestMalformed());
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::BadRequest);
+}
+
+TEST_F(HTTPConnectionTest, InvalidContentLength)
+{
+    receive("POST / HTTP/1.1\r\nContent-Length: 3x\r\n\r\nabc");
+
+    ASSERT_FALSE(startBody(1024));
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::BadRequest);
+}
+
+TEST_F(HTTPConnectionTest, UnsupportedTransferEncoding)
+{
+    receive("POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n");
+
+    ASSERT_FALSE(startBody(1024));
+    ASSERT_TRUE(connection->isRequestMalformed());
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::NotImplemented);
+}
+
+TEST_F(HTTPConnectionTest, TransferEncodingWithLength)
+{
+    receive("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 4\r\n\r\n0\r\n\r\n");
+
+    ASSERT_FALSE(startBody(1024));
+    ASSERT_TRUE(connection->isRequestMalformed());
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::BadRequest);
+}
+
+TEST_F(HTTPConnectionTest, RepeatedTransferEncoding)
+{
+    receive("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nTransfer-Encoding: identity\r\n\r\n0\r\n\r\n");
+
+    ASSERT_FALSE(startBody(1024));
+    ASSERT_TRUE(connection->isRequestMalformed());
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::BadRequest);
+}
+
+TEST_F(HTTPConnectionTest, BodyTooLarge)
+{
+    receive("POST / HTTP/1.1\r\nContent-Length: 100\r\n\r\n");
+
+    ASSERT_TRUE(startBody(10));
+    ASSERT_TRUE(connection->isRequestMalformed());
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::PayloadTooLarge);
+}
+
+TEST_F(HTTPConnectionTest, ChunkedBodyTooLarge)
+{
+    receive("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nA\r\n0123456789\r\n5\r\nabcde\r\n");
+
+    ASSERT_TRUE(startBody(12));
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::PayloadTooLarge);
+}
+
+TEST_F(HTTPConnectionTest, Continue)
+{
+    receive("POST / HTTP/1.1\r\nExpect: 100-continue\r\nContent-Length: 3\r\n\r\n");
+
+    ASSERT_TRUE(startBody(1024));
+    ASSERT_EQ(sent(), "HTTP/1.1 100 Continue\r\n\r\n");
+    ASSERT_FALSE(connection->isRequestReceived());
+
+    receive("abc");
+
+    ASSERT_TRUE(connection->isRequestReceived());
+    ASSERT_EQ(body(), "abc");
+}
+
+TEST_F(HTTPConnectionTest, NoContinueWithBody)
+{
+    // Body, that is sent with header, isn't confirmed
+    receive("POST / HTTP/1.1\r\nExpect: 100-continue\r\nContent-Length: 3\r\n\r\nabc");
+
+    ASSERT_TRUE(startBody(1024));
+    ASSERT_TRUE(sent().empty());
+    ASSERT_TRUE(connection->isRequestReceived());
+}
+
+TEST_F(HTTPConnectionTest, PipelinedAfterBody)
+{
+    receive(
+        "POST /first HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc"
+        "POST /second HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\ndef\r\n0\r\n\r\n"
+        "GET /third HTTP/1.1\r\n\r\n"
+    );
+
+    ASSERT_TRUE(startBody(1024));
+    ASSERT_TRUE(connection->isRequestReceived());
+    ASSERT_EQ(connection->request().uri(), "/first");
+    ASSERT_EQ(body(), "abc");
+
+    connection->reset();
+
+    ASSERT_TRUE(startBody(1024));
+    ASSERT_TRUE(connection->isRequestReceived());
+    ASSERT_EQ(connection->request().uri(), "/second");
+    ASSERT_EQ(body(), "def");
+
+    connection->reset();
+
+    ASSERT_FALSE(startBody(1024));
+    ASSERT_TRUE(connection->isRequestReceived());
+    ASSERT_EQ(connection->request().uri(), "/third");
+}
+
+TEST_F(HTTPConnectionTest, SpaceBeforeColon)
+{
+    // Body isn't parsed as next request
+    receive("POST / HTTP/1.1\r\nContent-Length : 22\r\n\r\nGET /smuggled HTTP/1.1\r\n\r\n");
+
+    ASSERT_TRUE(connection->isRequestMalformed());
+    ASSERT_EQ(connection->requestError(), HTTPResponse::StatusCode::BadRequest);
+}
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <gtest/gtest.h>
+#include <HTTPExecutor.hpp>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Coroutine, that records steps
+ * of it's execution.
+ */
+struct Recorder
+{
+    struct promise_type
+    {
+        Recorder get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept
+        {
+
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+static Recorder sleeping(HTTPExecutor& executor,
+                         std::chrono::milliseconds duration,
+                         std::vector<int>& steps,
+                         int step)
+{
+    co_await executor.sleep(duration);
+
+    steps.push_back(step);
+}
+
+static Recorder scheduled(HTTPExecutor& executor, std::thread::id& thread)
+{
+    co_await executor.schedule();
+
+    thread = std::this_thread::get_id();
+}
+
+static bool waitReadable(int descriptor, int timeout)
+{
+    pollfd fd{descriptor, POLLIN, 0};
+
+    return poll(&fd, 1, timeout) == 1;
+}
+
+TEST(HTTPExecutor, Post)
+{
+    HTTPExecutor executor;
+
+    ASSERT_TRUE(executor.initialize());
+
+    int calls = 0;
+
+    executor.post([&calls] { ++calls; });
+    executor.post([&calls] { ++calls; });
+
+    ASSERT_TRUE(waitReadable(executor.postDescriptor(), 0));
+
+    executor.proceed();
+
+    ASSERT_EQ(calls, 2);
+    ASSERT_FALSE(waitReadable(executor.postDescriptor(), 0));
+}
+
+TEST(HTTPExecutor, Sleep)
+{
+    HTTPExecutor executor;
+
+    ASSERT_TRUE(executor.initialize());
+
+    std::vector<int> steps;
+
+    sleeping(executor, 40ms, steps, 2);
+    sleeping(executor, 20ms, steps, 1);
+
+    ASSERT_TRUE(steps.empty());
+
+    while (steps.size() < 2)
+    {
+        ASSERT_TRUE(waitReadable(executor.timerDescriptor(), 1000));
+
+        executor.proceed();
+    }
+
+    // Coroutines are resumed by deadline
+    ASSERT_EQ(steps, (std::vector<int>{1, 2}));
+    ASSERT_FALSE(waitReadable(executor.timerDescriptor(), 0));
+}
+
+TEST(HTTPExecutor, Schedule)
+{
+    HTTPExecutor executor;
+
+    ASSERT_TRUE(executor.initialize());
+
+    executor.attach();
+
+    ASSERT_EQ(HTTPExecutor::current(), &executor);
+
+    std::thread::id thread;
+
+    // Coroutine, started by other thread, is
+    // moved to executor thread
+    std::thread([&] { scheduled(executor, thread); }).join();
+
+    ASSERT_EQ(thread, std::thread::id());
+    ASSERT_TRUE(waitReadable(executor.postDescriptor(), 0));
+
+    executor.proceed();
+
+    ASSERT_EQ(thread, std::this_thread::get_id());
+}
@@ -1,5 +1,6 @@
 
 #include <gtest/gtest.h>
+#include <cctype>
 #include <HTTPHeader.hpp>
 
 TEST(HTTPHeader, ParsingEndSize)
@@ -103,3 +104,64 @@ TEST(HTTPHeader, Serialization)
         ASSERT_EQ(value[i], buffer[i]);
     }
 }
+
+TEST(HTTPHeader, Tokens)
+{
+    // Every well-known name is found in any case
+    for (auto i = static_cast<int>(HTTPHeader::Token::Accept);
+         i <= static_cast<int>(HTTPHeader::Token::XRequestedWith);
+         ++i)
+    {
+        auto token = static_cast<HTTPHeader::Token>(i);
+        auto name = std::string(HTTPHeader::tokenName(token));
+
+        ASSERT_EQ(HTTPHeader::tokenize(name), token);
+
+        for (auto& c : name)
+        {
+            c = static_cast<char>(std::tolower(c));
+        }
+
+        ASSERT_EQ(HTTPHeader::tokenize(name), token);
+    }
+
+    ASSERT_EQ(HTTPHeader::tokenize(""), HTTPHeader::Token::Unknown);
+    ASSERT_EQ(HTTPHeader::tokenize("X-Custom"), HTTPHeader::Token::Unknown);
+    ASSERT_EQ(HTTPHeader::tokenize("Content-Lengtx"), HTTPHeader::Token::Unknown);
+    ASSERT_EQ(HTTPHeader::tokenize("Host\r"), HTTPHeader::Token::Unknown);
+}
+
+TEST(HTTPHeader, Find)
+{
+    std::size_t size = 24 + 91 + 19 + 19 + 20 + 2;
+    auto* value =
+        (std::byte *)
+            "host: ru.wikipedia.org\r\n"
+            "User-Agent: Mozilla/5.0 (X11; U; Linux i686; ru; rv:1.9b5) Gecko/2008050509 Firefox/3.0b5\r\n"
+            "Accept: text/html\r\n"
+            "CONNECTION: close\r\n"
+            "X-Custom-Field: 42\r\n"
+            "\r\n";
+
+    HTTPHeader httpHeader;
+
+    ASSERT_TRUE(httpHeader.parse(value, size));
+
+    ASSERT_EQ(httpHeader.token(0), HTTPHeader::Token::Host);
+    ASSERT_EQ(httpHeader.get(HTTPHeader::Token::Host), "ru.wikipedia.org");
+    ASSERT_EQ(httpHeader.get("Host"), "ru.wikipedia.org");
+    ASSERT_EQ(httpHeader.get("connection"), "close");
+    ASSERT_EQ(httpHeader.get("x-custom-field"), "42");
+    ASSERT_EQ(httpHeader.get("Content-Length", "none"), "none");
+
+    ASSERT_EQ(httpHeader.find(HTTPHeader::Token::ContentLength), nullptr);
+    ASSERT_EQ(httpHeader.find("X-Other"), nullptr);
+    ASSERT_EQ(httpHeader.find("Accept"), &httpHeader.header(2));
+
+    httpHeader.removeHeader(0);
+    httpHeader.insertHeader({"Content-Length", "10"}, 1);
+
+    ASSERT_EQ(httpHeader.find("Host"), nullptr);
+    ASSERT_EQ(httpHeader.token(1), HTTPHeader::Token::ContentLength);
+    ASSERT_EQ(httpHeader.get("content-length"), "10");
+}
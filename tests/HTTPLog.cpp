@@ -0,0 +1,145 @@
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <HTTPLog.hpp>
+
+/**
+ * @brief Sink, that collects formatted records.
+ */
+class CollectingSink
+{
+public:
+    CollectingSink()
+    {
+        HTTPLog::flush();
+
+        HTTPLog::setSink(
+            [this](HTTPLog::Level, std::string_view text)
+            {
+                std::scoped_lock lock(m_mutex);
+                m_records.emplace_back(text);
+            }
+        );
+    }
+
+    ~CollectingSink()
+    {
+        HTTPLog::setSink(nullptr);
+    }
+
+    std::vector<std::string> records()
+    {
+        HTTPLog::flush();
+
+        std::scoped_lock lock(m_mutex);
+        return m_records;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::string> m_records;
+};
+
+TEST(HTTPLog, Format)
+{
+    static const HTTPLog::Site site{HTTPLog::Level::Info, "Request {} \"{}\" from {}, size {}."};
+
+    CollectingSink sink;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(51234);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    HTTPLog::write(site, 42, std::string_view("/api/users"), address, -7);
+    HTTPLog::write(site, 1u, "/a");
+
+    auto records = sink.records();
+
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0], "Request 42 \"/api/users\" from 127.0.0.1:51234, size -7.");
+    EXPECT_EQ(records[1], "Request 1 \"/a\" from , size .");
+}
+
+TEST(HTTPLog, Truncation)
+{
+    static const HTTPLog::Site site{HTTPLog::Level::Warning, "{}|{}"};
+
+    CollectingSink sink;
+
+    std::string large(1000, 'x');
+
+    HTTPLog::write(site, large, 5);
+
+    auto records = sink.records();
+
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_LT(records[0].size(), HTTPLog::RecordSize);
+    EXPECT_EQ(records[0].back(), '|');
+}
+
+TEST(HTTPLog, Sampling)
+{
+    static const HTTPLog::Site site{HTTPLog::Level::Info, "Sampled {}", 4};
+
+    CollectingSink sink;
+
+    for (int i = 0; i < 9; ++i)
+    {
+        HTTPLog::write(site, i);
+    }
+
+    auto records = sink.records();
+
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0], "Sampled 0");
+    EXPECT_EQ(records[1], "Sampled 4 (3 similar records skipped)");
+    EXPECT_EQ(records[2], "Sampled 8 (3 similar records skipped)");
+}
+
+TEST(HTTPLog, RateLimit)
+{
+    static const HTTPLog::Site site{HTTPLog::Level::Error, "Limited {}", 1, 5};
+
+    CollectingSink sink;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        HTTPLog::write(site, i);
+    }
+
+    EXPECT_EQ(sink.records().size(), 5);
+}
+
+TEST(HTTPLog, Threads)
+{
+    static const HTTPLog::Site site{HTTPLog::Level::Info, "Thread {}"};
+
+    CollectingSink sink;
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [i]
+            {
+                for (int j = 0; j < 100; ++j)
+                {
+                    HTTPLog::write(site, i);
+                }
+            }
+        );
+    }
+
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Rings of finished threads are drained too
+    EXPECT_EQ(sink.records().size() + HTTPLog::droppedCount(), 400);
+}
@@ -0,0 +1,101 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <HTTPMetrics.hpp>
+
+TEST(HTTPMetrics, HistogramBuckets)
+{
+    using Histogram = HTTPMetrics::Histogram;
+
+    EXPECT_EQ(Histogram::index(0), 0);
+    EXPECT_EQ(Histogram::index(1023), 0);
+    EXPECT_EQ(Histogram::index(1024), 1);
+    EXPECT_EQ(Histogram::index(UINT64_MAX), Histogram::BucketsCount - 1);
+
+    // Every value is below upper bound of it's
+    // bucket and not below bound of previous one
+    for (uint64_t value : {1024ull, 1279ull, 1280ull, 1500ull, 2047ull, 2048ull, 1000000ull, 123456789ull})
+    {
+        auto index = Histogram::index(value);
+
+        EXPECT_LT(value, Histogram::upperBound(index)) << value;
+        EXPECT_GE(value, Histogram::upperBound(index - 1)) << value;
+    }
+
+    EXPECT_EQ(Histogram::upperBound(1), 1280);
+    EXPECT_EQ(Histogram::upperBound(4), 2048);
+}
+
+TEST(HTTPMetrics, Shards)
+{
+    HTTPMetrics metrics;
+
+    auto users = metrics.addRoute("/api/users/:id");
+    auto version = metrics.addRoute("/api/version");
+
+    EXPECT_EQ(metrics.addRoute("/api/users/:id"), users);
+    EXPECT_NE(users, version);
+
+    auto& first = metrics.createShard();
+    auto& second = metrics.createShard();
+
+    HTTPMetrics::add(first.connections);
+    HTTPMetrics::add(second.connections, 2);
+
+    first.recordRequest(
+        HTTPRequest::Method::GET,
+        users,
+        std::chrono::microseconds(100),
+        HTTPResponse::StatusCode::Ok
+    );
+
+    second.recordRequest(
+        HTTPRequest::Method::GET,
+        users,
+        std::chrono::milliseconds(5),
+        HTTPResponse::StatusCode::Ok
+    );
+
+    second.recordStatus(HTTPResponse::StatusCode::BadRequest);
+    first.recordTraffic(100, 200);
+
+    auto text = metrics.serialize();
+
+    EXPECT_NE(text.find("http_connections_accepted_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("http_received_bytes_total 100\n"), std::string::npos);
+    EXPECT_NE(text.find("http_sent_bytes_total 200\n"), std::string::npos);
+    EXPECT_NE(text.find("http_requests_total{method=\"GET\",route=\"/api/users/:id\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("http_responses_total{code=\"200\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("http_responses_total{code=\"400\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("http_handler_duration_seconds_count{route=\"/api/users/:id\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("http_handler_duration_seconds_sum{route=\"/api/users/:id\"} 0.0051\n"), std::string::npos);
+    EXPECT_NE(text.find("http_handler_duration_seconds_bucket{route=\"/api/users/:id\",le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("http_handler_duration_seconds_count{route=\"/api/version\"} 0\n"), std::string::npos);
+
+    // Requests without values are not listed
+    EXPECT_EQ(text.find("route=\"/api/version\"} 0\nhttp_requests"), std::string::npos);
+    EXPECT_EQ(text.find("method=\"POST\""), std::string::npos);
+}
+
+TEST(HTTPMetrics, Route)
+{
+    HTTPMetrics metrics;
+
+    auto route = metrics.addRoute("/a\"b");
+
+    auto& shard = metrics.createShard();
+
+    HTTPMetrics::setRoute(route);
+
+    EXPECT_EQ(HTTPMetrics::takeRoute(), route);
+    EXPECT_EQ(HTTPMetrics::takeRoute(), 0);
+
+    // Routes, added after shard, are counted as unnamed
+    auto late = metrics.addRoute("/late");
+
+    shard.recordRequest(HTTPRequest::Method::POST, late, {}, HTTPResponse::StatusCode::Ok);
+
+    auto text = metrics.serialize();
+
+    EXPECT_NE(text.find("http_requests_total{method=\"POST\",route=\"\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("route=\"/a\\\"b\""), std::string::npos);
+}
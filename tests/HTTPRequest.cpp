@@ -183,4 +183,148 @@ TEST(HTTPRequest, ParsingWithData)
     {
         ASSERT_EQ(request.data()[i], dataValue[i]);
     }
-}
\ No newline at end of file
+}
+TEST(HTTPRequest, ParsingWithoutHeaders)
+{
+    std::size_t size = 27 + 2;
+    auto* value =
+        (std::byte*)
+            "GET /api/version HTTP/1.0\r\n"
+            "\r\n";
+
+    HTTPRequest request;
+
+    ASSERT_FALSE(request.parse(value, size - 2));
+    ASSERT_TRUE(request.parse(value, size));
+
+    ASSERT_EQ(request.method(),                     HTTPRequest::Method::GET);
+    ASSERT_EQ(request.uri(),                        "/api/version");
+    ASSERT_EQ(request.version(),                    "HTTP/1.0");
+    ASSERT_EQ(request.header().numberOfHeaders(),   0);
+    ASSERT_EQ(request.dataSize(),                   0);
+}
+
+TEST(HTTPRequest, ParsingPartial)
+{
+    std::string value =
+        "POST /api/action HTTP/1.1\r\n"
+        "Host: 127.0.0.1:1212\r\n"
+        "Content-Type:application/json\r\n"
+        "\r\n"
+        "{}";
+
+    std::vector<HTTPHeader::HeaderType> intendedHeaders = {
+        {"Host", "127.0.0.1:1212"},
+        {"Content-Type", "application/json"}
+    };
+
+    HTTPRequest request;
+
+    // Bytes are received one by one and buffer is
+    // reallocated before every call
+    std::vector<std::byte> buffer;
+
+    HTTPRequest::ParseStatus status = HTTPRequest::ParseStatus::Incomplete;
+
+    for (std::size_t i = 0; i < value.size() - 2; ++i)
+    {
+        ASSERT_EQ(status, HTTPRequest::ParseStatus::Incomplete);
+
+        buffer.push_back(static_cast<std::byte>(value[i]));
+        buffer.shrink_to_fit();
+
+        status = request.parsePartial(buffer.data(), buffer.size());
+    }
+
+    ASSERT_EQ(status, HTTPRequest::ParseStatus::Complete);
+    ASSERT_EQ(request.headerSize(), value.size() - 2);
+
+    ASSERT_EQ(request.method(),  HTTPRequest::Method::POST);
+    ASSERT_EQ(request.uri(),     "/api/action");
+    ASSERT_EQ(request.version(), "HTTP/1.1");
+
+    ASSERT_EQ(request.header().numberOfHeaders(), intendedHeaders.size());
+
+    for (HTTPHeader::HeadersContainer::size_type i = 0;
+         i < request.header().numberOfHeaders();
+         ++i)
+    {
+        auto header = request.header().header(i);
+
+        ASSERT_EQ(header.first,  intendedHeaders[i].first );
+        ASSERT_EQ(header.second, intendedHeaders[i].second);
+    }
+}
+
+TEST(HTTPRequest, ParsingMalformed)
+{
+    HTTPRequest request;
+
+    std::string unknownMethod = "FETCH / HTTP/1.1\r\n\r\n";
+    std::string noSplitter = "GET / HTTP/1.1\r\nHost\r\n\r\n";
+
+    ASSERT_EQ(
+        request.parsePartial((std::byte*) unknownMethod.data(), unknownMethod.size()),
+        HTTPRequest::ParseStatus::Error
+    );
+
+    request.resetParser();
+
+    ASSERT_EQ(
+        request.parsePartial((std::byte*) noSplitter.data(), noSplitter.size()),
+        HTTPRequest::ParseStatus::Error
+    );
+}
+
+TEST(HTTPRequest, ParsingWrongHeaderName)
+{
+    // Whitespace before colon, line folding and
+    // non token characters are rejected
+    for (std::string text : {
+        "POST / HTTP/1.1\r\nContent-Length : 3\r\n\r\nabc",
+        "POST / HTTP/1.1\r\nContent-Length\t: 3\r\n\r\nabc",
+        "GET / HTTP/1.1\r\nHost: a\r\n Content-Length: 3\r\n\r\nabc",
+        "GET / HTTP/1.1\r\n\tHost: a\r\n\r\n",
+        "GET / HTTP/1.1\r\nX(Name): a\r\n\r\n",
+        "GET / HTTP/1.1\r\nX\"Name\": a\r\n\r\n",
+        "GET / HTTP/1.1\r\nX\x01Name: a\r\n\r\n"
+    })
+    {
+        HTTPRequest request;
+
+        ASSERT_EQ(
+            request.parsePartial((std::byte*) text.data(), text.size()),
+            HTTPRequest::ParseStatus::Error
+        ) << text;
+    }
+
+    HTTPRequest request;
+
+    std::string text = "GET / HTTP/1.1\r\nX-Name_1.~!#$%&'*+^`|: a\r\n\r\n";
+
+    ASSERT_EQ(
+        request.parsePartial((std::byte*) text.data(), text.size()),
+        HTTPRequest::ParseStatus::Complete
+    );
+    ASSERT_EQ(request.header().get("X-Name_1.~!#$%&'*+^`|"), "a");
+}
+
+TEST(HTTPRequest, Methods)
+{
+    for (auto i = static_cast<int>(HTTPRequest::Method::OPTIONS);
+         i <= static_cast<int>(HTTPRequest::Method::CONNECT);
+         ++i)
+    {
+        auto method = static_cast<HTTPRequest::Method>(i);
+
+        ASSERT_EQ(HTTPRequest::stringToMethod(HTTPRequest::methodToString(method)), method);
+    }
+
+    // Methods are case sensitive
+    ASSERT_EQ(HTTPRequest::stringToMethod("get"),      HTTPRequest::Method::None);
+    ASSERT_EQ(HTTPRequest::stringToMethod("GETS"),     HTTPRequest::Method::None);
+    ASSERT_EQ(HTTPRequest::stringToMethod("PROPFIND"), HTTPRequest::Method::None);
+    ASSERT_EQ(HTTPRequest::stringToMethod("G"),        HTTPRequest::Method::None);
+    ASSERT_EQ(HTTPRequest::stringToMethod(""),         HTTPRequest::Method::None);
+    ASSERT_EQ(HTTPRequest::stringToMethod(std::string_view("GET\0", 4)), HTTPRequest::Method::None);
+}
@@ -74,4 +74,40 @@ TEST(HTTPResponse, Serializing)
     {
         ASSERT_EQ(value[i], buffer[i]);
     }
-}
\ No newline at end of file
+}
+TEST(HTTPResponse, SerializingHead)
+{
+    auto* value =
+        (std::byte *)
+            "HTTP/1.1 404 NotFound\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "Error";
+
+    constexpr std::size_t headSize = 44;
+
+    HTTPResponse response;
+
+    response.version() = "HTTP/1.1";
+    response.statusCode() = HTTPResponse::StatusCode::NotFound;
+    response.header().addHeader({"Content-Length", "5"});
+    response.setData(std::string("Error"));
+
+    ASSERT_EQ(response.calculateHeadSize(), headSize);
+    ASSERT_EQ(response.calculateSerializedSize(), headSize + 5);
+
+    std::byte buffer[headSize];
+
+    ASSERT_EQ(response.serializeHead(buffer), buffer + headSize);
+
+    for (std::size_t i = 0; i < headSize; ++i)
+    {
+        ASSERT_EQ(value[i], buffer[i]);
+    }
+
+    // Data is left in response
+    for (std::size_t i = 0; i < response.dataSize(); ++i)
+    {
+        ASSERT_EQ(value[headSize + i], response.data()[i]);
+    }
+}
@@ -0,0 +1,97 @@
+#include <string>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <HTTPRouter.hpp>
+
+using Method = HTTPRequest::Method;
+
+TEST(HTTPRouter, Static)
+{
+    HTTPRouter<int> router;
+
+    router.add(Method::GET, "/api/version", 1);
+    router.add(Method::GET, "/api/verbose", 2);
+    router.add(Method::POST, "/api/version", 3);
+    router.add(Method::GET, "/api", 4);
+    router.add(Method::GET, "/", 5);
+
+    ASSERT_EQ(*router.find(Method::GET, "/api/version").value, 1);
+    ASSERT_EQ(*router.find(Method::GET, "/api/verbose").value, 2);
+    ASSERT_EQ(*router.find(Method::POST, "/api/version").value, 3);
+    ASSERT_EQ(*router.find(Method::GET, "/api").value, 4);
+    ASSERT_EQ(*router.find(Method::GET, "/").value, 5);
+
+    auto wrongMethod = router.find(Method::DELETE, "/api/version");
+
+    ASSERT_TRUE(wrongMethod.pathFound);
+    ASSERT_EQ(wrongMethod.value, nullptr);
+
+    for (auto path : {"/api/ver", "/api/versions", "/ap", "", "/api/"})
+    {
+        auto match = router.find(Method::GET, path);
+
+        ASSERT_FALSE(match.pathFound) << path;
+        ASSERT_EQ(match.value, nullptr) << path;
+    }
+}
+
+TEST(HTTPRouter, Parameters)
+{
+    HTTPRouter<int> router;
+
+    router.add(Method::GET, "/users/:id", 1);
+    router.add(Method::GET, "/users/:id/posts/:post", 2);
+    router.add(Method::GET, "/users/me", 3);
+    router.add(Method::GET, "/files/*path", 4);
+
+    auto user = router.find(Method::GET, "/users/42");
+
+    ASSERT_EQ(*user.value, 1);
+    ASSERT_EQ(user.parametersCount, 1);
+    ASSERT_EQ(user.parameters[0].name, "id");
+    ASSERT_EQ(user.parameters[0].value, "42");
+
+    auto post = router.find(Method::GET, "/users/42/posts/7");
+
+    ASSERT_EQ(*post.value, 2);
+    ASSERT_EQ(post.parametersCount, 2);
+    ASSERT_EQ(post.parameters[0].value, "42");
+    ASSERT_EQ(post.parameters[1].name, "post");
+    ASSERT_EQ(post.parameters[1].value, "7");
+
+    // Static segment has priority
+    auto me = router.find(Method::GET, "/users/me");
+
+    ASSERT_EQ(*me.value, 3);
+    ASSERT_EQ(me.parametersCount, 0);
+
+    // Parameter after backtracking from static one
+    auto meme = router.find(Method::GET, "/users/meme");
+
+    ASSERT_EQ(*meme.value, 1);
+    ASSERT_EQ(meme.parameters[0].value, "meme");
+
+    auto file = router.find(Method::GET, "/files/css/main.css");
+
+    ASSERT_EQ(*file.value, 4);
+    ASSERT_EQ(file.parametersCount, 1);
+    ASSERT_EQ(file.parameters[0].name, "path");
+    ASSERT_EQ(file.parameters[0].value, "css/main.css");
+
+    ASSERT_FALSE(router.find(Method::GET, "/users/").pathFound);
+    ASSERT_FALSE(router.find(Method::GET, "/users/42/posts/").pathFound);
+    ASSERT_EQ(router.find(Method::GET, "/users/42/posts/").parametersCount, 0);
+}
+
+TEST(HTTPRouter, Malformed)
+{
+    HTTPRouter<int> router;
+
+    router.add(Method::GET, "/users/:id", 1);
+
+    ASSERT_THROW(router.add(Method::GET, "/users/:name", 2), std::invalid_argument);
+    ASSERT_THROW(router.add(Method::GET, "/files/*path/more", 3), std::invalid_argument);
+    ASSERT_THROW(router.add(Method::GET, "/users/:/posts", 4), std::invalid_argument);
+    ASSERT_THROW(router.add(Method::None, "/", 5), std::invalid_argument);
+    ASSERT_THROW(router.add(Method::GET, "/:a/:b/:c/:d/:e/:f/:g/:h/:i", 6), std::invalid_argument);
+}
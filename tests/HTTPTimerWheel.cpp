@@ -0,0 +1,122 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <HTTPTimerWheel.hpp>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Function for advancing wheel and
+ * collecting data of expired timers.
+ */
+static std::vector<uint64_t> advance(HTTPTimerWheel& wheel, HTTPTimerWheel::Clock::time_point now)
+{
+    std::vector<uint64_t> expired;
+
+    wheel.advance(now, [&expired](HTTPTimerWheel::Timer& timer)
+    {
+        expired.push_back(timer.data);
+    });
+
+    return expired;
+}
+
+TEST(HTTPTimerWheel, ExpiresAfterTimeout)
+{
+    HTTPTimerWheel::Clock::time_point start;
+    HTTPTimerWheel wheel(start);
+
+    HTTPTimerWheel::Timer timer;
+    timer.data = 7;
+
+    wheel.arm(timer, 250ms);
+
+    ASSERT_TRUE(timer.isArmed());
+
+    // Timeout is rounded up to ticks
+    ASSERT_TRUE(advance(wheel, start + 200ms).empty());
+    ASSERT_EQ(advance(wheel, start + 300ms), std::vector<uint64_t>{7});
+    ASSERT_FALSE(timer.isArmed());
+}
+
+TEST(HTTPTimerWheel, CancelAndRearm)
+{
+    HTTPTimerWheel::Clock::time_point start;
+    HTTPTimerWheel wheel(start);
+
+    HTTPTimerWheel::Timer first;
+    HTTPTimerWheel::Timer second;
+    first.data = 1;
+    second.data = 2;
+
+    wheel.arm(first, 1s);
+    wheel.arm(second, 1s);
+
+    first.cancel();
+
+    // Rearming moves deadline
+    wheel.arm(second, 2s);
+
+    ASSERT_TRUE(advance(wheel, start + 1500ms).empty());
+    ASSERT_EQ(advance(wheel, start + 2s), std::vector<uint64_t>{2});
+}
+
+TEST(HTTPTimerWheel, CascadesLongTimeouts)
+{
+    HTTPTimerWheel::Clock::time_point start;
+    HTTPTimerWheel wheel(start);
+
+    // Timeouts of every level
+    std::vector<std::chrono::milliseconds> timeouts = {5s, 30s, 500s, 3h};
+    std::vector<HTTPTimerWheel::Timer> timers(timeouts.size());
+
+    for (std::size_t i = 0; i < timers.size(); ++i)
+    {
+        timers[i].data = i;
+        wheel.arm(timers[i], timeouts[i]);
+    }
+
+    for (std::size_t i = 0; i < timers.size(); ++i)
+    {
+        ASSERT_TRUE(advance(wheel, start + timeouts[i] - HTTPTimerWheel::TickDuration).empty());
+        ASSERT_EQ(advance(wheel, start + timeouts[i]), std::vector<uint64_t>{i});
+    }
+}
+
+TEST(HTTPTimerWheel, DestroyedTimerIsCancelled)
+{
+    HTTPTimerWheel::Clock::time_point start;
+    HTTPTimerWheel wheel(start);
+
+    HTTPTimerWheel::Timer kept;
+    kept.data = 1;
+
+    {
+        HTTPTimerWheel::Timer destroyed;
+        destroyed.data = 2;
+
+        wheel.arm(destroyed, 1s);
+        wheel.arm(kept, 1s);
+    }
+
+    ASSERT_EQ(advance(wheel, start + 1s), std::vector<uint64_t>{1});
+}
+
+TEST(HTTPTimerWheel, RearmFromExpiration)
+{
+    HTTPTimerWheel::Clock::time_point start;
+    HTTPTimerWheel wheel(start);
+
+    HTTPTimerWheel::Timer timer;
+    std::size_t count = 0;
+
+    wheel.arm(timer, 1s);
+
+    wheel.advance(start + 10s, [&](HTTPTimerWheel::Timer& expired)
+    {
+        ++count;
+        wheel.arm(expired, 1s);
+    });
+
+    ASSERT_EQ(count, 10);
+    ASSERT_TRUE(timer.isArmed());
+}
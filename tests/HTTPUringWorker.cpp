@@ -0,0 +1,347 @@
+#ifdef SIMPLEHTTP_IO_URING
+
+#include <string>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <filesystem>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <gtest/gtest.h>
+#include <HTTPServer.hpp>
+#include <HTTPUringWorker.hpp>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Server with synchronous, suspending
+ * and large responses.
+ */
+class UringTestServer : public HTTPServer
+{
+public:
+
+    static constexpr std::size_t LargeSize = 64 * 1024 * 1024;
+
+protected:
+
+    Task<HTTPResponse> proceedRequestAsync(HTTPRequest& request) override
+    {
+        std::string uri(request.uri());
+
+        if (uri == "/sleep")
+        {
+            co_await HTTPExecutor::current()->sleep(200ms);
+        }
+
+        HTTPResponse response;
+        response.version() = "HTTP/1.1";
+        response.statusCode() = HTTPResponse::StatusCode::Ok;
+
+        if (uri == "/large")
+        {
+            response.setData(std::string(LargeSize, 'x'));
+        }
+        else
+        {
+            response.setData(std::move(uri));
+        }
+
+        co_return response;
+    }
+};
+
+/**
+ * @brief Worker, that is executed by detached thread
+ * for all tests. Worker loop is endless, so server and
+ * worker live until process exits.
+ */
+class HTTPUringWorkerTest : public ::testing::Test
+{
+protected:
+
+    static void SetUpTestSuite()
+    {
+        if (!HTTPUringWorker::isSupported() || port != 0)
+        {
+            return;
+        }
+
+        // Free port is found by binding to port 0
+        int probe = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        socklen_t length = sizeof(address);
+
+        if (bind(probe, (sockaddr*) &address, sizeof(address)) != 0 ||
+            getsockname(probe, (sockaddr*) &address, &length) != 0)
+        {
+            close(probe);
+            return;
+        }
+
+        close(probe);
+
+        auto* server = new UringTestServer();
+        server->setWriteTimeout(500ms);
+
+        auto* worker = new HTTPUringWorker(*server);
+
+        if (!worker->initialize(INADDR_LOOPBACK, ntohs(address.sin_port), HTTPServerOptions()))
+        {
+            return;
+        }
+
+        port = ntohs(address.sin_port);
+
+        std::thread([worker] { worker->exec(); }).detach();
+    }
+
+    void SetUp() override
+    {
+        if (!HTTPUringWorker::isSupported())
+        {
+            GTEST_SKIP() << "io_uring is not supported by kernel";
+        }
+
+        ASSERT_NE(port, 0);
+    }
+
+    /**
+     * @brief Method for connecting to worker.
+     * @return Blocking socket with receive timeout.
+     */
+    static int connect()
+    {
+        int client = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        timeval timeout{5, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        EXPECT_EQ(::connect(client, (sockaddr*) &address, sizeof(address)), 0);
+
+        return client;
+    }
+
+    static void send(int client, std::string_view data)
+    {
+        ASSERT_EQ(::send(client, data.data(), data.size(), MSG_NOSIGNAL), static_cast<ssize_t>(data.size()));
+    }
+
+    /**
+     * @brief Method for receiving body of
+     * next response.
+     * @return Body or empty string, if connection
+     * is closed.
+     */
+    std::string receive(int client)
+    {
+        while (true)
+        {
+            auto end = m_input.find("\r\n\r\n");
+
+            if (end != std::string::npos)
+            {
+                auto position = m_input.find("Content-Length: ");
+
+                EXPECT_LT(position, end);
+
+                auto length = std::stoul(m_input.substr(position + 16));
+                auto size = end + 4 + length;
+
+                if (m_input.size() >= size)
+                {
+                    auto body = m_input.substr(end + 4, length);
+
+                    m_input.erase(0, size);
+
+                    return body;
+                }
+            }
+
+            char buffer[4096];
+
+            auto size = recv(client, buffer, sizeof(buffer), 0);
+
+            if (size < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (size <= 0)
+            {
+                return std::string();
+            }
+
+            m_input.append(buffer, static_cast<std::size_t>(size));
+        }
+    }
+
+    /**
+     * @brief Method for waiting until connection
+     * is closed by worker.
+     * @return Is connection closed.
+     */
+    static bool isClosed(int client)
+    {
+        char buffer[4096];
+
+        while (true)
+        {
+            auto size = recv(client, buffer, sizeof(buffer), 0);
+
+            if (size < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (size == 0 || (size < 0 && errno == ECONNRESET))
+            {
+                return true;
+            }
+
+            if (size < 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Function for counting open descriptors
+     * of process. Worker descriptors are released
+     * asynchronously, so count is waited for.
+     * @param expected Expected count or 0, if count
+     * is waited to stop changing.
+     * @return Count.
+     */
+    static std::size_t descriptorsCount(std::size_t expected = 0)
+    {
+        std::size_t count = 0;
+
+        for (int i = 0; i < 50; ++i)
+        {
+            auto previous = count;
+            auto iterator = std::filesystem::directory_iterator("/proc/self/fd");
+
+            count = static_cast<std::size_t>(std::distance(iterator, std::filesystem::directory_iterator()));
+
+            if (expected == 0 ? count == previous : count == expected)
+            {
+                break;
+            }
+
+            std::this_thread::sleep_for(50ms);
+        }
+
+        return count;
+    }
+
+    static inline uint16_t port = 0;
+
+    std::string m_input;
+};
+
+TEST_F(HTTPUringWorkerTest, KeepAlive)
+{
+    int client = connect();
+
+    send(client, "GET /first HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(receive(client), "/first");
+
+    send(client, "GET /second HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(receive(client), "/second");
+
+    send(client, "GET /last HTTP/1.1\r\nConnection: close\r\n\r\n");
+    ASSERT_EQ(receive(client), "/last");
+    ASSERT_TRUE(isClosed(client));
+
+    close(client);
+}
+
+TEST_F(HTTPUringWorkerTest, Pipelining)
+{
+    int client = connect();
+
+    send(client,
+         "GET /first HTTP/1.1\r\n\r\n"
+         "POST /second HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc"
+         "GET /third HTTP/1.1\r\n\r\n");
+
+    ASSERT_EQ(receive(client), "/first");
+    ASSERT_EQ(receive(client), "/second");
+    ASSERT_EQ(receive(client), "/third");
+
+    close(client);
+}
+
+TEST_F(HTTPUringWorkerTest, SuspendedHandler)
+{
+    auto descriptors = descriptorsCount();
+
+    int client = connect();
+
+    // Handler resumes connection after sleep
+    send(client, "GET /sleep HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(receive(client), "/sleep");
+
+    // Peer closes, while handler holds connection
+    send(client, "GET /sleep HTTP/1.1\r\n\r\n");
+    close(client);
+
+    std::this_thread::sleep_for(300ms);
+
+    ASSERT_EQ(descriptorsCount(descriptors), descriptors);
+
+    // Worker still serves connections
+    client = connect();
+
+    send(client, "GET /after HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(receive(client), "/after");
+
+    close(client);
+}
+
+TEST_F(HTTPUringWorkerTest, StalledSendClosed)
+{
+    auto descriptors = descriptorsCount();
+
+    int client = connect();
+
+    // Response isn't read, so send is stalled,
+    // until write timeout closes connection
+    send(client, "GET /large HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+    std::this_thread::sleep_for(1500ms);
+
+    ASSERT_EQ(descriptorsCount(descriptors + 1), descriptors + 1);
+
+    std::size_t received = 0;
+    char buffer[65536];
+    ssize_t size;
+
+    while ((size = recv(client, buffer, sizeof(buffer), 0)) > 0 || (size < 0 && errno == EINTR))
+    {
+        received += static_cast<std::size_t>(std::max<ssize_t>(size, 0));
+    }
+
+    // Connection is closed before whole response
+    ASSERT_TRUE(size == 0 || errno == ECONNRESET);
+    ASSERT_LT(received, UringTestServer::LargeSize);
+
+    close(client);
+
+    ASSERT_EQ(descriptorsCount(descriptors), descriptors);
+}
+
+#endif
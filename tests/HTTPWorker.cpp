@@ -0,0 +1,583 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <fcntl.h>
+#include <unistd.h>
+#include <thread>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include <gtest/gtest.h>
+#include <HTTPWorker.hpp>
+#include <HTTPServer.hpp>
+#include <HTTPEpollWorker.hpp>
+
+/**
+ * @brief Worker without event loop, that
+ * exposes common connection processing.
+ */
+class TestWorker : public HTTPWorker
+{
+public:
+
+    explicit TestWorker(HTTPServer& server) :
+        HTTPWorker(server)
+    {
+
+    }
+
+    bool initialize(uint32_t, uint16_t, const HTTPServerOptions&) override
+    {
+        return true;
+    }
+
+    void exec() override
+    {
+
+    }
+
+    using HTTPWorker::isKeepAliveRequested;
+    using HTTPWorker::createListener;
+    using HTTPWorker::admitConnection;
+    using HTTPWorker::proceedBody;
+    using HTTPWorker::finishRequest;
+    using HTTPWorker::releaseConnection;
+    using HTTPWorker::updateTimeout;
+    using HTTPWorker::proceedTimeout;
+
+    /**
+     * @brief Method for advancing connection
+     * timers.
+     * @return User data of expired timers.
+     */
+    std::vector<uint64_t> advance(HTTPTimerWheel::Clock::time_point now)
+    {
+        std::vector<uint64_t> expired;
+
+        m_timers.advance(now, [&expired](HTTPTimerWheel::Timer& timer)
+        {
+            expired.push_back(timer.data);
+        });
+
+        return expired;
+    }
+};
+
+/**
+ * @brief Function for checking keep alive
+ * of parsed request.
+ */
+static bool isKeepAlive(std::string text)
+{
+    HTTPRequest request;
+
+    EXPECT_TRUE(request.parse(reinterpret_cast<std::byte*>(text.data()), text.size()));
+
+    return TestWorker::isKeepAliveRequested(request);
+}
+
+TEST(HTTPWorker, KeepAliveByVersion)
+{
+    ASSERT_TRUE(isKeepAlive("GET / HTTP/1.1\r\n\r\n"));
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/1.0\r\n\r\n"));
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/1.1\r\nConnection: Close\r\n\r\n"));
+    ASSERT_TRUE(isKeepAlive("GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n"));
+}
+
+TEST(HTTPWorker, KeepAliveTokenList)
+{
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/1.1\r\nConnection: TE, close\r\n\r\n"));
+    ASSERT_TRUE(isKeepAlive("GET / HTTP/1.0\r\nConnection: Keep-Alive, TE\r\n\r\n"));
+    ASSERT_TRUE(isKeepAlive("GET / HTTP/1.0\r\nConnection: TE,\tkeep-alive \r\n\r\n"));
+    ASSERT_TRUE(isKeepAlive("GET / HTTP/1.1\r\nConnection: closed, ,TE\r\n\r\n"));
+}
+
+TEST(HTTPWorker, KeepAliveMixedTokens)
+{
+    // Order of tokens and fields doesn't matter
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/1.1\r\nConnection: close, keep-alive\r\n\r\n"));
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/1.1\r\nConnection: keep-alive, close\r\n\r\n"));
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/1.0\r\nConnection: close, keep-alive\r\n\r\n"));
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/1.1\r\nConnection: close\r\nConnection: keep-alive\r\n\r\n"));
+
+    // Keep alive is requested only by HTTP/1.0 clients
+    ASSERT_FALSE(isKeepAlive("GET / HTTP/0.9\r\nConnection: keep-alive\r\n\r\n"));
+}
+
+/**
+ * @brief Worker, that drives connections
+ * through socket pairs.
+ */
+class HTTPWorkerTest : public ::testing::Test
+{
+protected:
+
+    /**
+     * @brief Connection with blocking peer socket.
+     */
+    struct Peer
+    {
+        ~Peer()
+        {
+            connection.reset();
+            close(socket);
+        }
+
+        /**
+         * @brief Method for sending bytes from peer
+         * and reading them by connection.
+         */
+        void send(std::string_view data)
+        {
+            ASSERT_EQ(::send(socket, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+            ASSERT_TRUE(connection->readAvailable());
+        }
+
+        /**
+         * @brief Method for reading bytes, that
+         * were sent to peer.
+         */
+        std::string sent()
+        {
+            char buffer[256];
+
+            auto size = recv(socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+            return size > 0 ? std::string(buffer, static_cast<std::size_t>(size)) : std::string();
+        }
+
+        std::unique_ptr<HTTPConnection> connection;
+        int socket = -1;
+    };
+
+    HTTPWorkerTest() :
+        start(HTTPTimerWheel::Clock::now()),
+        server(),
+        worker(server)
+    {
+
+    }
+
+    /**
+     * @brief Method for creating connected
+     * socket pair.
+     * @param socket Non blocking socket of server.
+     * @return Peer socket.
+     */
+    static int connect(int& socket)
+    {
+        int sockets[2];
+
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+        fcntl(sockets[0], F_SETFL, fcntl(sockets[0], F_GETFL) | O_NONBLOCK);
+
+        socket = sockets[0];
+
+        return sockets[1];
+    }
+
+    std::unique_ptr<Peer> accept()
+    {
+        auto peer = std::make_unique<Peer>();
+
+        int socket;
+        peer->socket = connect(socket);
+        peer->connection = std::make_unique<HTTPConnection>(socket, sockaddr_in{});
+
+        return peer;
+    }
+
+    /**
+     * @brief Method for receiving request header
+     * and starting it's body.
+     * @return Is request admitted.
+     */
+    bool request(Peer& peer, std::string_view data)
+    {
+        peer.send(data);
+
+        EXPECT_TRUE(peer.connection->isHeaderReceived());
+
+        worker.proceedBody(*peer.connection);
+
+        return peer.connection->isAdmitted();
+    }
+
+    /**
+     * @brief Time before timers of worker are
+     * started. Timers are advanced to middle of
+     * ticks, so they don't depend on exact
+     * start of timers.
+     */
+    HTTPTimerWheel::Clock::time_point start;
+
+    HTTPServer server;
+    TestWorker worker;
+};
+
+TEST_F(HTTPWorkerTest, ConnectionLimit)
+{
+    server.setRetryAfter(std::chrono::seconds(7));
+    worker.setLimits(1, 0);
+
+    int socket;
+    int peer = connect(socket);
+
+    ASSERT_TRUE(worker.admitConnection(socket, sockaddr_in{}, 0));
+    close(socket);
+    close(peer);
+
+    peer = connect(socket);
+
+    // Rejected socket is answered and closed
+    ASSERT_FALSE(worker.admitConnection(socket, sockaddr_in{}, 1));
+
+    char buffer[256];
+    std::string response;
+    ssize_t size;
+
+    while ((size = recv(peer, buffer, sizeof(buffer), 0)) > 0)
+    {
+        response.append(buffer, static_cast<std::size_t>(size));
+    }
+
+    close(peer);
+
+    ASSERT_EQ(size, 0);
+    ASSERT_EQ(response.substr(0, 13), "HTTP/1.1 503 ");
+    ASSERT_NE(response.find("\r\nRetry-After: 7\r\n"), std::string::npos);
+    ASSERT_NE(response.find("\r\nContent-Length: 0\r\n"), std::string::npos);
+    ASSERT_NE(response.find("\r\nConnection: close\r\n"), std::string::npos);
+    ASSERT_EQ(response.substr(response.size() - 4), "\r\n\r\n");
+}
+
+TEST_F(HTTPWorkerTest, InflightLimit)
+{
+    worker.setLimits(0, 1);
+
+    auto first = accept();
+    auto second = accept();
+
+    ASSERT_TRUE(request(*first, "GET /first HTTP/1.1\r\n\r\n"));
+
+    // Body of rejected request is never read
+    ASSERT_FALSE(request(*second, "POST /second HTTP/1.1\r\nContent-Length: 5\r\n\r\nabcde"));
+    ASSERT_EQ(second->connection->state(), HTTPConnection::State::Writing);
+    ASSERT_FALSE(second->connection->isBodyExpected());
+    ASSERT_EQ(second->connection->request().dataSize(), 0);
+    ASSERT_EQ(second->connection->bodyHandler(), nullptr);
+
+    second->connection->writePending();
+
+    ASSERT_TRUE(second->connection->isOutputFinished());
+
+    auto response = second->sent();
+
+    ASSERT_EQ(response.substr(0, 13), "HTTP/1.1 503 ");
+    ASSERT_NE(response.find("\r\nConnection: close\r\n"), std::string::npos);
+}
+
+TEST_F(HTTPWorkerTest, InflightReleased)
+{
+    worker.setLimits(0, 1);
+
+    auto first = accept();
+    auto second = accept();
+
+    ASSERT_TRUE(request(*first, "GET / HTTP/1.1\r\n\r\n"));
+    ASSERT_FALSE(request(*second, "GET / HTTP/1.1\r\n\r\n"));
+
+    // Request is released, when response is sent
+    worker.finishRequest(*first->connection);
+    first->connection->reset();
+
+    ASSERT_FALSE(first->connection->isAdmitted());
+
+    auto third = accept();
+
+    ASSERT_TRUE(request(*third, "GET / HTTP/1.1\r\n\r\n"));
+
+    // Request is released, when connection is closed
+    worker.releaseConnection(*third->connection);
+
+    ASSERT_TRUE(request(*first, "GET / HTTP/1.1\r\n\r\n"));
+
+    // Released connection isn't counted twice
+    worker.finishRequest(*first->connection);
+    worker.releaseConnection(*first->connection);
+    worker.releaseConnection(*third->connection);
+
+    auto fourth = accept();
+    auto fifth = accept();
+
+    ASSERT_TRUE(request(*fourth, "GET / HTTP/1.1\r\n\r\n"));
+    ASSERT_FALSE(request(*fifth, "GET / HTTP/1.1\r\n\r\n"));
+}
+
+TEST_F(HTTPWorkerTest, HeaderTimeout)
+{
+    server.setHeaderTimeout(std::chrono::seconds(1));
+
+    auto peer = accept();
+    peer->connection->timer().data = 1;
+
+    peer->send("GET / HTTP/1.1\r\n");
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_EQ(peer->connection->timeout(), HTTPConnection::Timeout::Header);
+    ASSERT_TRUE(worker.advance(start + std::chrono::milliseconds(650)).empty());
+
+    // Header deadline isn't extended by new data
+    peer->send("Host: localhost\r\n");
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_EQ(worker.advance(start + std::chrono::milliseconds(1050)), std::vector<uint64_t>{1});
+
+    ASSERT_TRUE(worker.proceedTimeout(*peer->connection));
+    ASSERT_EQ(peer->connection->state(), HTTPConnection::State::Writing);
+
+    peer->connection->writePending();
+
+    ASSERT_EQ(peer->sent().substr(0, 13), "HTTP/1.1 408 ");
+}
+
+TEST_F(HTTPWorkerTest, BodyTimeout)
+{
+    server.setBodyTimeout(std::chrono::seconds(1));
+
+    auto peer = accept();
+    peer->connection->timer().data = 1;
+
+    request(*peer, "POST / HTTP/1.1\r\nContent-Length: 10\r\n\r\n");
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_EQ(peer->connection->timeout(), HTTPConnection::Timeout::Body);
+    ASSERT_TRUE(worker.advance(start + std::chrono::milliseconds(650)).empty());
+
+    // Body timeout is rearmed by new data
+    peer->send("abc");
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_TRUE(worker.advance(start + std::chrono::milliseconds(1550)).empty());
+    ASSERT_EQ(worker.advance(start + std::chrono::milliseconds(1650)), std::vector<uint64_t>{1});
+
+    ASSERT_TRUE(worker.proceedTimeout(*peer->connection));
+
+    peer->connection->writePending();
+
+    ASSERT_EQ(peer->sent().substr(0, 13), "HTTP/1.1 408 ");
+}
+
+TEST_F(HTTPWorkerTest, WriteTimeout)
+{
+    server.setWriteTimeout(std::chrono::seconds(1));
+
+    auto peer = accept();
+    peer->connection->timer().data = 1;
+
+    peer->connection->setState(HTTPConnection::State::Writing);
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_EQ(peer->connection->timeout(), HTTPConnection::Timeout::Write);
+    ASSERT_TRUE(worker.advance(start + std::chrono::milliseconds(650)).empty());
+
+    // Write timeout is rearmed by sent data
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_TRUE(worker.advance(start + std::chrono::milliseconds(1550)).empty());
+    ASSERT_EQ(worker.advance(start + std::chrono::milliseconds(1650)), std::vector<uint64_t>{1});
+
+    // Connection is closed without response
+    ASSERT_FALSE(worker.proceedTimeout(*peer->connection));
+    ASSERT_TRUE(peer->sent().empty());
+}
+
+TEST_F(HTTPWorkerTest, KeepAliveTimeout)
+{
+    server.setKeepAliveTimeout(std::chrono::seconds(1));
+
+    auto peer = accept();
+    peer->connection->timer().data = 1;
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_EQ(peer->connection->timeout(), HTTPConnection::Timeout::KeepAlive);
+    ASSERT_EQ(worker.advance(start + std::chrono::milliseconds(1050)), std::vector<uint64_t>{1});
+
+    ASSERT_FALSE(worker.proceedTimeout(*peer->connection));
+    ASSERT_EQ(peer->connection->state(), HTTPConnection::State::Reading);
+    ASSERT_TRUE(peer->sent().empty());
+}
+
+TEST_F(HTTPWorkerTest, HandlingNotLimited)
+{
+    auto peer = accept();
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_TRUE(peer->connection->timer().isArmed());
+
+    peer->connection->setState(HTTPConnection::State::Handling);
+
+    worker.updateTimeout(*peer->connection);
+
+    ASSERT_EQ(peer->connection->timeout(), HTTPConnection::Timeout::None);
+    ASSERT_FALSE(peer->connection->timer().isArmed());
+}
+
+/**
+ * @brief Function for getting integer
+ * socket option.
+ */
+static int socketOption(int socket, int level, int option)
+{
+    int value = -1;
+    socklen_t length = sizeof(value);
+
+    EXPECT_EQ(getsockopt(socket, level, option, &value, &length), 0);
+
+    return value;
+}
+
+/**
+ * @brief Function for connecting to
+ * loopback port.
+ * @return Blocking socket.
+ */
+static int connectTo(uint16_t port)
+{
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    timeval timeout{5, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    EXPECT_EQ(connect(client, (sockaddr*) &address, sizeof(address)), 0);
+
+    return client;
+}
+
+/**
+ * @brief Function for getting bound port.
+ */
+static uint16_t boundPort(int socket)
+{
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+
+    EXPECT_EQ(getsockname(socket, (sockaddr*) &address, &length), 0);
+
+    return ntohs(address.sin_port);
+}
+
+TEST(HTTPWorker, ListenerOptions)
+{
+    HTTPServerOptions options;
+    options.backlog = 77;
+    options.reuseAddress = true;
+    options.reusePort = true;
+    options.noDelay = true;
+
+    auto listener = TestWorker::createListener(INADDR_LOOPBACK, 0, options);
+
+    ASSERT_NE(listener, INVALID_SOCKET);
+    ASSERT_NE(socketOption(listener, SOL_SOCKET, SO_REUSEADDR), 0);
+    ASSERT_NE(socketOption(listener, SOL_SOCKET, SO_REUSEPORT), 0);
+
+    // Maximum accept queue of listening socket
+    // is reported as SACKed segments
+    tcp_info info{};
+    socklen_t length = sizeof(info);
+
+    ASSERT_EQ(getsockopt(listener, IPPROTO_TCP, TCP_INFO, &info, &length), 0);
+    ASSERT_EQ(info.tcpi_sacked, 77);
+
+    // Accepted socket inherits options of listener
+    auto client = connectTo(boundPort(listener));
+    auto accepted = accept(listener, nullptr, nullptr);
+
+    ASSERT_NE(accepted, -1);
+    ASSERT_NE(socketOption(accepted, IPPROTO_TCP, TCP_NODELAY), 0);
+
+    close(accepted);
+    close(client);
+    close(listener);
+
+    options.reuseAddress = false;
+    options.reusePort = false;
+    options.noDelay = false;
+
+    listener = TestWorker::createListener(INADDR_LOOPBACK, 0, options);
+
+    ASSERT_EQ(socketOption(listener, SOL_SOCKET, SO_REUSEADDR), 0);
+    ASSERT_EQ(socketOption(listener, SOL_SOCKET, SO_REUSEPORT), 0);
+
+    client = connectTo(boundPort(listener));
+    accepted = accept(listener, nullptr, nullptr);
+
+    ASSERT_EQ(socketOption(accepted, IPPROTO_TCP, TCP_NODELAY), 0);
+
+    close(accepted);
+    close(client);
+    close(listener);
+}
+
+TEST(HTTPWorker, AcceptBatch)
+{
+    // Free port is found by binding to port 0
+    auto probe = TestWorker::createListener(INADDR_LOOPBACK, 0, HTTPServerOptions());
+    auto port = boundPort(probe);
+
+    close(probe);
+
+    HTTPServerOptions options;
+    options.acceptBatchSize = 64;
+
+    // Worker loop is endless, so server and
+    // worker live until process exits
+    auto* server = new HTTPServer();
+    auto* worker = new HTTPEpollWorker(*server);
+
+    ASSERT_TRUE(worker->initialize(INADDR_LOOPBACK, port, options));
+
+    // Connections are pending, before worker
+    // accepts them in single batch
+    std::vector<int> clients;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        clients.push_back(connectTo(port));
+    }
+
+    std::thread([worker] { worker->exec(); }).detach();
+
+    for (auto client : clients)
+    {
+        std::string request = "GET / HTTP/1.1\r\nConnection: close\r\n\r\n";
+
+        ASSERT_EQ(send(client, request.data(), request.size(), MSG_NOSIGNAL), static_cast<ssize_t>(request.size()));
+    }
+
+    for (auto client : clients)
+    {
+        char buffer[64];
+        ssize_t size;
+
+        while ((size = recv(client, buffer, sizeof(buffer), 0)) < 0 && errno == EINTR);
+
+        ASSERT_GT(size, 12);
+        ASSERT_EQ(std::string(buffer, 12), "HTTP/1.1 200");
+
+        close(client);
+    }
+}
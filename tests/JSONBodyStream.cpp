@@ -0,0 +1,85 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <JSONBodyStream.hpp>
+
+/**
+ * @brief Function for serializing value
+ * with stream by parts of given size.
+ */
+static std::string streamJSON(const nlohmann::json& value, std::size_t partSize, std::size_t* parts = nullptr)
+{
+    JSONBodyStream stream(value);
+
+    std::vector<std::byte> buffer;
+    std::string result;
+
+    bool hasMore = true;
+    std::size_t count = 0;
+
+    while (hasMore)
+    {
+        buffer.clear();
+
+        hasMore = stream.write(buffer, partSize);
+
+        result.append(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        ++count;
+    }
+
+    if (parts)
+    {
+        *parts = count;
+    }
+
+    return result;
+}
+
+TEST(JSONBodyStream, Values)
+{
+    std::vector<nlohmann::json> values = {
+        nullptr,
+        42,
+        -1.5,
+        "text with \"quotes\"\n",
+        nlohmann::json::object(),
+        nlohmann::json::array(),
+        nlohmann::json::parse(R"({"a":1,"b":[1,2,{"c":[]}],"d":{},"e\\u0001":"é","f":[[[]]]})"),
+        nlohmann::json::parse(R"([{"id":1,"tags":["x","y"]},{"id":2,"tags":[]},null,true])")
+    };
+
+    for (auto&& value : values)
+    {
+        for (std::size_t partSize : {1, 3, 16, 4096})
+        {
+            ASSERT_EQ(streamJSON(value, partSize), value.dump());
+        }
+    }
+}
+
+TEST(JSONBodyStream, Parts)
+{
+    nlohmann::json value = nlohmann::json::array();
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        value.push_back({{"id", i}, {"name", "user " + std::to_string(i)}});
+    }
+
+    std::size_t parts = 0;
+
+    ASSERT_EQ(streamJSON(value, 4096, &parts), value.dump());
+
+    // Body is not written with single part
+    ASSERT_GT(parts, value.dump().size() / 8192);
+}
+
+TEST(JSONBodyStream, InvalidUTF8)
+{
+    nlohmann::json value = {{"key", "\xFF"}};
+
+    JSONBodyStream stream(value);
+
+    std::vector<std::byte> buffer;
+
+    ASSERT_THROW(stream.write(buffer, 4096), nlohmann::json::type_error);
+}
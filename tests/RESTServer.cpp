@@ -0,0 +1,219 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <RESTServer.hpp>
+
+TEST(RESTServer, MediaType)
+{
+    using Encoding = RESTServer::Encoding;
+
+    ASSERT_EQ(RESTServer::mediaTypeEncoding("application/json"),                Encoding::JSON);
+    ASSERT_EQ(RESTServer::mediaTypeEncoding("application/json; charset=utf-8"), Encoding::JSON);
+    ASSERT_EQ(RESTServer::mediaTypeEncoding("Application/CBOR"),                Encoding::CBOR);
+    ASSERT_EQ(RESTServer::mediaTypeEncoding("application/msgpack"),             Encoding::MessagePack);
+    ASSERT_EQ(RESTServer::mediaTypeEncoding("application/x-msgpack"),           Encoding::MessagePack);
+    ASSERT_EQ(RESTServer::mediaTypeEncoding("application/vnd.msgpack"),         Encoding::MessagePack);
+    ASSERT_EQ(RESTServer::mediaTypeEncoding("text/plain"),                      std::nullopt);
+    ASSERT_EQ(RESTServer::mediaTypeEncoding(""),                                std::nullopt);
+
+    ASSERT_EQ(RESTServer::encodingMediaType(Encoding::JSON),        "application/json");
+    ASSERT_EQ(RESTServer::encodingMediaType(Encoding::CBOR),        "application/cbor");
+    ASSERT_EQ(RESTServer::encodingMediaType(Encoding::MessagePack), "application/msgpack");
+}
+
+TEST(RESTServer, Accept)
+{
+    using Encoding = RESTServer::Encoding;
+
+    ASSERT_EQ(RESTServer::acceptedEncoding(""),                    Encoding::JSON);
+    ASSERT_EQ(RESTServer::acceptedEncoding("*/*"),                 Encoding::JSON);
+    ASSERT_EQ(RESTServer::acceptedEncoding("application/cbor"),    Encoding::CBOR);
+    ASSERT_EQ(RESTServer::acceptedEncoding("application/msgpack"), Encoding::MessagePack);
+    ASSERT_EQ(RESTServer::acceptedEncoding("text/html"),           Encoding::JSON);
+
+    // Quality and order
+    ASSERT_EQ(RESTServer::acceptedEncoding("application/cbor, application/msgpack"),          Encoding::CBOR);
+    ASSERT_EQ(RESTServer::acceptedEncoding("application/cbor;q=0.5, application/msgpack"),    Encoding::MessagePack);
+    ASSERT_EQ(RESTServer::acceptedEncoding("application/json;q=0.9,application/cbor"),        Encoding::CBOR);
+    ASSERT_EQ(RESTServer::acceptedEncoding("application/cbor;q=0, */*;q=0.1"),                Encoding::JSON);
+    ASSERT_EQ(RESTServer::acceptedEncoding("text/html,application/xhtml+xml,*/*;q=0.8"),      Encoding::JSON);
+    ASSERT_EQ(RESTServer::acceptedEncoding("*/*;q=0.5, application/x-msgpack"),               Encoding::MessagePack);
+}
+
+/**
+ * @brief Server, that exposes request processing.
+ */
+class TestRESTServer : public RESTServer
+{
+public:
+
+    using RESTServer::proceedRequest;
+
+    /**
+     * @brief Method for proceeding request
+     * with binary response.
+     * @param header Request line and header fields.
+     * @param body Request body.
+     * @return Response.
+     */
+    HTTPResponse proceed(std::string header, std::vector<std::uint8_t> body = {})
+    {
+        header += "\r\n";
+
+        HTTPRequest request;
+
+        EXPECT_TRUE(request.parse(reinterpret_cast<std::byte*>(header.data()), header.size()));
+
+        request.setData(reinterpret_cast<std::byte*>(body.data()), body.size());
+
+        return proceedRequest(std::move(request));
+    }
+};
+
+/**
+ * @brief Function for getting data of response.
+ */
+static std::vector<std::uint8_t> responseData(const HTTPResponse& response)
+{
+    auto* data = reinterpret_cast<const std::uint8_t*>(response.data());
+
+    return std::vector<std::uint8_t>(data, data + response.dataSize());
+}
+
+TEST(RESTServer, BinaryResponse)
+{
+    TestRESTServer server;
+
+    nlohmann::json result = {{"name", "value"}, {"list", {1, 2.5, true, nullptr}}};
+
+    server.addProcessor(
+        HTTPRequest::Method::GET,
+        "/api/result",
+        [&result](RESTServer::Arguments, std::byte*, std::size_t) -> nlohmann::json
+        {
+            return result;
+        }
+    );
+
+    auto response = server.proceed("GET /api/result HTTP/1.1\r\nAccept: application/cbor\r\n");
+
+    ASSERT_EQ(response.header().get("Content-Type"), "application/cbor");
+    ASSERT_EQ(response.header().get("Vary"), "Accept");
+    ASSERT_EQ(responseData(response), nlohmann::json::to_cbor(result));
+
+    response = server.proceed("GET /api/result HTTP/1.1\r\nAccept: application/msgpack;q=0.9, application/json;q=0.5\r\n");
+
+    ASSERT_EQ(response.header().get("Content-Type"), "application/msgpack");
+    ASSERT_EQ(response.header().get("Vary"), "Accept");
+    ASSERT_EQ(responseData(response), nlohmann::json::to_msgpack(result));
+}
+
+TEST(RESTServer, DecodedBody)
+{
+    TestRESTServer server;
+
+    server.addProcessor(
+        HTTPRequest::Method::POST,
+        "/api/echo",
+        [](RESTServer::Arguments, const nlohmann::json& body) -> nlohmann::json
+        {
+            return body;
+        }
+    );
+
+    // Byte string is kept binary
+    nlohmann::json body = {{"bytes", nlohmann::json::binary({0x00, 0xff, 0x10})}, {"number", 7}};
+
+    auto response = server.proceed(
+        "POST /api/echo HTTP/1.1\r\nContent-Type: application/cbor\r\nAccept: application/cbor\r\n",
+        nlohmann::json::to_cbor(body)
+    );
+
+    auto echo = nlohmann::json::from_cbor(responseData(response));
+
+    ASSERT_TRUE(echo["bytes"].is_binary());
+    ASSERT_EQ(echo, body);
+
+    response = server.proceed(
+        "POST /api/echo HTTP/1.1\r\nContent-Type: application/msgpack\r\nAccept: application/msgpack\r\n",
+        nlohmann::json::to_msgpack({{"number", 7}})
+    );
+
+    ASSERT_EQ(nlohmann::json::from_msgpack(responseData(response)), nlohmann::json({{"number", 7}}));
+
+    std::string text = R"({"number": 7})";
+
+    response = server.proceed(
+        "POST /api/echo HTTP/1.1\r\nAccept: application/cbor\r\n",
+        std::vector<std::uint8_t>(text.begin(), text.end())
+    );
+
+    ASSERT_EQ(nlohmann::json::from_cbor(responseData(response)), nlohmann::json({{"number", 7}}));
+
+    // Empty body is null
+    response = server.proceed("POST /api/echo HTTP/1.1\r\nAccept: application/cbor\r\n");
+
+    ASSERT_TRUE(nlohmann::json::from_cbor(responseData(response)).is_null());
+}
+
+TEST(RESTServer, RawBodyText)
+{
+    TestRESTServer server;
+
+    server.addProcessor(
+        HTTPRequest::Method::POST,
+        "/api/echo",
+        [](RESTServer::Arguments, std::byte* data, std::size_t size) -> nlohmann::json
+        {
+            return std::string(reinterpret_cast<const char*>(data), size);
+        }
+    );
+
+    auto response = server.proceed(
+        "POST /api/echo HTTP/1.1\r\nContent-Type: application/cbor\r\nAccept: application/cbor\r\n",
+        nlohmann::json::to_cbor({{"number", 7}})
+    );
+
+    ASSERT_EQ(nlohmann::json::from_cbor(responseData(response)), R"({"number":7})");
+}
+
+TEST(RESTServer, UndecodableBody)
+{
+    TestRESTServer server;
+
+    bool called = false;
+
+    auto processor = [&called](RESTServer::Arguments, const nlohmann::json&) -> nlohmann::json
+    {
+        called = true;
+        return nullptr;
+    };
+
+    server.addProcessor(HTTPRequest::Method::POST, "/api/json", processor);
+    server.addProcessor(
+        HTTPRequest::Method::POST,
+        "/api/raw",
+        [&called](RESTServer::Arguments, std::byte*, std::size_t) -> nlohmann::json
+        {
+            called = true;
+            return nullptr;
+        }
+    );
+
+    for (auto header : {
+        "POST /api/json HTTP/1.1\r\nContent-Type: application/cbor\r\nAccept: application/cbor\r\n",
+        "POST /api/json HTTP/1.1\r\nContent-Type: application/msgpack\r\nAccept: application/cbor\r\n",
+        "POST /api/json HTTP/1.1\r\nContent-Type: application/json\r\nAccept: application/cbor\r\n",
+        "POST /api/raw HTTP/1.1\r\nContent-Type: application/cbor\r\nAccept: application/cbor\r\n"
+    })
+    {
+        // Truncated in every encoding
+        auto response = server.proceed(header, {0xa2, 0x61});
+
+        auto error = nlohmann::json::from_cbor(responseData(response));
+
+        ASSERT_EQ(error["error_code"], static_cast<int>(RESTServer::ErrorCode::InvalidArguments)) << header;
+    }
+
+    ASSERT_FALSE(called);
+}
@@ -0,0 +1,81 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <HTTPResponse.hpp>
+#include <ResponseWriter.hpp>
+
+/**
+ * @brief Function for converting buffer to string.
+ */
+static std::string toString(const std::vector<std::byte>& buffer)
+{
+    return std::string(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+TEST(ResponseWriter, StatusLines)
+{
+    ASSERT_EQ(ResponseWriter::statusLine(HTTPResponse::StatusCode::Ok), "HTTP/1.1 200 OK\r\n");
+    ASSERT_EQ(ResponseWriter::statusLine(HTTPResponse::StatusCode::NotFound), "HTTP/1.1 404 NotFound\r\n");
+    ASSERT_EQ(
+        ResponseWriter::statusLine(HTTPResponse::StatusCode::NetworkAuthenticationRequired),
+        "HTTP/1.1 511 NetworkAuthenticationRequired\r\n"
+    );
+
+    ASSERT_EQ(ResponseWriter::statusLine(HTTPResponse::StatusCode::Unknown), "");
+    ASSERT_EQ(ResponseWriter::statusLine(static_cast<HTTPResponse::StatusCode>(299)), "");
+    ASSERT_EQ(ResponseWriter::statusLine(static_cast<HTTPResponse::StatusCode>(1000)), "");
+
+    ASSERT_EQ(HTTPResponse::statusToString(HTTPResponse::StatusCode::ServiceUnavailable), "ServiceUnavailable");
+    ASSERT_EQ(HTTPResponse::statusToString(HTTPResponse::StatusCode::Unknown), "Unknown");
+}
+
+TEST(ResponseWriter, Head)
+{
+    HTTPResponse response;
+
+    response.version() = "HTTP/1.1";
+    response.statusCode() = HTTPResponse::StatusCode::Created;
+    response.header().addHeader({"Content-Type", "application/json"});
+    response.header().addHeader({"Location", "/api/items/1"});
+
+    std::vector<std::byte> buffer;
+
+    ResponseWriter writer(buffer);
+
+    writer.writeHead(response);
+
+    ASSERT_EQ(
+        toString(buffer),
+        "HTTP/1.1 201 Created\r\n"
+        "Content-Type: application/json\r\n"
+        "Location: /api/items/1\r\n"
+        "\r\n"
+    );
+
+    // Head of serializer is same
+    std::vector<std::byte> serialized(response.calculateHeadSize());
+
+    response.serializeHead(serialized.data());
+
+    ASSERT_EQ(serialized, buffer);
+}
+
+TEST(ResponseWriter, OtherVersions)
+{
+    std::vector<std::byte> buffer;
+
+    ResponseWriter writer(buffer);
+
+    writer.writeStatusLine("HTTP/1.0", HTTPResponse::StatusCode::Ok);
+    writer.writeStatusLine("HTTP/1.1", static_cast<HTTPResponse::StatusCode>(299));
+    writer.writeField("Connection", "close");
+    writer.writeEnd();
+
+    ASSERT_EQ(
+        toString(buffer),
+        "HTTP/1.0 200 OK\r\n"
+        "HTTP/1.1 299 Unknown\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+    );
+}
@@ -0,0 +1,104 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Tools/ScanTools.hpp>
+
+/**
+ * @brief Implementations, supported by
+ * current processor.
+ */
+static std::vector<ScanTools::Implementation> supportedImplementations()
+{
+    std::vector<ScanTools::Implementation> result = {ScanTools::Implementation::Scalar};
+
+    auto current = ScanTools::CurrentImplementation();
+
+    if (current >= ScanTools::Implementation::SSE2)
+    {
+        result.push_back(ScanTools::Implementation::SSE2);
+    }
+
+    if (current >= ScanTools::Implementation::AVX2)
+    {
+        result.push_back(ScanTools::Implementation::AVX2);
+    }
+
+    return result;
+}
+
+TEST(ScanTools, LineWithHeader)
+{
+    std::string line = "User-Agent: Mozilla/5.0 (X11; U; Linux i686; ru; rv:1.9b5) Gecko/2008050509\r\nHost: a\r\n";
+
+    auto* begin = reinterpret_cast<const std::byte*>(line.data());
+    auto* end = begin + line.size();
+
+    for (auto implementation : supportedImplementations())
+    {
+        const std::byte* colon;
+
+        auto* lineFeed = ScanTools::FindLineFeed(implementation, begin, end, &colon);
+
+        ASSERT_EQ(lineFeed, begin + line.find('\n'));
+        ASSERT_EQ(colon, begin + line.find(':'));
+    }
+}
+
+TEST(ScanTools, ColonAfterLineFeed)
+{
+    std::string line = "GET / HTTP/1.1\r\nHost: a\r\n";
+
+    auto* begin = reinterpret_cast<const std::byte*>(line.data());
+    auto* end = begin + line.size();
+
+    for (auto implementation : supportedImplementations())
+    {
+        const std::byte* colon;
+
+        auto* lineFeed = ScanTools::FindLineFeed(implementation, begin, end, &colon);
+
+        ASSERT_EQ(lineFeed, begin + line.find('\n'));
+        ASSERT_EQ(colon, nullptr);
+    }
+}
+
+TEST(ScanTools, AllPositions)
+{
+    // Every position in vectors and scalar tail
+    for (std::size_t size = 1; size < 100; ++size)
+    {
+        for (std::size_t lineFeedPosition = 0; lineFeedPosition <= size; ++lineFeedPosition)
+        {
+            for (std::size_t colonPosition = 0; colonPosition <= size; colonPosition += 7)
+            {
+                std::string data(size, 'a');
+
+                if (colonPosition < size)
+                {
+                    data[colonPosition] = ':';
+                }
+
+                if (lineFeedPosition < size)
+                {
+                    data[lineFeedPosition] = '\n';
+                }
+
+                auto expectedLineFeed = data.find('\n');
+                auto expectedColon = data.substr(0, expectedLineFeed).find(':');
+
+                auto* begin = reinterpret_cast<const std::byte*>(data.data());
+                auto* end = begin + data.size();
+
+                for (auto implementation : supportedImplementations())
+                {
+                    const std::byte* colon;
+
+                    auto* lineFeed = ScanTools::FindLineFeed(implementation, begin, end, &colon);
+
+                    ASSERT_EQ(lineFeed, expectedLineFeed == std::string::npos ? nullptr : begin + expectedLineFeed);
+                    ASSERT_EQ(colon, expectedColon == std::string::npos ? nullptr : begin + expectedColon);
+                }
+            }
+        }
+    }
+}
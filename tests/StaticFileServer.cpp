@@ -0,0 +1,184 @@
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <StaticFileServer.hpp>
+
+TEST(StaticFileServer, ContentType)
+{
+    ASSERT_EQ(StaticFileServer::contentType("/index.html"),      "text/html; charset=utf-8");
+    ASSERT_EQ(StaticFileServer::contentType("/css/style.CSS"),   "text/css; charset=utf-8");
+    ASSERT_EQ(StaticFileServer::contentType("/img/logo.png"),    "image/png");
+    ASSERT_EQ(StaticFileServer::contentType("/fonts/a.woff2"),   "font/woff2");
+    ASSERT_EQ(StaticFileServer::contentType("/archive.tar.gz"),  "application/gzip");
+    ASSERT_EQ(StaticFileServer::contentType("/README"),          "application/octet-stream");
+    ASSERT_EQ(StaticFileServer::contentType("/v1.2/README"),     "application/octet-stream");
+    ASSERT_EQ(StaticFileServer::contentType("/file.unknown"),    "application/octet-stream");
+}
+
+/**
+ * @brief Server, that serves files of temporary
+ * directory and exposes request processing.
+ */
+class StaticFileServerTest : public ::testing::Test
+{
+protected:
+
+    class Server : public StaticFileServer
+    {
+    public:
+
+        using StaticFileServer::proceedRequest;
+    };
+
+    void SetUp() override
+    {
+        char pattern[] = "/tmp/StaticFileServerXXXXXX";
+
+        ASSERT_NE(mkdtemp(pattern), nullptr);
+
+        root = pattern;
+
+        std::filesystem::create_directories(root / "www/sub");
+        std::filesystem::create_directories(root / "www/foo");
+        std::filesystem::create_directories(root / "www/empty");
+        std::filesystem::create_directories(root / "deep");
+
+        write("secret.txt", "secret");
+        write("www/index.html", "index");
+        write("www/sub/index.html", "sub");
+        write("www/foo/a.txt", "a");
+        write("deep/a.txt", "deep");
+
+        server.addDirectory("/static", (root / "www").string());
+        server.addDirectory("/static/deep/", (root / "deep").string());
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(root);
+    }
+
+    void write(const std::string& path, std::string_view content)
+    {
+        std::ofstream(root / path) << content;
+    }
+
+    /**
+     * @brief Method for requesting uri.
+     * @return Status code and content of
+     * responded file.
+     */
+    std::pair<HTTPResponse::StatusCode, std::string> get(std::string_view uri, std::string_view method = "GET")
+    {
+        std::string text = std::string(method) + " " + std::string(uri) + " HTTP/1.1\r\n\r\n";
+
+        HTTPRequest request;
+
+        EXPECT_TRUE(request.parse(reinterpret_cast<std::byte*>(text.data()), text.size()));
+
+        response = server.proceedRequest(std::move(request));
+
+        std::string content;
+
+        if (response.fileDescriptor() != -1)
+        {
+            content.resize(response.fileSize());
+
+            EXPECT_EQ(pread(response.fileDescriptor(), content.data(), content.size(), 0),
+                      static_cast<ssize_t>(content.size()));
+        }
+
+        return {response.statusCode(), content};
+    }
+
+    std::filesystem::path root;
+    Server server;
+    HTTPResponse response;
+};
+
+TEST_F(StaticFileServerTest, ServesFile)
+{
+    ASSERT_EQ(get("/static/foo/a.txt"), std::make_pair(HTTPResponse::StatusCode::Ok, std::string("a")));
+    ASSERT_EQ(response.header().get("Content-Type"), "text/plain; charset=utf-8");
+
+    // Percent encoding and query are decoded
+    ASSERT_EQ(get("/static/foo/%61.txt?v=1").second, "a");
+    ASSERT_EQ(get("/static/missing.txt").first, HTTPResponse::StatusCode::NotFound);
+}
+
+TEST_F(StaticFileServerTest, LongestPrefix)
+{
+    ASSERT_EQ(get("/static/deep/a.txt").second, "deep");
+    ASSERT_EQ(get("/static/foo/a.txt").second, "a");
+}
+
+TEST_F(StaticFileServerTest, PrefixBoundary)
+{
+    // Prefix matches whole path segments only
+    ASSERT_EQ(get("/staticfoo/a.txt").first, HTTPResponse::StatusCode::NotFound);
+    ASSERT_EQ(get("/static/deepa.txt").first, HTTPResponse::StatusCode::NotFound);
+    ASSERT_EQ(get("/other").first, HTTPResponse::StatusCode::NotFound);
+}
+
+TEST_F(StaticFileServerTest, DirectoryIndex)
+{
+    ASSERT_EQ(get("/static").second, "index");
+    ASSERT_EQ(get("/static/").second, "index");
+    ASSERT_EQ(get("/static/sub").second, "sub");
+    ASSERT_EQ(response.header().get("Content-Type"), "text/html; charset=utf-8");
+    ASSERT_EQ(get("/static/empty/").first, HTTPResponse::StatusCode::NotFound);
+}
+
+TEST_F(StaticFileServerTest, RejectsTraversal)
+{
+    // Every path resolves to existing file, if
+    // it's not rejected
+    for (auto uri : {
+        "/static/../secret.txt",
+        "/static/%2e%2e/secret.txt",
+        "/static/%2E%2E/secret.txt",
+        "/static/foo/..%2f..%2fsecret.txt",
+        "/static/foo%2f..%2f..%2fsecret.txt",
+        "/static//..//secret.txt",
+        "/static/deep/%2e%2e/www/foo/a.txt"
+    })
+    {
+        ASSERT_EQ(get(uri).first, HTTPResponse::StatusCode::NotFound) << uri;
+    }
+}
+
+TEST_F(StaticFileServerTest, RejectsWrongEncoding)
+{
+    for (auto uri : {
+        "/static/foo/a.txt%00",
+        "/static/foo/a.txt%00.png",
+        "/static/foo/a.txt%4",
+        "/static/foo/a.txt%",
+        "/static/foo/a.t%zzxt"
+    })
+    {
+        ASSERT_EQ(get(uri).first, HTTPResponse::StatusCode::NotFound) << uri;
+    }
+}
+
+TEST_F(StaticFileServerTest, MethodNotAllowed)
+{
+    ASSERT_EQ(get("/static/foo/a.txt", "POST").first, HTTPResponse::StatusCode::MethodNotAllowed);
+    ASSERT_EQ(response.header().get("Allow"), "GET, HEAD");
+
+    ASSERT_EQ(get("/static/foo/a.txt", "HEAD").first, HTTPResponse::StatusCode::Ok);
+}
+
+TEST_F(StaticFileServerTest, Forbidden)
+{
+    if (geteuid() == 0)
+    {
+        GTEST_SKIP() << "Permissions are not checked for root";
+    }
+
+    std::filesystem::permissions(root / "www/foo/a.txt", std::filesystem::perms::none);
+
+    ASSERT_EQ(get("/static/foo/a.txt").first, HTTPResponse::StatusCode::Forbidden);
+}
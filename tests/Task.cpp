@@ -0,0 +1,168 @@
+#include <string>
+#include <optional>
+#include <stdexcept>
+#include <coroutine>
+#include <gtest/gtest.h>
+#include <Task.hpp>
+
+/**
+ * @brief Eagerly started coroutine, that
+ * awaits task and stores it's result.
+ */
+struct Runner
+{
+    struct promise_type
+    {
+        Runner get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept
+        {
+
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief Awaiter, that keeps suspended
+ * coroutine for manual resuming.
+ */
+struct ManualAwaiter
+{
+    std::coroutine_handle<>& handle;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle = awaiting;
+    }
+
+    void await_resume() const noexcept
+    {
+
+    }
+};
+
+template<typename T>
+static Runner run(Task<T> task, std::optional<T>& result)
+{
+    result = co_await task;
+}
+
+static Runner runCatching(Task<void> task, std::string& error)
+{
+    try
+    {
+        co_await task;
+    }
+    catch (const std::exception& exception)
+    {
+        error = exception.what();
+    }
+}
+
+static Task<int> answer()
+{
+    co_return 42;
+}
+
+static Task<std::string> chained()
+{
+    auto value = co_await answer();
+
+    co_return std::to_string(value);
+}
+
+static Task<int> suspended(std::coroutine_handle<>& handle)
+{
+    co_await ManualAwaiter{handle};
+
+    co_return 7;
+}
+
+static Task<int> increment(Task<int> task)
+{
+    co_return co_await task + 1;
+}
+
+static Task<void> throwing()
+{
+    throw std::runtime_error("failed");
+
+    co_return;
+}
+
+TEST(Task, Ready)
+{
+    auto task = Task<std::string>::ready("value");
+
+    ASSERT_TRUE(task.isReady());
+    ASSERT_EQ(task.result(), "value");
+
+    std::optional<std::string> result;
+
+    // Ready task is awaited without suspending
+    run(Task<std::string>::ready("awaited"), result);
+
+    ASSERT_EQ(result, "awaited");
+}
+
+TEST(Task, Lazy)
+{
+    auto task = chained();
+
+    // Coroutine is started only when awaited
+    ASSERT_FALSE(task.isReady());
+
+    std::optional<std::string> result;
+
+    run(std::move(task), result);
+
+    ASSERT_EQ(result, "42");
+}
+
+TEST(Task, Suspended)
+{
+    std::coroutine_handle<> handle;
+    std::optional<int> result;
+
+    run(increment(suspended(handle)), result);
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_TRUE(handle);
+
+    // Awaiting coroutines are resumed by chain
+    handle.resume();
+
+    ASSERT_EQ(result, 8);
+}
+
+TEST(Task, Exception)
+{
+    std::string error;
+
+    runCatching(throwing(), error);
+
+    ASSERT_EQ(error, "failed");
+}
@@ -0,0 +1,104 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <HTTPArena.hpp>
+#include <URIArguments.hpp>
+
+TEST(URIArguments, Query)
+{
+    URIArguments arguments;
+
+    arguments.setQuery("id=42&name=John+Doe&empty=&flag&&ratio=0.5&id=43");
+
+    ASSERT_EQ(arguments.size(), 6);
+
+    ASSERT_EQ(arguments.get<int>("id"), 43);
+    ASSERT_EQ(arguments.get<double>("ratio"), 0.5);
+    ASSERT_EQ(arguments.get<int>("name"), std::nullopt);
+    ASSERT_EQ(arguments.get<int>("missing"), std::nullopt);
+
+    ASSERT_EQ(arguments.find("name"), "John Doe");
+    ASSERT_EQ(arguments.find("empty"), "");
+    ASSERT_EQ(arguments.find("flag"), "");
+    ASSERT_EQ(arguments.find("missing"), std::nullopt);
+
+    ASSERT_TRUE(arguments.contains("flag"));
+    ASSERT_FALSE(arguments.contains("missing"));
+
+    ASSERT_EQ(arguments.value("missing", "default"), "default");
+    ASSERT_EQ(arguments["name"], "John Doe");
+
+    ASSERT_EQ(arguments.argument(0).first, "id");
+    ASSERT_EQ(arguments.argument(1).second, "John Doe");
+}
+
+TEST(URIArguments, Decoding)
+{
+    URIArguments arguments;
+
+    arguments.setQuery("path=%2Fhome%2fuser&bad=%zz%2&na%6De=value&utf=%D0%AF");
+
+    ASSERT_EQ(arguments.find("path"), "/home/user");
+    ASSERT_EQ(arguments.find("bad"), "%zz%2");
+    ASSERT_EQ(arguments.find("name"), "value");
+    ASSERT_EQ(arguments.find("utf"), "\xD0\xAF");
+
+    // Decoded value is kept
+    auto first = arguments.find("path");
+    auto second = arguments.find("path");
+
+    ASSERT_EQ(first->data(), second->data());
+}
+
+TEST(URIArguments, Parameters)
+{
+    URIArguments arguments;
+
+    arguments.setParameter("id", "7");
+    arguments.setQuery("id=42&page=2");
+
+    ASSERT_EQ(arguments.get<int>("id"), 7);
+    ASSERT_EQ(arguments.get<int>("page"), 2);
+
+    // Moved arguments keep values
+    URIArguments moved(std::move(arguments));
+
+    ASSERT_EQ(moved.get<int>("id"), 7);
+    ASSERT_EQ(moved.size(), 3);
+}
+
+TEST(URIArguments, Overflow)
+{
+    URIArguments arguments;
+
+    std::string query;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        query += "a" + std::to_string(i) + "=" + std::to_string(i) + "&";
+    }
+
+    arguments.setQuery(query);
+
+    ASSERT_EQ(arguments.size(), 20);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        ASSERT_EQ(arguments.get<int>("a" + std::to_string(i)), i);
+    }
+}
+
+TEST(URIArguments, LazyDecoding)
+{
+    HTTPArena arena(256);
+
+    URIArguments arguments(&arena);
+
+    arguments.setQuery("a=1&b=x%20y&c=3");
+
+    // Plain values are not copied
+    ASSERT_EQ(arguments.get<int>("c"), 3);
+    ASSERT_EQ(arena.capacity(), 0);
+
+    ASSERT_EQ(arguments.find("b"), "x y");
+    ASSERT_NE(arena.capacity(), 0);
+}